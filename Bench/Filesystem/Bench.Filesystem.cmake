@@ -0,0 +1,8 @@
+find_package(Threads REQUIRED)
+
+add_executable(Bench.Filesystem
+    ${BENCH_DIR}/Filesystem/Bench.Filesystem.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Bench.Filesystem PRIVATE Threads::Threads)
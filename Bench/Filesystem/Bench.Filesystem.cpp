@@ -0,0 +1,939 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Reproducible benchmarks for the Filesystem utilities. Every data file is generated from a fixed seed so
+// two runs with the same arguments read and write identical bytes. Results are emitted as JSON so they can
+// be diffed across versions.
+//
+// Usage:
+//   Bench.Filesystem [--dir <path>] [--min-size 4K] [--max-size 256M] [--iterations 5] [--warmup 1]
+//                    [--seed 24301] [--small-files 2000] [--fan-out 64] [--filter <substr>] [--out <file>]
+//                    [--keep]
+//
+// Sizes accept K/M/G suffixes. The default size ladder stops at 256M; pass `--max-size 4G` for the full
+// 4 KiB - 4 GiB sweep (requires the disk space and memory to hold the largest file).
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include "Filesystem.hpp"
+#include "Str.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <direct.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace {
+    using namespace x;
+    using Clock = std::chrono::steady_clock;
+
+    /// Sizes benchmarked when they fall within [minSize, maxSize]
+    constexpr size_t kSizeLadder[] = {
+      4_KILOBYTES,
+      64_KILOBYTES,
+      1_MEGABYTES,
+      16_MEGABYTES,
+      256_MEGABYTES,
+      4_GIGABYTES,
+    };
+
+    constexpr size_t kChunkSize     = 1_MEGABYTES;
+    constexpr size_t kSmallFileSize = 4_KILOBYTES;
+    constexpr size_t kCacheLine     = 64;
+
+    struct BenchConfig {
+        Path dir;
+        size_t minSize      = 4_KILOBYTES;
+        size_t maxSize      = 256_MEGABYTES;
+        u32 iterations      = 5;
+        u32 warmup          = 1;
+        u64 seed            = 0x5EED;
+        u32 smallFileCount  = 2000;
+        u32 fanOut          = 64;
+        bool keep           = false;
+        str filter;
+        str outFile;
+    };
+
+    struct BenchResult {
+        str group;
+        str name;
+        u64 size      = 0;  // Size of a single file in bytes
+        u64 bytes     = 0;  // Bytes processed per iteration
+        u64 ops       = 0;  // Logical operations (files, lines) per iteration
+        vector<u64> samples;  // Nanoseconds per iteration
+    };
+
+    volatile u64 gSink = 0;
+
+    /// Touches one byte per cache line so every strategy pays for bringing the data in, including mmap which
+    /// would otherwise never fault its pages.
+    u64 Touch(const u8* data, size_t size) {
+        u64 acc = 0;
+        for (size_t i = 0; i < size; i += kCacheLine) {
+            acc += data[i];
+        }
+        return acc + size;
+    }
+
+    bool ParseSize(const str& text, size_t& out) {
+        if (text.empty()) { return false; }
+        char* end        = nullptr;
+        const auto value = std::strtoull(text.c_str(), &end, 10);
+        if (end == text.c_str()) { return false; }
+        switch (*end) {
+            case '\0':
+                out = value;
+                return true;
+            case 'k':
+            case 'K':
+                out = X_KILOBYTES(value);
+                return true;
+            case 'm':
+            case 'M':
+                out = X_MEGABYTES(value);
+                return true;
+            case 'g':
+            case 'G':
+                out = X_GIGABYTES(value);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    str SizeLabel(size_t size) {
+        if (size >= 1_GIGABYTES && size % 1_GIGABYTES == 0) { return X_TOSTR(size / 1_GIGABYTES) + "G"; }
+        if (size >= 1_MEGABYTES && size % 1_MEGABYTES == 0) { return X_TOSTR(size / 1_MEGABYTES) + "M"; }
+        if (size >= 1_KILOBYTES && size % 1_KILOBYTES == 0) { return X_TOSTR(size / 1_KILOBYTES) + "K"; }
+        return X_TOSTR(size);
+    }
+
+    str EscapeJson(const str& text) {
+        str out;
+        out.reserve(text.size());
+        for (const char c : text) {
+            switch (c) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (CAST<u8>(c) < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        out += buffer;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out;
+    }
+
+    bool RemoveFile(const Path& path) {
+        return std::remove(path.CStr()) == 0;
+    }
+
+    bool RemoveDirectory(const Path& path) {
+#ifdef _WIN32
+        return _rmdir(path.CStr()) == 0;
+#else
+        return rmdir(path.CStr()) == 0;
+#endif
+    }
+
+#pragma region Data generation
+    /// Writes `size` pseudo-random bytes derived from `seed` in fixed chunks so multi-gigabyte files never need
+    /// to be held in memory. An existing file of the right size is reused, so `path` must encode the seed.
+    bool GenerateBinaryFile(const Path& path, size_t size, u64 seed) {
+        if (path.Exists() && FileReader::QueryFileSize(path) == size) { return true; }
+
+        StreamWriter writer(path);
+        if (!writer.IsOpen()) { return false; }
+
+        std::mt19937_64 rng(seed ^ size);
+        vector<u8> chunk(kChunkSize);
+        size_t remaining = size;
+        while (remaining > 0) {
+            const size_t count = X_MIN(remaining, kChunkSize);
+            for (size_t i = 0; i < count; i += sizeof(u64)) {
+                const u64 value = rng();
+                std::memcpy(chunk.data() + i, &value, X_MIN(sizeof(u64), count - i));
+            }
+            if (!writer.Write(chunk, count)) { return false; }
+            remaining -= count;
+        }
+
+        return writer.Flush();
+    }
+
+    /// Writes printable lines of 16-120 characters until the file reaches `size` bytes.
+    bool GenerateTextFile(const Path& path, size_t size, u64 seed, u64& lineCount) {
+        StreamWriter writer(path);
+        if (!writer.IsOpen()) { return false; }
+
+        std::mt19937_64 rng(seed ^ (size << 1));
+        std::uniform_int_distribution<u32> lengthDist(16, 120);
+        std::uniform_int_distribution<u32> charDist(' ', '~');
+
+        lineCount = 0;
+        size_t written = 0;
+        str line;
+        while (written < size) {
+            const size_t length = X_MIN(CAST<size_t>(lengthDist(rng)), size - written);
+            line.resize(length > 0 ? length - 1 : 0);
+            for (auto& c : line) {
+                c = CAST<char>(charDist(rng));
+            }
+            if (!writer.WriteLine(line)) { return false; }
+            written += line.size() + 1;
+            ++lineCount;
+        }
+
+        return writer.Flush();
+    }
+    /// Four columns per row: an id, a word, a decimal and a quoted note that may hold delimiters and doubled quotes.
+    /// Quoted fields never span lines, so the line-based baseline sees the same rows as CsvReader.
+    bool GenerateCsvFile(const Path& path, size_t size, u64 seed, u64& rowCount) {
+        StreamWriter writer(path);
+        if (!writer.IsOpen()) { return false; }
+
+        static constexpr const char* kNotes[] = {"plain", "has, comma", "say \"\"hi\"\"", "a, b, \"\"c\"\""};
+        std::mt19937_64 rng(seed ^ (size << 2));
+        std::uniform_int_distribution<u32> wordLength(3, 12);
+        std::uniform_int_distribution<u32> letter('a', 'z');
+
+        rowCount       = 0;
+        size_t written = 0;
+        str row;
+        while (written < size) {
+            row = std::to_string(rowCount) + ',';
+            for (u32 i = wordLength(rng); i > 0; --i) {
+                row += CAST<char>(letter(rng));
+            }
+            row += ',' + std::to_string(CAST<f64>(rng() % 1000000) / 100.0) + ",\"";
+            row += kNotes[rng() % X_ARRAY_SIZE(kNotes)];
+            row += '"';
+            if (!writer.WriteLine(row)) { return false; }
+            written += row.size() + 1;
+            ++rowCount;
+        }
+
+        return writer.Flush();
+    }
+#pragma endregion
+
+#pragma region Raw read strategies
+    /// Reads the whole file with positional reads (pread / ReadFile) into a caller-provided buffer, bypassing
+    /// iostreams entirely.
+    bool ReadPositional(const Path& path, vector<u8>& buffer) {
+#ifdef _WIN32
+        HANDLE file = ::CreateFileA(path.CStr(),
+                                    GENERIC_READ,
+                                    FILE_SHARE_READ,
+                                    nullptr,
+                                    OPEN_EXISTING,
+                                    FILE_FLAG_SEQUENTIAL_SCAN,
+                                    nullptr);
+        if (file == INVALID_HANDLE_VALUE) { return false; }
+
+        LARGE_INTEGER fileSize {};
+        if (!::GetFileSizeEx(file, &fileSize)) {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        buffer.resize(CAST<size_t>(fileSize.QuadPart));
+        size_t offset = 0;
+        while (offset < buffer.size()) {
+            const DWORD toRead = CAST<DWORD>(X_MIN(buffer.size() - offset, CAST<size_t>(1_GIGABYTES)));
+            DWORD bytesRead    = 0;
+            if (!::ReadFile(file, buffer.data() + offset, toRead, &bytesRead, nullptr) || bytesRead == 0) { break; }
+            offset += bytesRead;
+        }
+
+        ::CloseHandle(file);
+        return offset == buffer.size();
+#else
+        const int fd = ::open(path.CStr(), O_RDONLY);
+        if (fd < 0) { return false; }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        buffer.resize(CAST<size_t>(info.st_size));
+        size_t offset = 0;
+        while (offset < buffer.size()) {
+            const ssize_t bytesRead = ::pread(fd, buffer.data() + offset, buffer.size() - offset, (off_t)offset);
+            if (bytesRead <= 0) { break; }
+            offset += CAST<size_t>(bytesRead);
+        }
+
+        ::close(fd);
+        return offset == buffer.size();
+#endif
+    }
+
+    /// Maps the file read-only and touches every cache line.
+    bool ReadMapped(const Path& path, u64& checksum) {
+#ifdef _WIN32
+        HANDLE file =
+          ::CreateFileA(path.CStr(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) { return false; }
+
+        LARGE_INTEGER fileSize {};
+        if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        const auto* view = CAST<const u8*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (view) {
+            checksum = Touch(view, CAST<size_t>(fileSize.QuadPart));
+            ::UnmapViewOfFile(view);
+        }
+
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return view != nullptr;
+#else
+        const int fd = ::open(path.CStr(), O_RDONLY);
+        if (fd < 0) { return false; }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const auto size = CAST<size_t>(info.st_size);
+        void* view      = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) { return false; }
+
+        ::madvise(view, size, MADV_SEQUENTIAL);
+        checksum = Touch(CAST<const u8*>(view), size);
+        ::munmap(view, size);
+        return true;
+#endif
+    }
+#pragma endregion
+
+    class BenchRunner {
+    public:
+        explicit BenchRunner(BenchConfig config) : mConfig(std::move(config)) {}
+
+        /// Runs `fn` for the configured warmup + measured iterations. `fn` returns false to signal failure, in
+        /// which case the benchmark is dropped from the results.
+        void Run(const str& group,
+                 const str& name,
+                 u64 size,
+                 u64 bytes,
+                 u64 ops,
+                 const std::function<bool()>& fn,
+                 u32 iterations = 0) {
+            const str fullName = group + "/" + name + "/" + SizeLabel(size);
+            if (!mConfig.filter.empty() && fullName.find(mConfig.filter) == str::npos) { return; }
+
+            if (iterations == 0) { iterations = mConfig.iterations; }
+
+            for (u32 i = 0; i < mConfig.warmup; ++i) {
+                if (!fn()) {
+                    std::cerr << "[FAILED] " << fullName << '\n';
+                    return;
+                }
+            }
+
+            BenchResult result {group, name, size, bytes, ops, {}};
+            result.samples.reserve(iterations);
+            for (u32 i = 0; i < iterations; ++i) {
+                const auto start = Clock::now();
+                const bool ok    = fn();
+                const auto end   = Clock::now();
+                if (!ok) {
+                    std::cerr << "[FAILED] " << fullName << '\n';
+                    return;
+                }
+                result.samples.push_back(
+                  CAST<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+
+            std::sort(result.samples.begin(), result.samples.end());
+            std::cerr << fullName << ": " << CAST<f64>(Median(result.samples)) / 1e6 << " ms (median)\n";
+            mResults.push_back(std::move(result));
+        }
+
+        X_NODISCARD const BenchConfig& Config() const {
+            return mConfig;
+        }
+
+        X_NODISCARD str ToJson() const {
+            std::ostringstream oss;
+            oss.precision(6);
+            oss << std::fixed;
+
+            oss << "{\n";
+            oss << "  \"suite\": \"Filesystem\",\n";
+            oss << "  \"timestamp\": " << CAST<i64>(std::time(nullptr)) << ",\n";
+            oss << "  \"config\": {\n";
+            oss << "    \"dir\": \"" << EscapeJson(mConfig.dir.Str()) << "\",\n";
+            oss << "    \"min_size\": " << mConfig.minSize << ",\n";
+            oss << "    \"max_size\": " << mConfig.maxSize << ",\n";
+            oss << "    \"iterations\": " << mConfig.iterations << ",\n";
+            oss << "    \"warmup\": " << mConfig.warmup << ",\n";
+            oss << "    \"seed\": " << mConfig.seed << ",\n";
+            oss << "    \"small_files\": " << mConfig.smallFileCount << ",\n";
+            oss << "    \"fan_out\": " << mConfig.fanOut << "\n";
+            oss << "  },\n";
+            oss << "  \"results\": [";
+
+            for (size_t i = 0; i < mResults.size(); ++i) {
+                const auto& r      = mResults[i];
+                const u64 median   = Median(r.samples);
+                const f64 mean     = Mean(r.samples);
+                const f64 seconds  = CAST<f64>(median) / 1e9;
+                const f64 bytesSec = seconds > 0 ? CAST<f64>(r.bytes) / seconds : 0.0;
+                const f64 opsSec   = seconds > 0 ? CAST<f64>(r.ops) / seconds : 0.0;
+
+                oss << (i == 0 ? "\n" : ",\n");
+                oss << "    {";
+                oss << "\"group\": \"" << EscapeJson(r.group) << "\", ";
+                oss << "\"name\": \"" << EscapeJson(r.name) << "\", ";
+                oss << "\"size\": " << r.size << ", ";
+                oss << "\"bytes\": " << r.bytes << ", ";
+                oss << "\"ops\": " << r.ops << ", ";
+                oss << "\"iterations\": " << r.samples.size() << ", ";
+                oss << "\"min_ns\": " << r.samples.front() << ", ";
+                oss << "\"median_ns\": " << median << ", ";
+                oss << "\"mean_ns\": " << mean << ", ";
+                oss << "\"max_ns\": " << r.samples.back() << ", ";
+                oss << "\"stddev_ns\": " << StdDev(r.samples, mean) << ", ";
+                oss << "\"bytes_per_sec\": " << bytesSec << ", ";
+                oss << "\"ops_per_sec\": " << opsSec;
+                oss << "}";
+            }
+
+            oss << "\n  ]\n}\n";
+            return oss.str();
+        }
+
+    private:
+        BenchConfig mConfig;
+        vector<BenchResult> mResults;
+
+        static u64 Median(const vector<u64>& sorted) {
+            const size_t mid = sorted.size() / 2;
+            if (sorted.size() % 2 == 1) { return sorted[mid]; }
+            return (sorted[mid - 1] + sorted[mid]) / 2;
+        }
+
+        static f64 Mean(const vector<u64>& samples) {
+            f64 sum = 0;
+            for (const auto s : samples) {
+                sum += CAST<f64>(s);
+            }
+            return sum / CAST<f64>(samples.size());
+        }
+
+        static f64 StdDev(const vector<u64>& samples, f64 mean) {
+            f64 sum = 0;
+            for (const auto s : samples) {
+                const f64 d = CAST<f64>(s) - mean;
+                sum += d * d;
+            }
+            return std::sqrt(sum / CAST<f64>(samples.size()));
+        }
+    };
+
+#pragma region Benchmarks
+    void BenchSequentialRead(BenchRunner& runner, vector<Path>& scratch) {
+        const auto& config = runner.Config();
+
+        for (const size_t size : kSizeLadder) {
+            if (size < config.minSize || size > config.maxSize) { continue; }
+
+            const Path file = config.dir / ("read_" + SizeLabel(size) + "_" + X_TOSTR(config.seed) + ".bin");
+            if (!GenerateBinaryFile(file, size, config.seed)) {
+                std::cerr << "Failed to generate " << file << '\n';
+                continue;
+            }
+            scratch.push_back(file);
+
+            runner.Run("read", "FileReader::ReadBytes", size, size, 1, [&] {
+                const auto bytes = FileReader::ReadBytes(file);
+                gSink            = gSink + Touch(bytes.data(), bytes.size());
+                return bytes.size() == size;
+            });
+
+            runner.Run("read", "StreamReader::ReadAll", size, size, 1, [&] {
+                StreamReader reader(file);
+                vector<u8> bytes;
+                if (!reader.ReadAll(bytes)) { return false; }
+                gSink = gSink + Touch(bytes.data(), bytes.size());
+                return bytes.size() == size;
+            });
+
+            runner.Run("read", "StreamReader::Read(1M chunks)", size, size, 1, [&] {
+                StreamReader reader(file);
+                vector<u8> chunk;
+                size_t total = 0;
+                while (total < size && reader.Read(chunk, kChunkSize)) {
+                    gSink = gSink + Touch(chunk.data(), chunk.size());
+                    total += chunk.size();
+                }
+                return total == size;
+            });
+
+            vector<u8> buffer;
+            runner.Run("read", "pread", size, size, 1, [&] {
+                if (!ReadPositional(file, buffer)) { return false; }
+                gSink = gSink + Touch(buffer.data(), buffer.size());
+                return true;
+            });
+
+            runner.Run("read", "mmap", size, size, 1, [&] {
+                u64 checksum = 0;
+                if (!ReadMapped(file, checksum)) { return false; }
+                gSink = gSink + checksum;
+                return true;
+            });
+        }
+    }
+
+    void BenchSequentialWrite(BenchRunner& runner, vector<Path>& scratch) {
+        const auto& config = runner.Config();
+
+        for (const size_t size : kSizeLadder) {
+            if (size < config.minSize || size > config.maxSize) { continue; }
+
+            const Path file = config.dir / ("write_" + SizeLabel(size) + ".bin");
+            scratch.push_back(file);
+
+            std::mt19937_64 rng(config.seed ^ size);
+            vector<u8> data(size);
+            for (auto& b : data) {
+                b = CAST<u8>(rng());
+            }
+
+            runner.Run("write", "FileWriter::WriteBytes", size, size, 1, [&] {
+                return FileWriter::WriteBytes(file, data);
+            });
+
+            runner.Run("write", "StreamWriter::Write(1M chunks)", size, size, 1, [&] {
+                StreamWriter writer(file);
+                vector<u8> chunk(X_MIN(size, kChunkSize));
+                for (size_t offset = 0; offset < size; offset += chunk.size()) {
+                    const size_t count = X_MIN(chunk.size(), size - offset);
+                    std::memcpy(chunk.data(), data.data() + offset, count);
+                    if (!writer.Write(chunk, count)) { return false; }
+                }
+                return writer.Flush();
+            });
+        }
+    }
+
+    void BenchReadLines(BenchRunner& runner, vector<Path>& scratch) {
+        const auto& config = runner.Config();
+
+        for (const size_t size : kSizeLadder) {
+            // Materializing every line of a multi-gigabyte file is not a meaningful measurement
+            if (size < config.minSize || size > config.maxSize || size > 256_MEGABYTES) { continue; }
+
+            const Path file = config.dir / ("lines_" + SizeLabel(size) + ".txt");
+            u64 lineCount   = 0;
+            if (!GenerateTextFile(file, size, config.seed, lineCount)) {
+                std::cerr << "Failed to generate " << file << '\n';
+                continue;
+            }
+            scratch.push_back(file);
+
+            runner.Run("lines", "FileReader::ReadLines", size, size, lineCount, [&] {
+                const auto lines = FileReader::ReadLines(file);
+                gSink            = gSink + lines.size();
+                return lines.size() == lineCount;
+            });
+
+            runner.Run("lines", "StreamReader::ReadLine", size, size, lineCount, [&] {
+                StreamReader reader(file);
+                str line;
+                u64 count = 0;
+                while (reader.ReadLine(line)) {
+                    gSink = gSink + line.size();
+                    ++count;
+                }
+                return count == lineCount;
+            });
+        }
+    }
+
+    void BenchCsv(BenchRunner& runner, vector<Path>& scratch) {
+        const auto& config = runner.Config();
+
+        for (const size_t size : kSizeLadder) {
+            if (size < config.minSize || size > config.maxSize || size > 256_MEGABYTES) { continue; }
+
+            const Path file = config.dir / ("csv_" + SizeLabel(size) + ".csv");
+            u64 rowCount    = 0;
+            if (!GenerateCsvFile(file, size, config.seed, rowCount)) {
+                std::cerr << "Failed to generate " << file << '\n';
+                continue;
+            }
+            scratch.push_back(file);
+
+            runner.Run("csv", "StreamReader::ReadLine + Split", size, size, rowCount, [&] {
+                StreamReader reader(file);
+                str line;
+                u64 count = 0;
+                while (reader.ReadLine(line)) {
+                    for (const strview field : Split(line, ',', {.quote = '"'})) {
+                        gSink = gSink + field.size();
+                    }
+                    ++count;
+                }
+                return count == rowCount;
+            });
+
+            runner.Run("csv", "CsvReader(file)", size, size, rowCount, [&] {
+                CsvReader reader(file);
+                CsvRow row;
+                u64 count = 0;
+                while (reader.Next(row)) {
+                    gSink = gSink + row[3].size();
+                    ++count;
+                }
+                return count == rowCount;
+            });
+
+            runner.Run("csv", "CsvReader(MappedFile)", size, size, rowCount, [&] {
+                const MappedFile mapped(file);
+                CsvReader reader(mapped.View());
+                CsvRow row;
+                u64 count = 0;
+                while (reader.Next(row)) {
+                    gSink = gSink + row[3].size();
+                    ++count;
+                }
+                return count == rowCount;
+            });
+
+            runner.Run("csv", "CsvReader::ParseParallel", size, size, rowCount, [&] {
+                const MappedFile mapped(file);
+                std::atomic<u64> fieldBytes {0};
+                const u64 count = CsvReader::ParseParallel(mapped.View(), [&](size_t, const CsvRow& row) {
+                    fieldBytes.fetch_add(row[3].size(), std::memory_order_relaxed);
+                });
+                gSink = gSink + fieldBytes.load();
+                return count == rowCount;
+            });
+        }
+    }
+
+    void BenchAsyncFanOut(BenchRunner& runner, const vector<Path>& files) {
+        const auto& config = runner.Config();
+        const u32 fanOut   = X_MIN(config.fanOut, CAST<u32>(files.size()));
+        const u64 total    = CAST<u64>(fanOut) * kSmallFileSize;
+
+        runner.Run("async", "serial FileReader::ReadBytes", kSmallFileSize, total, fanOut, [&] {
+            for (u32 i = 0; i < fanOut; ++i) {
+                const auto bytes = FileReader::ReadBytes(files[i]);
+                if (bytes.size() != kSmallFileSize) { return false; }
+                gSink = gSink + Touch(bytes.data(), bytes.size());
+            }
+            return true;
+        });
+
+        runner.Run("async", "AsyncFileReader::ReadBytes fan-out", kSmallFileSize, total, fanOut, [&] {
+            vector<Future<vector<u8>>> futures;
+            futures.reserve(fanOut);
+            for (u32 i = 0; i < fanOut; ++i) {
+                futures.push_back(AsyncFileReader::ReadBytes(files[i]));
+            }
+            bool ok = true;
+            for (auto& future : futures) {
+                const auto bytes = future.Get();
+                ok               = ok && bytes.size() == kSmallFileSize;
+                gSink            = gSink + Touch(bytes.data(), bytes.size());
+            }
+            return ok;
+        });
+
+        runner.Run("async", "AsyncFileReader::ReadBytes WhenAll", kSmallFileSize, total, fanOut, [&] {
+            vector<Future<vector<u8>>> futures;
+            futures.reserve(fanOut);
+            for (u32 i = 0; i < fanOut; ++i) {
+                futures.push_back(AsyncFileReader::ReadBytes(files[i]));
+            }
+            bool ok = true;
+            for (const auto& bytes : WhenAll(std::move(futures)).Get()) {
+                ok    = ok && bytes.size() == kSmallFileSize;
+                gSink = gSink + Touch(bytes.data(), bytes.size());
+            }
+            return ok;
+        });
+    }
+
+    void BenchSmallFileStorm(BenchRunner& runner, vector<Path>& scratch, const Path& stormDir) {
+        const auto& config = runner.Config();
+        const u32 count    = config.smallFileCount;
+        const u64 total    = CAST<u64>(count) * kSmallFileSize;
+
+        vector<Path> files;
+        files.reserve(count);
+        for (u32 i = 0; i < count; ++i) {
+            files.push_back(stormDir / ("small_" + X_TOSTR(i) + ".bin"));
+        }
+
+        std::mt19937_64 rng(config.seed);
+        vector<u8> data(kSmallFileSize);
+        for (auto& b : data) {
+            b = CAST<u8>(rng());
+        }
+
+        runner.Run("storm", "FileWriter::WriteBytes", kSmallFileSize, total, count, [&] {
+            for (const auto& file : files) {
+                if (!FileWriter::WriteBytes(file, data)) { return false; }
+            }
+            return true;
+        });
+
+        // The write storm may have been filtered out, so make sure the files exist before reading them
+        for (const auto& file : files) {
+            if (!file.Exists() && !FileWriter::WriteBytes(file, data)) {
+                std::cerr << "Failed to generate " << file << '\n';
+                return;
+            }
+        }
+        scratch.insert(scratch.end(), files.begin(), files.end());
+
+        runner.Run("storm", "Path::Exists", kSmallFileSize, 0, count, [&] {
+            for (const auto& file : files) {
+                if (!file.Exists()) { return false; }
+            }
+            return true;
+        });
+
+        runner.Run("storm", "FileReader::QueryFileSize", kSmallFileSize, 0, count, [&] {
+            u64 sum = 0;
+            for (const auto& file : files) {
+                sum += FileReader::QueryFileSize(file);
+            }
+            return sum == total;
+        });
+
+        runner.Run("storm", "FileReader::ReadBytes", kSmallFileSize, total, count, [&] {
+            for (const auto& file : files) {
+                const auto bytes = FileReader::ReadBytes(file);
+                if (bytes.size() != kSmallFileSize) { return false; }
+                gSink = gSink + Touch(bytes.data(), bytes.size());
+            }
+            return true;
+        });
+
+        vector<u8> buffer;
+        runner.Run("storm", "pread", kSmallFileSize, total, count, [&] {
+            for (const auto& file : files) {
+                if (!ReadPositional(file, buffer)) { return false; }
+                gSink = gSink + Touch(buffer.data(), buffer.size());
+            }
+            return true;
+        });
+
+        BenchAsyncFanOut(runner, files);
+    }
+
+    /// A tree of generated text files searched for a two-character pattern, which random printable text holds a
+    /// few times per 64 KiB
+    void BenchSearch(BenchRunner& runner, vector<Path>& scratch, vector<Path>& scratchDirs, const Path& searchDir) {
+        const auto& config = runner.Config();
+        constexpr size_t kFileSize = 64_KILOBYTES;
+        constexpr u32 kDirCount    = 8;
+        constexpr strview kPattern = "x~";
+        const u32 count            = X_MAX(1u, config.smallFileCount / kDirCount);
+
+        vector<Path> files;
+        for (u32 d = 0; d < kDirCount; ++d) {
+            const Path dir = searchDir / ("dir_" + X_TOSTR(d));
+            if (!dir.CreateAll()) {
+                std::cerr << "Failed to create " << dir << '\n';
+                return;
+            }
+            scratchDirs.push_back(dir);
+            for (u32 i = d; i < count; i += kDirCount) {
+                files.push_back(dir / ("text_" + X_TOSTR(i) + ".txt"));
+            }
+        }
+
+        u64 expected = 0;
+        for (size_t i = 0; i < files.size(); ++i) {
+            u64 lineCount = 0;
+            if (!GenerateTextFile(files[i], kFileSize, config.seed + i, lineCount)) {
+                std::cerr << "Failed to generate " << files[i] << '\n';
+                return;
+            }
+            scratch.push_back(files[i]);
+            const auto bytes = FileReader::ReadBytes(files[i]);
+            expected += FindAllSubstrings(std::span(RCAST<const char*>(bytes.data()), bytes.size()), kPattern).size();
+        }
+        const u64 total = CAST<u64>(files.size()) * kFileSize;
+
+        runner.Run("search", "StreamReader::ReadLine + find", kFileSize, total, files.size(), [&] {
+            u64 matches = 0;
+            str line;
+            for (const auto& file : files) {
+                StreamReader reader(file);
+                while (reader.ReadLine(line)) {
+                    for (size_t at = line.find(kPattern); at != str::npos; at = line.find(kPattern, at + 1)) {
+                        ++matches;
+                    }
+                }
+            }
+            return matches == expected;
+        });
+
+        runner.Run("search", "FileSearcher::Search", kFileSize, total, files.size(), [&] {
+            u64 lines = 0;
+            const auto stats = FileSearcher::Search(searchDir, kPattern, [&](const SearchMatch& match) {
+                lines += match.line;
+                return true;
+            });
+            gSink = gSink + lines;
+            return stats.matches == expected;
+        });
+    }
+
+#pragma endregion
+
+    void PrintUsage() {
+        std::cerr << "Usage: Bench.Filesystem [--dir <path>] [--min-size 4K] [--max-size 256M] [--iterations N]\n"
+                     "                        [--warmup N] [--seed N] [--small-files N] [--fan-out N]\n"
+                     "                        [--filter <substr>] [--out <file>] [--keep]\n";
+    }
+
+    bool ParseArgs(int argc, char* argv[], BenchConfig& config) {
+        for (int i = 1; i < argc; ++i) {
+            const str arg  = argv[i];
+            const bool has = i + 1 < argc;
+            const auto next = [&]() -> str { return has ? str(argv[++i]) : str(); };
+            // At least one; the value is read before X_MAX, which evaluates its arguments twice
+            const auto nextCount = [&] {
+                const auto value = CAST<u32>(std::stoul(next()));
+                return X_MAX(1u, value);
+            };
+
+            if (arg == "--dir" && has) {
+                config.dir = Path(next());
+            } else if (arg == "--min-size" && has) {
+                if (!ParseSize(next(), config.minSize)) { return false; }
+            } else if (arg == "--max-size" && has) {
+                if (!ParseSize(next(), config.maxSize)) { return false; }
+            } else if (arg == "--iterations" && has) {
+                config.iterations = nextCount();
+            } else if (arg == "--warmup" && has) {
+                config.warmup = CAST<u32>(std::stoul(next()));
+            } else if (arg == "--seed" && has) {
+                config.seed = std::stoull(next());
+            } else if (arg == "--small-files" && has) {
+                config.smallFileCount = nextCount();
+            } else if (arg == "--fan-out" && has) {
+                config.fanOut = nextCount();
+            } else if (arg == "--filter" && has) {
+                config.filter = next();
+            } else if (arg == "--out" && has) {
+                config.outFile = next();
+            } else if (arg == "--keep") {
+                config.keep = true;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace x;
+
+    BenchConfig config;
+    config.dir = Path::Current() / "bench_data";
+    if (!ParseArgs(argc, argv, config)) {
+        PrintUsage();
+        return 1;
+    }
+
+    const Path stormDir  = config.dir / "storm";
+    const Path searchDir = config.dir / "search";
+    if (!config.dir.CreateAll() || !stormDir.CreateAll() || !searchDir.CreateAll()) {
+        std::cerr << "Failed to create benchmark directory " << config.dir << '\n';
+        return 1;
+    }
+
+    BenchRunner runner(config);
+    vector<Path> scratch;
+    vector<Path> scratchDirs;
+
+    BenchSequentialRead(runner, scratch);
+    BenchSequentialWrite(runner, scratch);
+    BenchReadLines(runner, scratch);
+    BenchCsv(runner, scratch);
+    BenchSmallFileStorm(runner, scratch, stormDir);
+    BenchSearch(runner, scratch, scratchDirs, searchDir);
+
+    const str json = runner.ToJson();
+    if (config.outFile.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream out(config.outFile, std::ios::out | std::ios::trunc);
+        out << json;
+        if (!out.good()) {
+            std::cerr << "Failed to write results to " << config.outFile << '\n';
+            return 1;
+        }
+    }
+
+    if (!config.keep) {
+        for (const auto& file : scratch) {
+            RemoveFile(file);
+        }
+        for (const auto& dir : scratchDirs) {
+            RemoveDirectory(dir);
+        }
+        RemoveDirectory(stormDir);
+        RemoveDirectory(searchDir);
+        RemoveDirectory(config.dir);
+    }
+
+    return 0;
+}
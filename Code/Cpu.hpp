@@ -0,0 +1,268 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Runtime CPU feature detection. Build flags only say what every target machine is guaranteed to have; Cpu reports
+// what this one actually has, so a single binary can pick wider kernels where the hardware allows. x86 is probed
+// with cpuid and xgetbv (a feature only counts if the OS also saves its registers), ARM64 with HWCAP or the
+// platform's equivalent.
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+
+#if defined(X_ARCH_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(_M_ARM64)
+    #include <Windows.h>
+#elif defined(__aarch64__) && defined(__APPLE__)
+    #include <sys/sysctl.h>
+#elif defined(__aarch64__) && defined(__linux__)
+    #include <sys/auxv.h>
+#endif
+
+namespace x {
+    enum class CpuFeature : u8 {
+        Sse2,
+        Ssse3,
+        Sse41,
+        Sse42,
+        Popcnt,
+        Avx,
+        Avx2,
+        Fma,
+        Bmi1,
+        Bmi2,
+        Avx512F,
+        Avx512Bw,
+        Avx512Vl,
+        Avx512Vbmi,
+        Aes,
+        Sha,    // SHA-NI on x86, the SHA-1/SHA-256 extensions on ARM64
+        Crc32,  // SSE4.2's CRC32C instruction on x86, the CRC32 extension on ARM64
+        Neon,
+        Count,
+    };
+
+    /// @brief Set of CpuFeature values, one bit per feature
+    using CpuFeatureMask = u64;
+
+    constexpr CpuFeatureMask CpuMask(std::initializer_list<CpuFeature> features) {
+        CpuFeatureMask mask = 0;
+        for (const CpuFeature feature : features) {
+            mask |= X_BIT(CAST<u32>(feature));
+        }
+        return mask;
+    }
+
+    class Cpu {
+    public:
+        /// @brief Every feature this CPU and OS support. Detected on first use, then cached.
+        static CpuFeatureMask Features() {
+            static const CpuFeatureMask features = Detect();
+            return features;
+        }
+
+        static bool Has(CpuFeature feature) {
+            return (Features() & X_BIT(CAST<u32>(feature))) != 0;
+        }
+
+        static bool HasAll(CpuFeatureMask required) {
+            return (Features() & required) == required;
+        }
+
+        static const char* FeatureName(CpuFeature feature) {
+            static constexpr const char* kNames[] = {
+              "SSE2",
+              "SSSE3",
+              "SSE4.1",
+              "SSE4.2",
+              "POPCNT",
+              "AVX",
+              "AVX2",
+              "FMA",
+              "BMI1",
+              "BMI2",
+              "AVX-512F",
+              "AVX-512BW",
+              "AVX-512VL",
+              "AVX-512VBMI",
+              "AES",
+              "SHA",
+              "CRC32",
+              "NEON",
+            };
+            static_assert(X_ARRAY_SIZE(kNames) == CAST<size_t>(CpuFeature::Count));
+            return feature < CpuFeature::Count ? kNames[CAST<size_t>(feature)] : "Unknown";
+        }
+
+    private:
+        static void Set(CpuFeatureMask& mask, CpuFeature feature, bool present) {
+            if (present) { mask |= X_BIT(CAST<u32>(feature)); }
+        }
+
+#if defined(X_ARCH_X86)
+        static void CpuId(u32 leaf, u32 subleaf, u32 (&regs)[4]) {
+    #if defined(_MSC_VER)
+            int out[4];
+            __cpuidex(out, CAST<int>(leaf), CAST<int>(subleaf));
+            for (int i = 0; i < 4; ++i) {
+                regs[i] = CAST<u32>(out[i]);
+            }
+    #else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+        }
+
+        // Which register files the OS saves on a context switch
+        static u64 EnabledStateComponents() {
+    #if defined(_MSC_VER)
+            return _xgetbv(0);
+    #else
+            u32 lo, hi;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (CAST<u64>(hi) << 32) | lo;
+    #endif
+        }
+
+        static CpuFeatureMask Detect() {
+            CpuFeatureMask mask = 0;
+            u32 regs[4];
+
+            CpuId(0, 0, regs);
+            const u32 maxLeaf = regs[0];
+
+            CpuId(1, 0, regs);
+            const u32 ecx1 = regs[2];
+            const u32 edx1 = regs[3];
+            Set(mask, CpuFeature::Sse2, edx1 & X_BIT(26));
+            Set(mask, CpuFeature::Ssse3, ecx1 & X_BIT(9));
+            Set(mask, CpuFeature::Sse41, ecx1 & X_BIT(19));
+            Set(mask, CpuFeature::Sse42, ecx1 & X_BIT(20));
+            Set(mask, CpuFeature::Crc32, ecx1 & X_BIT(20));
+            Set(mask, CpuFeature::Popcnt, ecx1 & X_BIT(23));
+            Set(mask, CpuFeature::Aes, ecx1 & X_BIT(25));
+
+            // AVX state (XMM and YMM) must be enabled in XCR0; AVX-512 also needs the opmask and ZMM state
+            const bool osxsave  = (ecx1 & X_BIT(27)) != 0;
+            const u64 xcr0      = osxsave ? EnabledStateComponents() : 0;
+            const bool avxOs    = (xcr0 & 0x6) == 0x6;
+            const bool avx512Os = (xcr0 & 0xE6) == 0xE6;
+            Set(mask, CpuFeature::Avx, avxOs && (ecx1 & X_BIT(28)));
+            Set(mask, CpuFeature::Fma, avxOs && (ecx1 & X_BIT(12)));
+
+            if (maxLeaf >= 7) {
+                CpuId(7, 0, regs);
+                const u32 ebx7 = regs[1];
+                const u32 ecx7 = regs[2];
+                Set(mask, CpuFeature::Bmi1, ebx7 & X_BIT(3));
+                Set(mask, CpuFeature::Avx2, avxOs && (ebx7 & X_BIT(5)));
+                Set(mask, CpuFeature::Bmi2, ebx7 & X_BIT(8));
+                Set(mask, CpuFeature::Sha, ebx7 & X_BIT(29));
+
+                const bool avx512F = avx512Os && (ebx7 & X_BIT(16));
+                Set(mask, CpuFeature::Avx512F, avx512F);
+                Set(mask, CpuFeature::Avx512Bw, avx512F && (ebx7 & X_BIT(30)));
+                Set(mask, CpuFeature::Avx512Vl, avx512F && (ebx7 & X_BIT(31)));
+                Set(mask, CpuFeature::Avx512Vbmi, avx512F && (ecx7 & X_BIT(1)));
+            }
+
+            return mask;
+        }
+#else
+        static CpuFeatureMask Detect() {
+            CpuFeatureMask mask = 0;
+    #if defined(X_SIMD_NEON)
+            Set(mask, CpuFeature::Neon, true);  // Mandatory on ARM64
+    #endif
+    #if defined(_M_ARM64)
+            Set(mask, CpuFeature::Crc32, IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE));
+            const bool crypto = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+            Set(mask, CpuFeature::Aes, crypto);
+            Set(mask, CpuFeature::Sha, crypto);
+    #elif defined(__aarch64__) && defined(__APPLE__)
+            const auto query = [](const char* name) {
+                int value       = 0;
+                size_t size     = sizeof(value);
+                const int error = sysctlbyname(name, &value, &size, nullptr, 0);
+                return error == 0 && value != 0;
+            };
+            Set(mask, CpuFeature::Crc32, query("hw.optional.armv8_crc32"));
+            Set(mask, CpuFeature::Aes, query("hw.optional.arm.FEAT_AES"));
+            Set(mask, CpuFeature::Sha, query("hw.optional.arm.FEAT_SHA256"));
+    #elif defined(__aarch64__) && defined(__linux__)
+            // Bit positions from the arm64 uapi <asm/hwcap.h>
+            const unsigned long hwcap = getauxval(AT_HWCAP);
+            Set(mask, CpuFeature::Aes, hwcap & X_BIT(3));
+            Set(mask, CpuFeature::Sha, (hwcap & X_BIT(5)) && (hwcap & X_BIT(6)));
+            Set(mask, CpuFeature::Crc32, hwcap & X_BIT(7));
+    #endif
+            return mask;
+        }
+#endif
+    };
+
+    /// @brief One implementation a CpuDispatch can pick, and the features it needs
+    template<typename Fn>
+    struct CpuCandidate {
+        CpuFeatureMask required;
+        Fn fn;
+    };
+
+    /// @brief The first candidate whose requirements this CPU meets, so list them best first. Falls back to
+    /// `fallback`, which must run anywhere.
+    template<typename Fn>
+    Fn CpuSelect(std::initializer_list<CpuCandidate<Fn>> candidates, Fn fallback) {
+        for (const auto& candidate : candidates) {
+            if (Cpu::HasAll(candidate.required)) { return candidate.fn; }
+        }
+        return fallback;
+    }
+
+    /// @brief A function pointer (or a pointer to a table of them) bound to the best implementation for this CPU, in
+    /// the spirit of GNU ifunc.
+    ///
+    /// The resolver runs once, on the first call, and every later call is a plain indirect call. Construction is
+    /// constexpr, so a namespace-scope dispatcher is ready before any static initializer that might call it:
+    ///
+    ///     inline CpuDispatch<size_t (*)(const char*, size_t)> kStrLen {+[] {
+    ///         return CpuSelect({{CpuMask({CpuFeature::Avx2}), StrLenAvx2}}, StrLenScalar);
+    ///     }};
+    template<typename Fn>
+    class CpuDispatch {
+    public:
+        using Resolver = Fn (*)();
+
+        constexpr explicit CpuDispatch(Resolver resolver) : mResolver(resolver) {}
+
+        CpuDispatch(const CpuDispatch&)            = delete;
+        CpuDispatch& operator=(const CpuDispatch&) = delete;
+
+        /// @brief The resolved implementation. Racing first calls may each run the resolver, which is harmless
+        /// because they all pick the same function.
+        Fn Get() const {
+            Fn fn = mTarget.load(std::memory_order_acquire);
+            if (!fn) {
+                fn = mResolver();
+                mTarget.store(fn, std::memory_order_release);
+            }
+            return fn;
+        }
+
+        template<typename... Args>
+        decltype(auto) operator()(Args&&... args) const {
+            return Get()(std::forward<Args>(args)...);
+        }
+
+    private:
+        Resolver mResolver;
+        mutable std::atomic<Fn> mTarget {nullptr};
+    };
+}  // namespace x
@@ -6,9 +6,9 @@
 
 #include "Typedefs.hpp"
 #include "Macros.hpp"
+#include "StringBuilder.hpp"
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
 
 namespace x {
     class DateTime {
@@ -49,9 +49,9 @@ namespace x {
             const auto time_t = std::chrono::system_clock::to_time_t(mTime);
             std::tm dateTm {};
             localtime_s(&dateTm, &time_t);
-            std::ostringstream oss;
-            oss << std::put_time(&dateTm, "%Y-%m-%d");
-            return oss.str();
+            StringBuilder builder;
+            AppendDate(builder, dateTm);
+            return builder.Str();
         }
 
         // Should return a string in the following format:
@@ -69,25 +69,37 @@ namespace x {
         }
 
         X_NODISCARD static str FormatDateTimeString(const std::tm& tm) {
-            std::ostringstream oss;
-            oss << std::put_time(&tm, "%Y-%m-%d");
-            oss << " ";
-            oss << FormatTimeString(tm);
-            return oss.str();
+            StringBuilder builder;
+            AppendDate(builder, tm);
+            builder.Append(' ');
+            AppendTime(builder, tm);
+            return builder.Str();
         }
 
         X_NODISCARD static str FormatTimeString(const std::tm& tm) {
-            std::ostringstream oss;
+            StringBuilder builder;
+            AppendTime(builder, tm);
+            return builder.Str();
+        }
+
+        // YYYY-MM-DD
+        static void AppendDate(StringBuilder& builder, const std::tm& tm) {
+            builder.AppendPadded(tm.tm_year + 1900, 4).Append('-');
+            builder.AppendPadded(tm.tm_mon + 1, 2).Append('-');
+            builder.AppendPadded(tm.tm_mday, 2);
+        }
 
+        // HH:MM:SS AM/PM
+        static void AppendTime(StringBuilder& builder, const std::tm& tm) {
             i32 hour        = tm.tm_hour;
             const bool isPM = tm.tm_hour >= 12;
             hour            = hour % 12;
             if (hour == 0) hour = 12;
 
-            oss << std::setfill('0') << std::setw(2) << hour << ":" << std::setw(2) << tm.tm_min << ":" << std::setw(2)
-                << tm.tm_sec << (isPM ? " PM" : " AM");
-
-            return oss.str();
+            builder.AppendPadded(hour, 2).Append(':');
+            builder.AppendPadded(tm.tm_min, 2).Append(':');
+            builder.AppendPadded(tm.tm_sec, 2);
+            builder.Append(isPM ? " PM" : " AM");
         }
 
         Timepoint mTime;
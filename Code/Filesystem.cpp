@@ -3,7 +3,22 @@
 //
 
 #include "Filesystem.hpp"
+#include "IoStats.hpp"
+#include "IoRateLimiter.hpp"
+#include "Trace.hpp"
+#include "NumberFormat.hpp"
+#include "Str.hpp"
+#include "StringBuilder.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <optional>
 #include <sstream>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
 
 #ifdef _WIN32
     // Windows does not define the S_ISREG and S_ISDIR macros in stat.h, so we do.
@@ -12,6 +27,7 @@
     // rather than just defining  _S_IFMT, _S_IFREG, and _S_IFDIR as it normally does.
     #define _CRT_INTERNAL_NONSTDC_NAMES 1
     #include <Windows.h>
+    #include <winioctl.h>
     #include <sys/stat.h>
     #if !defined(S_ISREG) && defined(S_IFMT) && defined(S_IFREG)
         #define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
@@ -20,138 +36,407 @@
         #define S_ISDIR(m) (((m) & S_IFMT) == S_IFDIR)
     #endif
 #else
+    #include <cerrno>
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
     #include <sys/stat.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <linux/fiemap.h>
+        #include <linux/fs.h>
+        #include <sys/ioctl.h>
+        #define X_FS_HAS_SYNCFS
+    #endif
 #endif
 
+// Every I/O entry point is both counted (IoStats.hpp) and traced (Trace.hpp); each half compiles out independently
+#define X_FS_OP(name, op, path)                                                                                        \
+    X_IO_SCOPE(name, op, path);                                                                                        \
+    X_TRACE_SCOPE_CAT(IoOpName(op), "io")
+
 namespace x {
+    namespace {
+        constexpr size_t kCancelChunkSize     = 1_MEGABYTES;
+        constexpr auto kCancelPollInterval    = std::chrono::milliseconds(50);
+        constexpr size_t kLinesPerCancelCheck = 1024;
+
+        /// Pacing and cancellation for one call into the shared read/write implementations. The synchronous API
+        /// passes an empty control and keeps its single-call fast path.
+        struct IoControl {
+            IoRateLimiter* limiter      = nullptr;
+            const AsyncOptions* options = nullptr;
+
+            X_NODISCARD bool ShouldStop() const {
+                return options && options->ShouldStop();
+            }
+
+            /// Whether the transfer must be split so pacing and cancellation can act between chunks
+            X_NODISCARD bool IsChunked() const {
+                return limiter || (options && (options->token.CanBeCancelled() ||
+                                               options->deadline != AsyncOptions::Clock::time_point::max()));
+            }
+
+            X_NODISCARD size_t ChunkSize() const {
+                return limiter ? limiter->ChunkSize() : kCancelChunkSize;
+            }
+
+            /// Waits for the limiter's tokens in short slices so a cancellation is noticed mid-wait. Returns false
+            /// if the operation should stop, handing the tokens back since the I/O they paid for never runs;
+            /// otherwise a cancelled transfer would leave a shared limiter in debt for everyone else.
+            X_NODISCARD bool Acquire(u64 bytes, u64 ops) const {
+                if (!limiter) { return !ShouldStop(); }
+                auto wait = limiter->Reserve(bytes, ops);
+                while (wait > IoRateLimiter::Clock::duration::zero() && !ShouldStop()) {
+                    const auto slice =
+                      X_MIN(wait, std::chrono::duration_cast<IoRateLimiter::Clock::duration>(kCancelPollInterval));
+                    std::this_thread::sleep_for(slice);
+                    wait -= slice;
+                }
+                if (ShouldStop()) {
+                    limiter->Release(bytes, ops);
+                    return false;
+                }
+                return true;
+            }
+
+            // Opening a file is what counts against a limiter's ops/sec; bytes are paced chunk by chunk
+            X_NODISCARD bool AcquireOp() const {
+                return Acquire(0, 1);
+            }
+        };
+
+        /// Reads exactly `size` bytes, one chunk at a time when the call is paced or cancellable.
+        bool ReadChunked(std::istream& stream, char* data, size_t size, const IoControl& control) {
+            if (!control.IsChunked()) { return CAST<bool>(stream.read(data, CAST<std::streamsize>(size))); }
+
+            const size_t chunkSize = control.ChunkSize();
+            for (size_t offset = 0; offset < size; offset += chunkSize) {
+                const size_t count = X_MIN(chunkSize, size - offset);
+                if (!control.Acquire(count, 0)) { return false; }
+                if (!stream.read(data + offset, CAST<std::streamsize>(count))) { return false; }
+            }
+            return true;
+        }
+
+        /// Writes `size` bytes to `stream`. Paced or cancellable calls hand the data out one chunk at a time, so a
+        /// single large write can never exceed the configured burst or outlive its cancellation by long.
+        bool WritePaced(std::ostream& stream, const char* data, size_t size, const IoControl& control) {
+            if (!control.IsChunked()) {
+                stream.write(data, CAST<std::streamsize>(size));
+                return stream.good();
+            }
+
+            const size_t chunkSize = control.ChunkSize();
+            for (size_t offset = 0; offset < size; offset += chunkSize) {
+                const size_t count = X_MIN(chunkSize, size - offset);
+                if (!control.Acquire(count, 0)) { return false; }
+                stream.write(data + offset, CAST<std::streamsize>(count));
+                if (!stream.good()) { return false; }
+            }
+            return stream.good();
+        }
+    }  // namespace
+
 #pragma region FileReader
+    namespace {
+        std::vector<u8> ReadBytesImpl(const Path& path, const IoControl& control) {
+            X_FS_OP(io, IoOp::ReadBytes, path.CStr());
+            if (!control.AcquireOp()) { return {}; }
+            std::ifstream file(path.Str(), std::ios::binary | std::ios::ate);
+            if (!file.is_open()) { return {}; }
+            const std::streamsize fileSize = file.tellg();
+            std::vector<u8> bytes(fileSize);
+            file.seekg(0, std::ios::beg);
+            if (!ReadChunked(file, reinterpret_cast<char*>(bytes.data()), bytes.size(), control)) { return {}; }
+            file.close();
+            X_IO_DONE(io, bytes.size());
+            return bytes;
+        }
+
+        str ReadTextImpl(const Path& path, const IoControl& control) {
+            X_FS_OP(io, IoOp::ReadText, path.CStr());
+            if (!control.AcquireOp()) { return {}; }
+            std::ifstream file(path.Str());
+            if (!file.is_open()) { return {}; }
+
+            str text;
+            if (!control.IsChunked()) {
+                std::stringstream buffer;
+                buffer << file.rdbuf();
+                text = buffer.str();
+            } else {
+                // Text mode may translate line endings, so the size on disk is only an upper bound
+                std::vector<char> chunk(control.ChunkSize());
+                while (file) {
+                    if (!control.Acquire(chunk.size(), 0)) { return {}; }
+                    file.read(chunk.data(), CAST<std::streamsize>(chunk.size()));
+                    text.append(chunk.data(), CAST<size_t>(file.gcount()));
+                }
+                if (file.bad()) { return {}; }
+            }
+
+            X_IO_DONE(io, text.size());
+            return text;
+        }
+
+        std::vector<str> ReadLinesImpl(const Path& path, const IoControl& control) {
+            X_FS_OP(io, IoOp::ReadLines, path.CStr());
+            if (!control.AcquireOp()) { return {}; }
+            std::ifstream file(path.Str());
+            std::vector<str> lines;
+            if (!file.is_open()) { return {}; }
+            const bool chunked = control.IsChunked();
+            str line;
+            X_IO_ONLY(u64 bytes = 0);
+            while (std::getline(file, line)) {
+                X_IO_ONLY(bytes += line.size() + 1);
+                lines.push_back(line);
+                if (chunked && lines.size() % kLinesPerCancelCheck == 0 && control.ShouldStop()) { return {}; }
+            }
+            X_IO_DONE(io, bytes);
+            return lines;
+        }
+
+        std::vector<u8> ReadBlockImpl(const Path& path, size_t size, u64 offset, const IoControl& control) {
+            X_FS_OP(io, IoOp::ReadBlock, path.CStr());
+            if (!control.AcquireOp()) { return {}; }
+            std::ifstream file(path.Str(), std::ios::binary | std::ios::ate);
+            if (!file) { return {}; }
+            const std::streamsize fileSize = file.tellg();
+            if (offset >= (u64)fileSize || size == 0 || offset + size > (u64)fileSize) { return {}; }
+            file.seekg((std::streamsize)offset, std::ios::beg);
+            if (!file) { return {}; }
+            std::vector<u8> buffer(size);
+            if (!ReadChunked(file, reinterpret_cast<char*>(buffer.data()), size, control)) { return {}; }
+            X_IO_DONE(io, size);
+            return buffer;
+        }
+    }  // namespace
+
     std::vector<u8> FileReader::ReadBytes(const Path& path) {
-        std::ifstream file(path.Str(), std::ios::binary | std::ios::ate);
-        if (!file.is_open()) { return {}; }
-        const std::streamsize fileSize = file.tellg();
-        std::vector<u8> bytes(fileSize);
-        file.seekg(0, std::ios::beg);
-        if (!file.read(reinterpret_cast<char*>(bytes.data()), fileSize)) { return {}; }
-        file.close();
-        return bytes;
+        return ReadBytesImpl(path, {});
     }
 
     str FileReader::ReadText(const Path& path) {
-        const std::ifstream file(path.Str());
-        if (!file.is_open()) { return {}; }
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        return ReadTextImpl(path, {});
+    }
+
+    str FileReader::ReadText(const Path& path, size_t& invalidOffset) {
+        str text      = ReadTextImpl(path, {});
+        invalidOffset = FindInvalidUtf8(text);
+        if (invalidOffset != str::npos) { return {}; }
+        return text;
     }
 
     std::vector<str> FileReader::ReadLines(const Path& path) {
-        std::ifstream file(path.Str());
-        std::vector<str> lines;
-        if (!file.is_open()) { return {}; }
-        str line;
-        while (std::getline(file, line)) {
-            lines.push_back(line);
-        }
-        return lines;
+        return ReadLinesImpl(path, {});
     }
 
     std::vector<u8> FileReader::ReadBlock(const Path& path, size_t size, u64 offset) {
-        std::ifstream file(path.Str(), std::ios::binary | std::ios::ate);
-        if (!file) { return {}; }
-        const std::streamsize fileSize = file.tellg();
-        if (offset >= (u64)fileSize || size == 0 || offset + size > (u64)fileSize) { return {}; }
-        file.seekg((std::streamsize)offset, std::ios::beg);
-        if (!file) { return {}; }
-        std::vector<u8> buffer(size);
-        file.read(reinterpret_cast<char*>(buffer.data()), (std::streamsize)size);
-        if (!file) { return {}; }
-        return buffer;
+        return ReadBlockImpl(path, size, offset, {});
     }
 
     size_t FileReader::QueryFileSize(const Path& path) {
+        X_FS_OP(io, IoOp::QueryFileSize, path.CStr());
         std::ifstream file(path.Str(), std::ios::binary | std::ios::ate);
         if (!file.is_open()) { return 0; }
         const std::streamsize fileSize = file.tellg();
+        X_IO_DONE(io, 0);
         return fileSize;
     }
+
+    Generator<strview> FileReader::StreamLines(Path path, size_t bufferSize) {
+        std::ifstream file(path.Str(), std::ios::binary);
+        if (!file.is_open()) { co_return; }
+
+        std::vector<char> buffer(X_MAX(bufferSize, size_t(1)));
+        size_t begin = 0;  // Start of the unconsumed bytes
+        size_t end   = 0;  // One past the last valid byte
+        bool eof     = false;
+
+        const auto trimmed = [](const char* data, size_t size) {
+            if (size > 0 && data[size - 1] == '\r') { --size; }
+            return strview(data, size);
+        };
+
+        for (;;) {
+            const char* start   = buffer.data() + begin;
+            const auto* newline = CAST<const char*>(std::memchr(start, '\n', end - begin));
+            if (newline) {
+                const auto length = CAST<size_t>(newline - start);
+                begin += length + 1;
+                co_yield trimmed(start, length);
+                continue;
+            }
+
+            if (eof) {
+                if (end > begin) { co_yield trimmed(start, end - begin); }
+                co_return;
+            }
+
+            // Keep the partial line, then refill behind it; only a line longer than the buffer grows it
+            if (begin > 0) {
+                std::memmove(buffer.data(), start, end - begin);
+                end -= begin;
+                begin = 0;
+            }
+            if (end == buffer.size()) { buffer.resize(buffer.size() * 2); }
+            file.read(buffer.data() + end, CAST<std::streamsize>(buffer.size() - end));
+            end += CAST<size_t>(file.gcount());
+            if (!file) { eof = true; }
+        }
+    }
 #pragma endregion
 
 #pragma region FileWriter
+    namespace {
+        bool WriteBytesImpl(const Path& path, std::span<const u8> data, const IoControl& control) {
+            X_FS_OP(io, IoOp::WriteBytes, path.CStr());
+            if (!control.AcquireOp()) { return false; }
+            std::ofstream file(path.Str(), std::ios::binary | std::ios::trunc);
+            // Overwrite existing file
+            if (!file) return false;
+            if (!WritePaced(file, RCAST<const char*>(data.data()), data.size(), control)) { return false; }
+            X_IO_DONE(io, data.size());
+            return true;
+        }
+
+        bool WriteTextImpl(const Path& path, const str& text, const IoControl& control) {
+            X_FS_OP(io, IoOp::WriteText, path.CStr());
+            if (!control.AcquireOp()) { return false; }
+            std::ofstream file(path.Str(), std::ios::out | std::ios::trunc);
+            if (!file) return false;
+            if (text.empty()) { return false; }
+            if (!WritePaced(file, text.data(), text.size(), control)) { return false; }
+            // Enforce newline for final text value; written separately rather than appended to a copy of `text`
+            const bool addNewline = text.back() != '\n';
+            if (addNewline && !WritePaced(file, "\n", 1, control)) { return false; }
+            X_IO_DONE(io, text.size() + (addNewline ? 1 : 0));
+            return true;
+        }
+
+        bool WriteLinesImpl(const Path& path, const std::vector<str>& lines, const IoControl& control) {
+            X_FS_OP(io, IoOp::WriteLines, path.CStr());
+            if (!control.AcquireOp()) { return false; }
+            std::ofstream file(path.Str(), std::ios::out | std::ios::trunc);
+            if (!file) return false;
+            const bool chunked = control.IsChunked();
+            X_IO_ONLY(u64 bytes = 0);
+            for (const auto& line : lines) {
+                if (chunked && !control.Acquire(line.size() + 1, 0)) { return false; }
+                file << line << '\n';
+                if (!file.good()) { return false; }
+                X_IO_ONLY(bytes += line.size() + 1);
+            }
+            if (!file.good()) { return false; }
+            X_IO_DONE(io, bytes);
+            return true;
+        }
+
+        bool WriteBlockImpl(const Path& path, std::span<const u8> data, u64 offset, const IoControl& control) {
+            X_FS_OP(io, IoOp::WriteBlock, path.CStr());
+            if (!control.AcquireOp()) { return false; }
+            std::ofstream file(path.Str(),
+                               std::ios::binary | std::ios::in | std::ios::out);  // Open in binary read/write mode
+            if (!file) return false;
+            file.seekp(CAST<std::streampos>((std::streamoff)offset), std::ios::beg);
+            // seek to offset
+            if (!file) return false;  // Failed to seek
+            if (!WritePaced(file, RCAST<const char*>(data.data()), data.size(), control)) { return false; }
+            X_IO_DONE(io, data.size());
+            return true;
+        }
+    }  // namespace
+
     bool FileWriter::WriteBytes(const Path& path, const std::vector<u8>& data) {
-        std::ofstream file(path.Str(), std::ios::binary | std::ios::trunc);
-        // Overwrite existing file
-        if (!file) return false;
-        file.write(RCAST<const char*>(data.data()), CAST<std::streamsize>(data.size()));
-        return file.good();
+        return WriteBytesImpl(path, data, {});
     }
 
     bool FileWriter::WriteText(const Path& path, const str& text) {
-        std::ofstream file(path.Str(), std::ios::out | std::ios::trunc);
-        if (!file) return false;
-        str outText = text;
-        if (outText.empty()) { return false; }
-        // Enforce newline for final text value
-        if (outText.back() != '\n') { outText += '\n'; }
-        file << outText;
-        return file.good();
+        return WriteTextImpl(path, text, {});
     }
 
     bool FileWriter::WriteLines(const Path& path, const std::vector<str>& lines) {
-        std::ofstream file(path.Str(), std::ios::out | std::ios::trunc);
-        if (!file) return false;
-        for (const auto& line : lines) {
-            file << line << '\n';
-            if (!file.good()) { return false; }
-        }
-        return file.good();
+        return WriteLinesImpl(path, lines, {});
     }
 
     bool FileWriter::WriteBlock(const Path& path, const std::span<const u8>& data, u64 offset) {
-        std::ofstream file(path.Str(),
-                           std::ios::binary | std::ios::in | std::ios::out);  // Open in binary read/write mode
-        if (!file) return false;
-        file.seekp(CAST<std::streampos>((std::streamoff)offset), std::ios::beg);
-        // seek to offset
-        if (!file) return false;  // Failed to seek
-        file.write(RCAST<const char*>(data.data()), CAST<std::streamsize>(data.size()));
-        return file.good();
+        return WriteBlockImpl(path, data, offset, {});
     }
 
-    std::future<std::vector<u8>> AsyncFileReader::ReadBytes(const Path& path) {
-        return RunAsync([path]() { return FileReader::ReadBytes(path); });
+    Future<std::vector<u8>> AsyncFileReader::ReadBytes(const Path& path, const AsyncOptions& options) {
+        return RunAsync(options, [path, options]() { return ReadBytesImpl(path, {nullptr, &options}); });
     }
 
-    std::future<str> AsyncFileReader::ReadText(const Path& path) {
-        return RunAsync([path]() { return FileReader::ReadText(path); });
+    Future<str> AsyncFileReader::ReadText(const Path& path, const AsyncOptions& options) {
+        return RunAsync(options, [path, options]() { return ReadTextImpl(path, {nullptr, &options}); });
     }
 
-    std::future<std::vector<str>> AsyncFileReader::ReadLines(const Path& path) {
-        return RunAsync([path]() { return FileReader::ReadLines(path); });
+    Future<std::vector<str>> AsyncFileReader::ReadLines(const Path& path, const AsyncOptions& options) {
+        return RunAsync(options, [path, options]() { return ReadLinesImpl(path, {nullptr, &options}); });
     }
 
-    std::future<std::vector<u8>> AsyncFileReader::ReadBlock(const Path& path, size_t size, u64 offset) {
-        return RunAsync([path, size, offset]() { return FileReader::ReadBlock(path, size, offset); });
+    Future<std::vector<u8>>
+    AsyncFileReader::ReadBlock(const Path& path, size_t size, u64 offset, const AsyncOptions& options) {
+        return RunAsync(options, [path, size, offset, options]() {
+            return ReadBlockImpl(path, size, offset, {nullptr, &options});
+        });
     }
 
-    std::future<bool> AsyncFileWriter::WriteBytes(const Path& path, const std::vector<u8>& data) {
-        return RunAsync([path, data]() { return FileWriter::WriteBytes(path, data); });
+    Future<bool>
+    AsyncFileWriter::WriteBytes(const Path& path, const std::vector<u8>& data, const AsyncOptions& options) {
+        return RunAsync(options, [path, data, options, limiter = RateLimiter()]() {
+            return WriteBytesImpl(path, data, {limiter.get(), &options});
+        });
     }
 
-    std::future<bool> AsyncFileWriter::WriteText(const Path& path, const str& text) {
-        return RunAsync([path, text]() { return FileWriter::WriteText(path, text); });
+    Future<bool> AsyncFileWriter::WriteText(const Path& path, const str& text, const AsyncOptions& options) {
+        return RunAsync(options, [path, text, options, limiter = RateLimiter()]() {
+            return WriteTextImpl(path, text, {limiter.get(), &options});
+        });
     }
 
-    std::future<bool> AsyncFileWriter::WriteLines(const Path& path, const std::vector<str>& lines) {
-        return RunAsync([path, lines]() { return FileWriter::WriteLines(path, lines); });
+    Future<bool>
+    AsyncFileWriter::WriteLines(const Path& path, const std::vector<str>& lines, const AsyncOptions& options) {
+        return RunAsync(options, [path, lines, options, limiter = RateLimiter()]() {
+            return WriteLinesImpl(path, lines, {limiter.get(), &options});
+        });
     }
 
-    std::future<bool> AsyncFileWriter::WriteBlock(const Path& path, const std::span<const u8>& data, u64 offset) {
-        return RunAsync([path, data, offset]() { return FileWriter::WriteBlock(path, data, offset); });
+    Future<bool> AsyncFileWriter::WriteBlock(const Path& path,
+                                             const std::span<const u8>& data,
+                                             u64 offset,
+                                             const AsyncOptions& options) {
+        return RunAsync(options, [path, data, offset, options, limiter = RateLimiter()]() {
+            return WriteBlockImpl(path, data, offset, {limiter.get(), &options});
+        });
+    }
+
+    void AsyncFileWriter::SetRateLimiter(shared_ptr<IoRateLimiter> limiter) {
+        std::lock_guard lock(RateLimiterMutex());
+        RateLimiterSlot() = std::move(limiter);
+    }
+
+    shared_ptr<IoRateLimiter> AsyncFileWriter::RateLimiter() {
+        std::lock_guard lock(RateLimiterMutex());
+        return RateLimiterSlot();
+    }
+
+    std::mutex& AsyncFileWriter::RateLimiterMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    shared_ptr<IoRateLimiter>& AsyncFileWriter::RateLimiterSlot() {
+        static shared_ptr<IoRateLimiter> limiter;
+        return limiter;
     }
 #pragma endregion
 
 #pragma region Stream IO
     StreamReader::StreamReader(const Path& path) : mStream(path.Str(), std::ios::binary | std::ios::ate) {
+        X_IO_ONLY(mStatsPrefixId = IoStats::MatchPrefix(path.CStr()));
         if (mStream.is_open()) {
             mSize = CAST<u64>(mStream.tellg());
             mStream.seekg(0, std::ios::beg);
@@ -164,27 +449,35 @@ namespace x {
         Close();
     }
 
-    StreamReader::StreamReader(StreamReader&& other) noexcept : mStream(std::move(other.mStream)), mSize(other.mSize) {
+    StreamReader::StreamReader(StreamReader&& other) noexcept
+        : mStream(std::move(other.mStream)), mSize(other.mSize), mStatsPrefixId(other.mStatsPrefixId),
+          mValidateUtf8(other.mValidateUtf8), mInvalidUtf8Position(other.mInvalidUtf8Position) {
         other.mSize = 0;
     }
 
     StreamReader& StreamReader::operator=(StreamReader&& other) noexcept {
         if (this != &other) {
             Close();
-            mStream     = std::move(other.mStream);
-            mSize       = other.mSize;
-            other.mSize = 0;
+            mStream              = std::move(other.mStream);
+            mSize                = other.mSize;
+            mStatsPrefixId       = other.mStatsPrefixId;
+            mValidateUtf8        = other.mValidateUtf8;
+            mInvalidUtf8Position = other.mInvalidUtf8Position;
+            other.mSize          = 0;
         }
         return *this;
     }
 
     bool StreamReader::Read(std::vector<u8>& data, size_t size) {
         if (!IsOpen() || size == 0) return false;
+        X_FS_OP(io, IoOp::StreamRead, mStatsPrefixId);
         const auto currentPos = Position();
         if (currentPos + size > mSize) { size = CAST<size_t>(mSize - currentPos); }
         data.resize(size);
         mStream.read(RCAST<char*>(data.data()), (std::streamsize)size);
-        return mStream.good();
+        if (!mStream.good()) { return false; }
+        X_IO_DONE(io, size);
+        return true;
     }
 
     bool StreamReader::ReadAll(std::vector<u8>& data) {
@@ -196,15 +489,65 @@ namespace x {
             return true;
         }
 
+        X_FS_OP(io, IoOp::StreamRead, mStatsPrefixId);
         Seek(0);
         data.resize(CAST<size_t>(size));
         mStream.read(RCAST<char*>(data.data()), (std::streamsize)size);
-        return mStream.good();
+        if (!mStream.good()) { return false; }
+        X_IO_DONE(io, size);
+        return true;
     }
 
     bool StreamReader::ReadLine(str& line) {
         if (!IsOpen()) return false;
-        return CAST<bool>(std::getline(mStream, line));
+        X_FS_OP(io, IoOp::StreamReadLine, mStatsPrefixId);
+        const u64 start = mValidateUtf8 ? Position() : 0;
+        if (!std::getline(mStream, line)) { return false; }
+        X_IO_DONE(io, line.size() + 1);
+        return CheckUtf8(line, start);
+    }
+
+    bool StreamReader::ReadUntil(strview delimiter, str& record) {
+        if (!IsOpen() || delimiter.empty()) return false;
+        X_FS_OP(io, IoOp::StreamReadUntil, mStatsPrefixId);
+        record.clear();
+        const u64 start = mValidateUtf8 ? Position() : 0;
+
+        // getline stops on the delimiter's last byte; the record only ends if the bytes before it match too
+        const char last = delimiter.back();
+        str chunk;
+        bool extracted = false;
+        while (std::getline(mStream, chunk, last)) {
+            extracted = true;
+            record += chunk;
+            if (mStream.eof()) { break; }
+            record += last;
+            if (record.ends_with(delimiter)) {
+                record.resize(record.size() - delimiter.size());
+                X_IO_DONE(io, record.size() + delimiter.size());
+                return CheckUtf8(record, start);
+            }
+        }
+        if (!extracted) { return false; }
+        X_IO_DONE(io, record.size());
+        return CheckUtf8(record, start);
+    }
+
+    void StreamReader::SetUtf8Validation(bool enabled) {
+        mValidateUtf8        = enabled;
+        mInvalidUtf8Position = ~0ULL;
+    }
+
+    u64 StreamReader::InvalidUtf8Position() const {
+        return mInvalidUtf8Position;
+    }
+
+    bool StreamReader::CheckUtf8(strview text, u64 start) {
+        if (!mValidateUtf8) { return true; }
+        const size_t offset = FindInvalidUtf8(text);
+        if (offset == str::npos) { return true; }
+        if (mInvalidUtf8Position == ~0ULL) { mInvalidUtf8Position = start + offset; }
+        return false;
     }
 
     bool StreamReader::IsOpen() const {
@@ -230,19 +573,191 @@ namespace x {
         if (mStream.is_open()) { mStream.close(); }
     }
 
+    namespace {
+        constexpr size_t kMaxVarintSize = 10;
+
+        size_t PrefixWidth(LengthPrefix prefix) {
+            switch (prefix) {
+                case LengthPrefix::U8:
+                    return 1;
+                case LengthPrefix::U16LE:
+                case LengthPrefix::U16BE:
+                    return 2;
+                case LengthPrefix::U32LE:
+                case LengthPrefix::U32BE:
+                    return 4;
+                case LengthPrefix::U64LE:
+                case LengthPrefix::U64BE:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        u64 LoadUnsigned(const u8* data, size_t width, bool bigEndian) {
+            u64 value = 0;
+            for (size_t i = 0; i < width; ++i) {
+                const size_t shift = 8 * (bigEndian ? width - 1 - i : i);
+                value |= CAST<u64>(data[i]) << shift;
+            }
+            return value;
+        }
+    }  // namespace
+
+    RecordReader::RecordReader(const Path& path, size_t bufferSize)
+        : mStream(path.Str(), std::ios::binary), mBuffer(X_MAX(bufferSize, kMaxVarintSize)) {
+        X_IO_ONLY(mStatsPrefixId = IoStats::MatchPrefix(path.CStr()));
+    }
+
+    bool RecordReader::ReadUntil(strview delimiter, strview& record) {
+        if (mError || delimiter.empty()) { return false; }
+        mScanned = X_MAX(mScanned, mBegin);
+        for (;;) {
+            const strview window(mBuffer.data() + mBegin, Available());
+            const size_t hit = window.find(delimiter, mScanned - mBegin);
+            if (hit != strview::npos) {
+                record = window.substr(0, hit);
+                mBegin += hit + delimiter.size();
+                mScanned = mBegin;
+                return true;
+            }
+            if (window.size() > mMaxRecordSize) { return Fail(); }
+
+            // A delimiter may straddle the refill boundary, so only rule out starts that can no longer match
+            mScanned = mBegin + (window.size() >= delimiter.size() ? window.size() - delimiter.size() + 1 : 0);
+            if (!Fill(Available() + 1)) {
+                if (mError || Available() == 0) { return false; }
+                record = strview(mBuffer.data() + mBegin, Available());
+                mBegin = mScanned = mEnd;
+                return true;
+            }
+        }
+    }
+
+    bool RecordReader::ReadLine(strview& line) {
+        if (!ReadUntil("\n", line)) { return false; }
+        if (line.ends_with('\r')) { line.remove_suffix(1); }
+        return true;
+    }
+
+    bool RecordReader::ReadLengthPrefixed(LengthPrefix prefix, std::span<const u8>& record) {
+        if (mError) { return false; }
+
+        u64 length    = 0;
+        size_t header = 0;
+        if (prefix == LengthPrefix::Varint) {
+            Ensure(kMaxVarintSize);  // Fewer bytes are fine near the end of the file
+            if (Available() == 0) { return false; }
+            const auto* bytes  = RCAST<const u8*>(mBuffer.data() + mBegin);
+            const size_t limit = X_MIN(Available(), kMaxVarintSize);
+            bool terminated    = false;
+            while (header < limit) {
+                const u8 byte = bytes[header];
+                // The 10th byte lands at bit 63, so only its lowest bit fits in a u64
+                if (header == kMaxVarintSize - 1 && (byte & 0x7E)) { return Fail(); }
+                length |= CAST<u64>(byte & 0x7F) << (7 * header);
+                ++header;
+                if (!(byte & 0x80)) {
+                    terminated = true;
+                    break;
+                }
+            }
+            if (!terminated) { return Fail(); }
+        } else {
+            header = PrefixWidth(prefix);
+            if (!Ensure(header)) { return Available() == 0 ? false : Fail(); }
+            const bool bigEndian = prefix == LengthPrefix::U16BE || prefix == LengthPrefix::U32BE ||
+                                   prefix == LengthPrefix::U64BE;
+            length = LoadUnsigned(RCAST<const u8*>(mBuffer.data() + mBegin), header, bigEndian);
+        }
+
+        if (length > mMaxRecordSize) { return Fail(); }
+        if (!Ensure(header + CAST<size_t>(length))) { return Fail(); }
+        record = {RCAST<const u8*>(mBuffer.data() + mBegin + header), CAST<size_t>(length)};
+        mBegin += header + CAST<size_t>(length);
+        mScanned = mBegin;
+        return true;
+    }
+
+    bool RecordReader::ReadExact(size_t size, std::span<const u8>& record) {
+        if (mError) { return false; }
+        if (size > mMaxRecordSize) { return Fail(); }
+        if (!Ensure(size)) { return Available() == 0 ? false : Fail(); }
+        record = {RCAST<const u8*>(mBuffer.data() + mBegin), size};
+        mBegin += size;
+        mScanned = mBegin;
+        return true;
+    }
+
+    void RecordReader::SetMaxRecordSize(size_t size) {
+        mMaxRecordSize = size;
+    }
+
+    bool RecordReader::IsOpen() const {
+        return mStream.is_open();
+    }
+
+    bool RecordReader::HasError() const {
+        return mError;
+    }
+
+    u64 RecordReader::Position() const {
+        return mBufferOffset + mBegin;
+    }
+
+    bool RecordReader::Ensure(size_t size) {
+        while (Available() < size) {
+            if (!Fill(size)) { return false; }
+        }
+        return true;
+    }
+
+    bool RecordReader::Fill(size_t minimumSize) {
+        if (mEof || mError) { return false; }
+        X_FS_OP(io, IoOp::RecordRead, mStatsPrefixId);
+
+        if (mBegin > 0) {
+            std::memmove(mBuffer.data(), mBuffer.data() + mBegin, Available());
+            mBufferOffset += mBegin;
+            mScanned -= mBegin;
+            mEnd -= mBegin;
+            mBegin = 0;
+        }
+        const size_t wanted = X_MAX(minimumSize, mEnd + 1);
+        if (wanted > mBuffer.size()) { mBuffer.resize(X_MAX(wanted, mBuffer.size() * 2)); }
+
+        mStream.read(mBuffer.data() + mEnd, CAST<std::streamsize>(mBuffer.size() - mEnd));
+        const auto count = CAST<size_t>(mStream.gcount());
+        mEnd += count;
+        if (!mStream) { mEof = true; }
+        X_IO_DONE(io, count);
+        return count > 0;
+    }
+
+    bool RecordReader::Fail() {
+        mError = true;
+        return false;
+    }
+
     StreamWriter::StreamWriter(const Path& path, bool append)
-        : mStream(path.Str(), std::ios::binary | (append ? std::ios::app : std::ios::trunc)) {}
+        : mStream(path.Str(), std::ios::binary | (append ? std::ios::app : std::ios::trunc)) {
+        X_IO_ONLY(mStatsPrefixId = IoStats::MatchPrefix(path.CStr()));
+    }
 
     StreamWriter::~StreamWriter() {
         Close();
     }
 
-    StreamWriter::StreamWriter(StreamWriter&& other) noexcept : mStream(std::move(other.mStream)) {}
+    StreamWriter::StreamWriter(StreamWriter&& other) noexcept
+        : mStream(std::move(other.mStream)), mLimiter(std::move(other.mLimiter)), mStatsPrefixId(other.mStatsPrefixId) {
+    }
 
     StreamWriter& StreamWriter::operator=(StreamWriter&& other) noexcept {
         if (this != &other) {
             Close();
-            mStream = std::move(other.mStream);
+            mStream        = std::move(other.mStream);
+            mLimiter       = std::move(other.mLimiter);
+            mStatsPrefixId = other.mStatsPrefixId;
         }
         return *this;
     }
@@ -254,20 +769,36 @@ namespace x {
     bool StreamWriter::Write(const std::vector<u8>& buffer, size_t size) {
         if (!IsOpen() || size == 0) return false;
         if (size > buffer.size()) size = buffer.size();
-        mStream.write(RCAST<cstr>(buffer.data()), (std::streamsize)size);
-        return mStream.good();
+        X_FS_OP(io, IoOp::StreamWrite, mStatsPrefixId);
+        const IoControl control {mLimiter.get()};
+        if (!control.AcquireOp()) { return false; }
+        if (!WritePaced(mStream, RCAST<cstr>(buffer.data()), size, control)) { return false; }
+        X_IO_DONE(io, size);
+        return true;
     }
 
     bool StreamWriter::WriteLine(const str& line) {
         if (!IsOpen()) return false;
-        mStream << line << '\n';
-        return mStream.good();
+        X_FS_OP(io, IoOp::StreamWriteLine, mStatsPrefixId);
+        const IoControl control {mLimiter.get()};
+        if (!control.AcquireOp()) { return false; }
+        if (!WritePaced(mStream, line.data(), line.size(), control)) { return false; }
+        if (!WritePaced(mStream, "\n", 1, control)) { return false; }
+        X_IO_DONE(io, line.size() + 1);
+        return true;
     }
 
     bool StreamWriter::Flush() {
         if (!IsOpen()) return false;
+        X_FS_OP(io, IoOp::StreamFlush, mStatsPrefixId);
         mStream.flush();
-        return mStream.good();
+        if (!mStream.good()) { return false; }
+        X_IO_DONE(io, 0);
+        return true;
+    }
+
+    void StreamWriter::SetRateLimiter(shared_ptr<IoRateLimiter> limiter) {
+        mLimiter = std::move(limiter);
     }
 
     bool StreamWriter::IsOpen() const {
@@ -293,18 +824,1229 @@ namespace x {
     }
 #pragma endregion
 
+#pragma region Bulk IO
+    namespace {
+#ifdef _WIN32
+        using NativeFile              = HANDLE;
+        const NativeFile kInvalidFile = INVALID_HANDLE_VALUE;
+        constexpr u64 kMaxIoPerCall   = 64_MEGABYTES;  // ReadFile/WriteFile take a DWORD count
+
+        NativeFile OpenForRead(const Path& path) {
+            return ::CreateFileA(path.CStr(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN,
+                                 nullptr);
+        }
+
+        void CloseFile(NativeFile file) {
+            ::CloseHandle(file);
+        }
+
+        /// Positional read; returns the bytes read, or -1 on error
+        i64 ReadAt(NativeFile file, u8* data, u64 size, u64 offset) {
+            OVERLAPPED overlapped {};
+            overlapped.Offset     = CAST<DWORD>(offset);
+            overlapped.OffsetHigh = CAST<DWORD>(offset >> 32);
+            DWORD read            = 0;
+            if (!::ReadFile(file, data, CAST<DWORD>(size), &read, &overlapped)) {
+                return ::GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+            }
+            return read;
+        }
+
+        NativeFile OpenForWrite(const Path& path) {
+            return ::CreateFileA(path.CStr(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        }
+
+        /// Sequential write; returns the bytes written, or -1 on error
+        i64 WriteSome(NativeFile file, const u8* data, u64 size) {
+            DWORD written = 0;
+            if (!::WriteFile(file, data, CAST<DWORD>(size), &written, nullptr)) { return -1; }
+            return written;
+        }
+
+        bool FlushFile(NativeFile file) {
+            return ::FlushFileBuffers(file) != 0;
+        }
+#else
+        using NativeFile                  = int;
+        constexpr NativeFile kInvalidFile = -1;
+        constexpr u64 kMaxIoPerCall       = 1_GIGABYTES;
+
+        NativeFile OpenForRead(const Path& path) {
+            return ::open(path.CStr(), O_RDONLY | O_CLOEXEC);
+        }
+
+        void CloseFile(NativeFile file) {
+            ::close(file);
+        }
+
+        i64 ReadAt(NativeFile file, u8* data, u64 size, u64 offset) {
+            for (;;) {
+                const ssize_t read = ::pread(file, data, size, CAST<off_t>(offset));
+                if (read >= 0 || errno != EINTR) { return read; }
+            }
+        }
+
+        NativeFile OpenForWrite(const Path& path) {
+            return ::open(path.CStr(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        }
+
+        i64 WriteSome(NativeFile file, const u8* data, u64 size) {
+            for (;;) {
+                const ssize_t written = ::write(file, data, size);
+                if (written >= 0 || errno != EINTR) { return written; }
+            }
+        }
+
+        bool FlushFile(NativeFile file) {
+            return ::fsync(file) == 0;
+        }
+#endif
+
+        constexpr u64 kNoPhysicalOffset = ~u64(0);
+
+        struct BulkFileInfo {
+            u64 size     = 0;
+            u64 inode    = 0;
+            u64 physical = kNoPhysicalOffset;
+            bool found   = false;
+        };
+
+        /// Physical byte offset of the file's first extent, or kNoPhysicalOffset if the filesystem won't say
+        u64 QueryPhysicalOffset(NativeFile file) {
+#ifdef _WIN32
+            STARTING_VCN_INPUT_BUFFER input {};
+            RETRIEVAL_POINTERS_BUFFER output {};
+            DWORD returned = 0;
+            // ERROR_MORE_DATA just means there are more extents than the one we asked for
+            if (!::DeviceIoControl(file,
+                                   FSCTL_GET_RETRIEVAL_POINTERS,
+                                   &input,
+                                   sizeof(input),
+                                   &output,
+                                   sizeof(output),
+                                   &returned,
+                                   nullptr) &&
+                ::GetLastError() != ERROR_MORE_DATA) {
+                return kNoPhysicalOffset;
+            }
+            if (output.ExtentCount == 0) { return kNoPhysicalOffset; }
+            // Logical cluster number; only the ordering matters, so no need to scale by the cluster size
+            return CAST<u64>(output.Extents[0].Lcn.QuadPart);
+#elif defined(__linux__)
+            // fiemap ends in a flexible array, room for exactly one extent follows it
+            alignas(fiemap) u8 buffer[sizeof(fiemap) + sizeof(fiemap_extent)] {};
+            auto* map            = RCAST<fiemap*>(buffer);
+            map->fm_start        = 0;
+            map->fm_length       = FIEMAP_MAX_OFFSET;
+            map->fm_extent_count = 1;
+            if (::ioctl(file, FS_IOC_FIEMAP, map) != 0 || map->fm_mapped_extents == 0) { return kNoPhysicalOffset; }
+            return map->fm_extents[0].fe_physical;
+#else
+            (void)file;
+            return kNoPhysicalOffset;
+#endif
+        }
+
+        BulkFileInfo QueryBulkFileInfo(const Path& path, BulkLoadOrder order) {
+            BulkFileInfo info;
+#ifdef _WIN32
+            if (order == BulkLoadOrder::Input) {
+                struct stat st {};
+                if (stat(path.CStr(), &st) != 0 || !S_ISREG(st.st_mode)) { return info; }
+                info.size  = CAST<u64>(st.st_size);
+                info.found = true;
+                return info;
+            }
+
+            // stat() reports no inode on Windows, the file index needs an open handle
+            const NativeFile file = OpenForRead(path);
+            if (file == kInvalidFile) { return info; }
+            BY_HANDLE_FILE_INFORMATION handleInfo {};
+            if (::GetFileInformationByHandle(file, &handleInfo) &&
+                !(handleInfo.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                info.size  = (CAST<u64>(handleInfo.nFileSizeHigh) << 32) | handleInfo.nFileSizeLow;
+                info.inode = (CAST<u64>(handleInfo.nFileIndexHigh) << 32) | handleInfo.nFileIndexLow;
+                info.found = true;
+                if (order == BulkLoadOrder::PhysicalOffset) { info.physical = QueryPhysicalOffset(file); }
+            }
+            CloseFile(file);
+#else
+            if (order != BulkLoadOrder::PhysicalOffset) {
+                struct stat st {};
+                if (stat(path.CStr(), &st) != 0 || !S_ISREG(st.st_mode)) { return info; }
+                info.size  = CAST<u64>(st.st_size);
+                info.inode = CAST<u64>(st.st_ino);
+                info.found = true;
+                return info;
+            }
+
+            const NativeFile file = OpenForRead(path);
+            if (file == kInvalidFile) { return info; }
+            struct stat st {};
+            if (fstat(file, &st) == 0 && S_ISREG(st.st_mode)) {
+                info.size     = CAST<u64>(st.st_size);
+                info.inode    = CAST<u64>(st.st_ino);
+                info.physical = info.size > 0 ? QueryPhysicalOffset(file) : kNoPhysicalOffset;
+                info.found    = true;
+            }
+            CloseFile(file);
+#endif
+            return info;
+        }
+
+        /// Reads up to `size` bytes from the start of `path` into `data`; returns the bytes read or -1
+        i64 ReadWholeFile(const Path& path, u8* data, u64 size) {
+            const NativeFile file = OpenForRead(path);
+            if (file == kInvalidFile) { return -1; }
+            u64 total = 0;
+            while (total < size) {
+                const i64 read = ReadAt(file, data + total, X_MIN(size - total, kMaxIoPerCall), total);
+                if (read < 0) {
+                    CloseFile(file);
+                    return -1;
+                }
+                if (read == 0) { break; }  // Truncated since it was stat'ed
+                total += CAST<u64>(read);
+            }
+            CloseFile(file);
+            return CAST<i64>(total);
+        }
+
+        /// Runs `func(i)` for every i in [0, count) on up to `width` threads. The caller works through the range
+        /// too and only waits for items already claimed, so this is safe to call from an executor worker even when
+        /// every other worker is busy. If `func` throws, no further items are handed out; the first exception is
+        /// rethrown here once every claimed item has finished.
+        void ParallelFor(size_t count, u32 width, IoPriority priority, const std::function<void(size_t)>& func) {
+            struct Shared {
+                std::atomic<size_t> next {0};
+                std::atomic<size_t> done {0};
+                std::atomic<bool> failed {false};
+                std::exception_ptr error;  // Written once by the thread that set `failed`, read after `done`
+                size_t count = 0;
+                const std::function<void(size_t)>* func = nullptr;
+            };
+
+            auto shared   = make_shared<Shared>();
+            shared->count = count;
+            shared->func  = &func;
+
+            // Helpers that start after the range is exhausted never touch `func`, so it may live on our stack
+            const auto drain = [](Shared& state) noexcept {
+                for (;;) {
+                    const size_t index = state.next.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= state.count) { return; }
+                    size_t finished = 1;
+                    try {
+                        (*state.func)(index);
+                    } catch (...) {
+                        if (!state.failed.exchange(true, std::memory_order_relaxed)) {
+                            state.error = std::current_exception();
+                        }
+                        // Close the range; items nobody claimed yet count as finished so the caller stops waiting
+                        const size_t claimed = state.next.exchange(state.count, std::memory_order_relaxed);
+                        finished += state.count - X_MIN(claimed, state.count);
+                    }
+                    if (state.done.fetch_add(finished, std::memory_order_acq_rel) + finished == state.count) {
+                        state.done.notify_all();
+                    }
+                }
+            };
+
+            const size_t helpers = X_MIN(CAST<size_t>(X_MAX(width, 1u)), count) - (count > 0 ? 1 : 0);
+            for (size_t i = 0; i < helpers; ++i) {
+                IoExecutor::Default().Submit(priority, [shared, drain]() { drain(*shared); });
+            }
+            drain(*shared);
+
+            size_t done = shared->done.load(std::memory_order_acquire);
+            while (done != count) {
+                shared->done.wait(done, std::memory_order_acquire);
+                done = shared->done.load(std::memory_order_acquire);
+            }
+            if (shared->error) { std::rethrow_exception(shared->error); }
+        }
+    }  // namespace
+
+    size_t BulkLoadResult::Count() const {
+        return mEntries.size();
+    }
+
+    bool BulkLoadResult::Loaded(size_t index) const {
+        return mEntries[index].loaded;
+    }
+
+    size_t BulkLoadResult::FailedCount() const {
+        return CAST<size_t>(std::count_if(mEntries.begin(), mEntries.end(), [](const Entry& e) { return !e.loaded; }));
+    }
+
+    u64 BulkLoadResult::TotalBytes() const {
+        return mTotalBytes;
+    }
+
+    std::span<const u8> BulkLoadResult::operator[](size_t index) const {
+        const Entry& entry = mEntries[index];
+        if (!entry.loaded || entry.size == 0) { return {}; }
+        return {mArena.get() + entry.offset, CAST<size_t>(entry.size)};
+    }
+
+    BulkLoadResult BulkLoader::Load(std::span<const Path> paths, const BulkLoadOptions& options) {
+        X_TRACE_SCOPE_CAT("BulkLoader::Load", "io");
+        const size_t count = paths.size();
+        BulkLoadResult result;
+        result.mEntries.resize(count);
+        if (count == 0) { return result; }
+
+        // Pass 1: sizes and placement keys, fanned out since stat latency dominates on cold metadata
+        std::vector<BulkFileInfo> infos(count);
+        ParallelFor(count, options.queueDepth, options.priority, [&](size_t i) {
+            if (options.token.IsCancelled()) { return; }
+            infos[i] = QueryBulkFileInfo(paths[i], options.order);
+        });
+        if (options.token.IsCancelled()) { return result; }
+
+        // Pass 2: read order. Files without a physical offset keep their inode order after those that have one
+        std::vector<u32> order(count);
+        for (u32 i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        if (options.order != BulkLoadOrder::Input) {
+            std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+                return std::tie(infos[a].physical, infos[a].inode) < std::tie(infos[b].physical, infos[b].inode);
+            });
+        }
+
+        // Pass 3: lay the arena out in read order so consecutive reads fill consecutive memory
+        u64 total = 0;
+        for (const u32 index : order) {
+            result.mEntries[index].offset = total;
+            result.mEntries[index].size   = infos[index].size;
+            total += infos[index].size;
+        }
+        result.mArena = std::make_unique_for_overwrite<u8[]>(CAST<size_t>(total));
+
+        // Pass 4: positional reads, `queueDepth` at a time
+        ParallelFor(count, options.queueDepth, options.priority, [&](size_t slot) {
+            const u32 index = order[slot];
+            auto& entry     = result.mEntries[index];
+            if (!infos[index].found || options.token.IsCancelled()) { return; }
+
+            X_FS_OP(io, IoOp::BulkLoad, paths[index].CStr());
+            const i64 read = ReadWholeFile(paths[index], result.mArena.get() + entry.offset, entry.size);
+            if (read < 0) { return; }
+            entry.size   = CAST<u64>(read);
+            entry.loaded = true;
+            X_IO_DONE(io, entry.size);
+        });
+
+        for (const auto& entry : result.mEntries) {
+            if (entry.loaded) { result.mTotalBytes += entry.size; }
+        }
+        return result;
+    }
+
+    Future<BulkLoadResult> BulkLoader::LoadAsync(std::vector<Path> paths, const BulkLoadOptions& options) {
+        return Async(IoExecutor::Default(), options.priority, [paths = std::move(paths), options]() {
+            return Load(paths, options);
+        });
+    }
+
+    namespace {
+        /// Creates `dir` and any missing ancestors, stat'ing each distinct directory at most once per batch
+        bool EnsureDirectory(const Path& dir, std::unordered_set<str>& known) {
+            const str key = dir.Str();
+            if (key.empty() || known.contains(key)) { return true; }
+            if (!dir.Exists()) {
+                const Path parent = dir.Parent();
+                if (parent.Str() != key && !EnsureDirectory(parent, known)) { return false; }
+                if (!dir.Create()) { return false; }
+            }
+            known.insert(key);
+            return true;
+        }
+
+        bool WriteWholeFile(const Path& path, std::span<const u8> data, bool flush, const IoControl& control) {
+            if (!control.AcquireOp()) { return false; }
+            const NativeFile file = OpenForWrite(path);
+            if (file == kInvalidFile) { return false; }
+
+            const u64 chunkSize = control.limiter ? control.ChunkSize() : kMaxIoPerCall;
+            u64 total           = 0;
+            bool ok             = true;
+            while (ok && total < data.size()) {
+                const u64 count = X_MIN(data.size() - total, chunkSize);
+                if (!control.Acquire(count, 0)) {
+                    ok = false;
+                    break;
+                }
+                const i64 written = WriteSome(file, data.data() + total, count);
+                if (written <= 0) {
+                    ok = false;
+                    break;
+                }
+                total += CAST<u64>(written);
+            }
+            if (ok && flush) { ok = FlushFile(file); }
+            CloseFile(file);
+            return ok;
+        }
+
+#ifdef X_FS_HAS_SYNCFS
+        /// One syncfs() per distinct filesystem among `dirs`
+        bool SyncFilesystems(const std::unordered_set<str>& dirs) {
+            std::unordered_set<dev_t> synced;
+            bool ok = true;
+            for (const auto& dir : dirs) {
+                struct stat st {};
+                if (stat(dir.c_str(), &st) != 0) {
+                    ok = false;
+                    continue;
+                }
+                if (!synced.insert(st.st_dev).second) { continue; }
+                const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                if (fd < 0 || ::syncfs(fd) != 0) { ok = false; }
+                if (fd >= 0) { ::close(fd); }
+            }
+            return ok;
+        }
+#endif
+    }  // namespace
+
+    size_t BulkWriteResult::Count() const {
+        return mWritten.size();
+    }
+
+    bool BulkWriteResult::Written(size_t index) const {
+        return mWritten[index] != 0;
+    }
+
+    size_t BulkWriteResult::FailedCount() const {
+        return CAST<size_t>(std::count(mWritten.begin(), mWritten.end(), u8(0)));
+    }
+
+    u64 BulkWriteResult::TotalBytes() const {
+        return mTotalBytes;
+    }
+
+    bool BulkWriteResult::Succeeded() const {
+        return mSynced && FailedCount() == 0;
+    }
+
+    BulkWriteResult BulkWriter::Write(std::span<const BulkWriteItem> items, const BulkWriteOptions& options) {
+        X_TRACE_SCOPE_CAT("BulkWriter::Write", "io");
+        const size_t count = items.size();
+        BulkWriteResult result;
+        result.mWritten.assign(count, 0);
+        if (count == 0) { return result; }
+
+        // Pass 1: every distinct parent directory, created once, before any writer thread starts
+        std::unordered_set<str> parents;
+        for (const auto& item : items) {
+            parents.insert(item.path.Parent().Str());
+        }
+        std::unordered_set<str> known;
+        std::unordered_set<str> failedParents;
+        for (const auto& dir : parents) {
+            if (!EnsureDirectory(Path(dir), known)) { failedParents.insert(dir); }
+        }
+
+        // Pass 2: the writes themselves. With syncfs available a single call per filesystem at the end replaces
+        // per-file fsync
+#ifdef X_FS_HAS_SYNCFS
+        const bool flushEach = false;
+#else
+        const bool flushEach = options.sync;
+#endif
+        const auto limiter = AsyncFileWriter::RateLimiter();
+        const IoControl control {limiter.get()};
+        ParallelFor(count, options.concurrency, options.priority, [&](size_t i) {
+            const auto& item = items[i];
+            if (options.token.IsCancelled()) { return; }
+            if (!failedParents.empty() && failedParents.contains(item.path.Parent().Str())) { return; }
+
+            X_FS_OP(io, IoOp::BulkWrite, item.path.CStr());
+            if (!WriteWholeFile(item.path, item.data, flushEach, control)) { return; }
+            result.mWritten[i] = 1;
+            X_IO_DONE(io, item.data.size());
+        });
+
+        for (size_t i = 0; i < count; ++i) {
+            if (result.mWritten[i]) { result.mTotalBytes += items[i].data.size(); }
+        }
+
+#ifdef X_FS_HAS_SYNCFS
+        if (options.sync) { result.mSynced = SyncFilesystems(parents); }
+#endif
+        return result;
+    }
+
+    Future<BulkWriteResult> BulkWriter::WriteAsync(std::vector<BulkWriteItem> items,
+                                                   const BulkWriteOptions& options) {
+        return Async(IoExecutor::Default(), options.priority, [items = std::move(items), options]() {
+            return Write(items, options);
+        });
+    }
+#pragma endregion
+
+#pragma region Mapped files
+    MappedFile::MappedFile(const Path& path) {
+        X_FS_OP(io, IoOp::MapFile, path.CStr());
+        const NativeFile file = OpenForRead(path);
+        if (file == kInvalidFile) { return; }
+#ifdef _WIN32
+        LARGE_INTEGER size {};
+        if (::GetFileSizeEx(file, &size)) {
+            if (size.QuadPart > 0) {
+                // The view keeps the mapping object alive, so neither handle is needed once it exists
+                const HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping) {
+                    mData = CAST<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                    mSize = mData ? CAST<size_t>(size.QuadPart) : 0;
+                    ::CloseHandle(mapping);
+                }
+                mOpen = mData != nullptr;
+            } else {
+                mOpen = true;  // Windows cannot map an empty file
+            }
+        }
+#else
+        struct stat st {};
+        if (::fstat(file, &st) == 0 && S_ISREG(st.st_mode)) {
+            if (st.st_size > 0) {
+                void* view = ::mmap(nullptr, CAST<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                if (view != MAP_FAILED) {
+                    ::madvise(view, CAST<size_t>(st.st_size), MADV_SEQUENTIAL);
+                    mData = CAST<const char*>(view);
+                    mSize = CAST<size_t>(st.st_size);
+                }
+                mOpen = mData != nullptr;
+            } else {
+                mOpen = true;  // mmap rejects a zero length
+            }
+        }
+#endif
+        CloseFile(file);
+        X_IO_DONE(io, mSize);
+    }
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : mData(std::exchange(other.mData, nullptr)), mSize(std::exchange(other.mSize, 0)),
+          mOpen(std::exchange(other.mOpen, false)) {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            mData = std::exchange(other.mData, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+            mOpen = std::exchange(other.mOpen, false);
+        }
+        return *this;
+    }
+
+    bool MappedFile::IsOpen() const {
+        return mOpen;
+    }
+
+    const char* MappedFile::Data() const {
+        return mData;
+    }
+
+    size_t MappedFile::Size() const {
+        return mSize;
+    }
+
+    strview MappedFile::View() const {
+        return {mData, mSize};
+    }
+
+    std::span<const u8> MappedFile::Bytes() const {
+        return {RCAST<const u8*>(mData), mSize};
+    }
+
+    void MappedFile::Close() {
+        if (mData) {
+#ifdef _WIN32
+            ::UnmapViewOfFile(mData);
+#else
+            ::munmap(CCAST<char*>(mData), mSize);
+#endif
+        }
+        mData = nullptr;
+        mSize = 0;
+        mOpen = false;
+    }
+#pragma endregion
+
+#pragma region CSV
+    namespace {
+        constexpr size_t kCsvBlockSize   = 64;
+        constexpr size_t kCsvIndexWindow = 256_KILOBYTES;  // In-place input is classified this much at a time
+        constexpr size_t kCsvMinChunk    = 1_MEGABYTES;    // Smaller chunks cost more to split than they save
+
+        /// One bit per byte of a 64-byte block
+        struct CsvBlockMasks {
+            u64 quotes     = 0;
+            u64 delimiters = 0;
+            u64 newlines   = 0;
+        };
+
+#if defined(X_SIMD_AVX2)
+        CsvBlockMasks ClassifyCsvBlock(const char* block, const CsvOptions& options) {
+            const __m256i lo = _mm256_loadu_si256(RCAST<const __m256i*>(block));
+            const __m256i hi = _mm256_loadu_si256(RCAST<const __m256i*>(block + 32));
+            const auto match = [&](char c) {
+                const __m256i splat = _mm256_set1_epi8(c);
+                const u64 low       = CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, splat)));
+                const u64 high      = CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, splat)));
+                return low | (high << 32);
+            };
+            return {match(options.quote), match(options.delimiter), match('\n')};
+        }
+#elif defined(X_SIMD_SSE2)
+        CsvBlockMasks ClassifyCsvBlock(const char* block, const CsvOptions& options) {
+            __m128i lanes[4];
+            for (int i = 0; i < 4; ++i) {
+                lanes[i] = _mm_loadu_si128(RCAST<const __m128i*>(block + 16 * i));
+            }
+            const auto match = [&](char c) {
+                const __m128i splat = _mm_set1_epi8(c);
+                u64 bits            = 0;
+                for (int i = 0; i < 4; ++i) {
+                    bits |= CAST<u64>(CAST<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(lanes[i], splat)))) << (16 * i);
+                }
+                return bits;
+            };
+            return {match(options.quote), match(options.delimiter), match('\n')};
+        }
+#elif defined(X_SIMD_NEON)
+        CsvBlockMasks ClassifyCsvBlock(const char* block, const CsvOptions& options) {
+            const uint8x16_t weights = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+            uint8x16_t lanes[4];
+            for (int i = 0; i < 4; ++i) {
+                lanes[i] = vld1q_u8(RCAST<const u8*>(block + 16 * i));
+            }
+            // NEON has no movemask: weight each match by its bit, then pairwise-add down to eight bits per byte
+            const auto match = [&](char c) {
+                const uint8x16_t splat = vdupq_n_u8(CAST<u8>(c));
+                uint8x16_t bits[4];
+                for (int i = 0; i < 4; ++i) {
+                    bits[i] = vandq_u8(vceqq_u8(lanes[i], splat), weights);
+                }
+                uint8x16_t sum = vpaddq_u8(vpaddq_u8(bits[0], bits[1]), vpaddq_u8(bits[2], bits[3]));
+                sum            = vpaddq_u8(sum, sum);
+                return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+            };
+            return {match(options.quote), match(options.delimiter), match('\n')};
+        }
+#else
+        CsvBlockMasks ClassifyCsvBlock(const char* block, const CsvOptions& options) {
+            CsvBlockMasks masks;
+            for (u32 i = 0; i < kCsvBlockSize; ++i) {
+                masks.quotes |= CAST<u64>(block[i] == options.quote) << i;
+                masks.delimiters |= CAST<u64>(block[i] == options.delimiter) << i;
+                masks.newlines |= CAST<u64>(block[i] == '\n') << i;
+            }
+            return masks;
+        }
+#endif
+
+        /// Bit i of the result is the XOR of bits 0..i, so applied to the quote bits it sets every bit from an
+        /// opening quote up to (not including) its closing quote
+        u64 PrefixXor(u64 bits) {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        /// Classifies data[begin, end) a block at a time and calls `onBlock(offset, masks, inside)`, where `inside`
+        /// marks the bytes within quotes; stops early if it returns false. `inQuotes` is all ones while the input
+        /// so far ends inside quotes and carries that state from one call to the next.
+        template<typename OnBlock>
+        void ScanCsv(const char* data, size_t begin, size_t end, const CsvOptions& options, u64& inQuotes,
+                     OnBlock&& onBlock) {
+            for (size_t offset = begin; offset < end; offset += kCsvBlockSize) {
+                CsvBlockMasks masks;
+                if (end - offset >= kCsvBlockSize) {
+                    masks = ClassifyCsvBlock(data + offset, options);
+                } else {
+                    char padded[kCsvBlockSize] {};
+                    std::memcpy(padded, data + offset, end - offset);
+                    masks             = ClassifyCsvBlock(padded, options);
+                    const u64 present = X_BIT(end - offset) - 1;
+                    masks.quotes &= present;
+                    masks.delimiters &= present;
+                    masks.newlines &= present;
+                }
+                const u64 inside = PrefixXor(masks.quotes) ^ inQuotes;
+                inQuotes         = CAST<u64>(CAST<i64>(inside) >> 63);
+                if (!onBlock(offset, masks, inside)) { return; }
+            }
+        }
+
+        /// Offset just past the first newline outside quotes at or after `begin`, or the end of `text`
+        size_t FindCsvRowStart(strview text, size_t begin, const CsvOptions& options, u64 inQuotes) {
+            size_t start       = text.size();
+            const auto onBlock = [&](size_t offset, const CsvBlockMasks& masks, u64 inside) {
+                const u64 newlines = masks.newlines & ~inside;
+                if (!newlines) { return true; }
+                start = offset + std::countr_zero(newlines) + 1;
+                return false;
+            };
+            ScanCsv(text.data(), begin, text.size(), options, inQuotes, onBlock);
+            return start;
+        }
+    }  // namespace
+
+    strview CsvRow::Unescaped(size_t index, str& scratch) const {
+        const strview field = mFields[index];
+        size_t quote        = field.find(mQuote);
+        if (quote == strview::npos) { return field; }
+
+        scratch.clear();
+        size_t start = 0;
+        while (quote != strview::npos) {
+            scratch.append(field.substr(start, quote + 1 - start));
+            start = quote + 1;
+            if (start < field.size() && field[start] == mQuote) { ++start; }  // Skip the second quote of the pair
+            quote = field.find(mQuote, start);
+        }
+        scratch.append(field.substr(start));
+        return scratch;
+    }
+
+    CsvReader::CsvReader(const Path& path, const CsvOptions& options, size_t bufferSize)
+        : mStream(path.Str(), std::ios::binary), mBuffer(X_MAX(bufferSize, kCsvBlockSize)), mOptions(options) {
+        mData = mBuffer.data();
+        X_IO_ONLY(mStatsPrefixId = IoStats::MatchPrefix(path.CStr()));
+    }
+
+    CsvReader::CsvReader(strview text, const CsvOptions& options)
+        : mOptions(options), mData(text.data()), mEnd(text.size()), mInPlace(true), mEof(true) {}
+
+    bool CsvReader::Next(CsvRow& row) {
+        row.mQuote = mOptions.quote;
+
+        const auto addField = [&](size_t start, size_t end) {
+            strview field(mData + start, end - start);
+            if (field.size() >= 2 && field.front() == mOptions.quote && field.back() == mOptions.quote) {
+                field = field.substr(1, field.size() - 2);
+            }
+            row.mFields.push_back(field);
+        };
+        // Adds the last field of a row ending at `end`; false for a blank line
+        const auto finishRow = [&](size_t rowStart, size_t fieldStart, size_t end) {
+            if (end > fieldStart && mData[end - 1] == '\r') { --end; }
+            if (end == rowStart) { return false; }
+            addField(fieldStart, end);
+            row.mOffset = mDataOffset + rowStart;
+            return true;
+        };
+
+        // mNextSep only moves past whole rows, so after a refill, which may move the buffer, the row is walked again
+        // from its first separator
+        for (bool more = true;; more = Advance()) {
+            row.mFields.clear();
+            size_t fieldStart = mBegin;
+            for (size_t i = mNextSep; i < mSeparators.size(); ++i) {
+                const size_t pos = mIndexBase + mSeparators[i];
+                if (mData[pos] != '\n') {
+                    addField(fieldStart, pos);
+                    fieldStart = pos + 1;
+                    continue;
+                }
+
+                const size_t rowStart = mBegin;
+                mBegin                = pos + 1;
+                mNextSep              = i + 1;
+                if (finishRow(rowStart, fieldStart, pos)) { return true; }
+                fieldStart = mBegin;
+            }
+
+            if (!more) {
+                // The last row has no line terminator
+                const size_t rowStart = mBegin;
+                mBegin                = mEnd;
+                mNextSep              = mSeparators.size();
+                return rowStart < mEnd && finishRow(rowStart, fieldStart, mEnd);
+            }
+        }
+    }
+
+    bool CsvReader::IsOpen() const {
+        return mInPlace || mStream.is_open();
+    }
+
+    u64 CsvReader::Position() const {
+        return mDataOffset + mBegin;
+    }
+
+    bool CsvReader::Advance() {
+        // Rebase the separators onto the current row, so the 32-bit offsets only ever span unconsumed input
+        mSeparators.erase(mSeparators.begin(), mSeparators.begin() + CAST<std::ptrdiff_t>(mNextSep));
+        for (u32& separator : mSeparators) {
+            separator = CAST<u32>(mIndexBase + separator - mBegin);
+        }
+        mNextSep   = 0;
+        mIndexBase = mBegin;
+
+        if (mInPlace) {
+            if (mIndexed == mEnd) { return false; }
+            Index(X_MIN(mEnd, mIndexed + kCsvIndexWindow));
+            return true;
+        }
+
+        if (mEof) { return false; }
+        X_FS_OP(io, IoOp::CsvRead, mStatsPrefixId);
+
+        if (mBegin > 0) {
+            std::memmove(mBuffer.data(), mBuffer.data() + mBegin, mEnd - mBegin);
+            mDataOffset += mBegin;
+            mIndexed -= mBegin;
+            mEnd -= mBegin;
+            mBegin     = 0;
+            mIndexBase = 0;
+        }
+        if (mEnd == mBuffer.size()) { mBuffer.resize(mBuffer.size() * 2); }  // One row fills the whole buffer
+        mData = mBuffer.data();
+
+        mStream.read(mBuffer.data() + mEnd, CAST<std::streamsize>(mBuffer.size() - mEnd));
+        const auto count = CAST<size_t>(mStream.gcount());
+        mEnd += count;
+        if (!mStream) { mEof = true; }
+        X_IO_DONE(io, count);
+
+        Index(mEnd);
+        return count > 0;
+    }
+
+    void CsvReader::Index(size_t end) {
+        ScanCsv(mData, mIndexed, end, mOptions, mInQuotes, [&](size_t offset, const auto& masks, u64 inside) {
+            u64 separators = (masks.delimiters | masks.newlines) & ~inside;
+            while (separators) {
+                mSeparators.push_back(CAST<u32>(offset + std::countr_zero(separators) - mIndexBase));
+                separators &= separators - 1;
+            }
+            return true;
+        });
+        mIndexed = end;
+    }
+
+    u64 CsvReader::ParseParallel(strview text,
+                                 const std::function<void(size_t chunk, const CsvRow& row)>& onRow,
+                                 const CsvOptions& options,
+                                 u32 threads) {
+        if (threads == 0) { threads = X_MAX(1u, std::thread::hardware_concurrency()); }
+        const size_t chunkCount = X_MAX(CAST<size_t>(1), X_MIN(text.size() / kCsvMinChunk, CAST<size_t>(threads) * 4));
+        const size_t chunkSize  = text.size() / chunkCount;
+        const auto chunkEnd     = [&](size_t chunk) {
+            return chunk + 1 == chunkCount ? text.size() : (chunk + 1) * chunkSize;
+        };
+
+        // Quotes toggle the state and a doubled quote toggles it twice, so the parity of the quotes before a
+        // chunk says whether it starts inside a quoted field
+        std::vector<u64> startsInQuotes(chunkCount, 0);
+        ParallelFor(chunkCount - 1, threads, IoPriority::Normal, [&](size_t chunk) {
+            u64 inQuotes = 0;
+            ScanCsv(text.data(), chunk * chunkSize, chunkEnd(chunk), options, inQuotes, [](size_t, const auto&, u64) {
+                return true;
+            });
+            startsInQuotes[chunk + 1] = inQuotes;
+        });
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            startsInQuotes[chunk] ^= startsInQuotes[chunk - 1];
+        }
+
+        // Each chunk owns the rows that start inside it: from its first row boundary up to the next chunk's
+        std::vector<size_t> rowStarts(chunkCount + 1, text.size());
+        rowStarts[0] = 0;
+        ParallelFor(chunkCount - 1, threads, IoPriority::Normal, [&](size_t i) {
+            rowStarts[i + 1] = FindCsvRowStart(text, (i + 1) * chunkSize, options, startsInQuotes[i + 1]);
+        });
+
+        std::atomic<u64> rows {0};
+        ParallelFor(chunkCount, threads, IoPriority::Normal, [&](size_t chunk) {
+            const size_t begin = rowStarts[chunk];
+            const size_t end   = X_MAX(begin, rowStarts[chunk + 1]);
+            CsvReader reader(text.substr(begin, end - begin), options);
+            reader.mDataOffset = begin;
+
+            CsvRow row;
+            u64 count = 0;
+            while (reader.Next(row)) {
+                onRow(chunk, row);
+                ++count;
+            }
+            rows.fetch_add(count, std::memory_order_relaxed);
+        });
+        return rows.load(std::memory_order_relaxed);
+    }
+#pragma endregion
+
+#pragma region Search
+    namespace {
+        constexpr size_t kSearchMapThreshold = 256_KILOBYTES;  // Larger files are mapped rather than read
+        constexpr size_t kBinaryProbeSize    = 8_KILOBYTES;
+        constexpr size_t kFileBacklog        = 256;  // Queued files before workers stop favoring directories
+        constexpr size_t kMatchBatch         = 1024;  // Matches buffered before they are handed to the callback
+
+        /// Appends the subdirectories and files of `dir`; symbolic links and junctions are left out, so a link
+        /// cycle cannot trap the walk
+        void ListDirectory(const Path& dir, std::vector<Path>& dirs, std::vector<Path>& files) {
+#ifdef _WIN32
+            const str pattern = dir.Str() + "\\*";
+            WIN32_FIND_DATAA data;
+            const HANDLE find = ::FindFirstFileA(pattern.c_str(), &data);
+            if (find == INVALID_HANDLE_VALUE) { return; }
+            do {
+                if (strcmp(data.cFileName, ".") == 0 || strcmp(data.cFileName, "..") == 0) { continue; }
+                if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) { continue; }
+                (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ? dirs : files).push_back(dir / data.cFileName);
+            } while (::FindNextFileA(find, &data));
+            ::FindClose(find);
+#else
+            DIR* handle = ::opendir(dir.CStr());
+            if (!handle) { return; }
+            while (const dirent* entry = ::readdir(handle)) {
+                if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) { continue; }
+                Path child     = dir / entry->d_name;
+                unsigned type = entry->d_type;
+                if (type == DT_UNKNOWN) {  // Some filesystems leave the type to lstat
+                    struct stat st {};
+                    if (::lstat(child.CStr(), &st) != 0) { continue; }
+                    type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_LNK;
+                }
+                if (type == DT_DIR) {
+                    dirs.push_back(std::move(child));
+                } else if (type == DT_REG) {
+                    files.push_back(std::move(child));
+                }
+            }
+            ::closedir(handle);
+#endif
+        }
+
+        bool HasExtension(const Path& path, const std::vector<str>& extensions) {
+            return extensions.empty() ||
+                   std::ranges::any_of(extensions, [&](const str& wanted) { return path.HasExtension(wanted); });
+        }
+
+        /// Newlines in [begin, end), eight bytes at a time: a byte of `word ^ "\n\n..."` is zero exactly where the
+        /// text has '\n', and the mask below sets the high bit of exactly those bytes
+        u64 CountNewlines(const char* begin, const char* end) {
+            constexpr u64 kNewlines = 0x0A0A0A0A0A0A0A0AULL;
+            constexpr u64 kLow7     = 0x7F7F7F7F7F7F7F7FULL;
+            u64 count               = 0;
+            for (; end - begin >= 8; begin += 8) {
+                u64 word;
+                std::memcpy(&word, begin, sizeof(word));
+                const u64 x = word ^ kNewlines;
+                count += std::popcount(~(((x & kLow7) + kLow7) | x | kLow7));
+            }
+            for (; begin < end; ++begin) {
+                count += *begin == '\n';
+            }
+            return count;
+        }
+
+        /// Work shared by the search threads: directories still to list and files still to search
+        struct SearchQueue {
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::deque<Path> dirs;
+            std::deque<Path> files;
+            u32 busy  = 0;  // Threads working on an item, which may queue more
+            bool stop = false;
+
+            std::mutex deliverMutex;  // Serializes calls to the match callback
+            const FileSearcher::MatchCallback* onMatch = nullptr;
+            u64 maxResults                             = 0;
+            u64 delivered                              = 0;
+            bool finished                              = false;  // The callback asked to stop or maxResults was hit
+
+            std::atomic<u64> filesSearched {0};
+            std::atomic<u64> binaryFiles {0};
+            std::atomic<u64> failedFiles {0};
+            std::atomic<u64> bytesSearched {0};
+        };
+
+        /// A match within the file being searched, before it is handed to the callback
+        struct FileMatch {
+            u64 line    = 0;
+            u64 offset  = 0;
+            u32 pattern = 0;
+        };
+
+        /// Hands the matches of one file to the callback and clears them. `shared` is created on the first
+        /// delivery, so every match of the file points at one copy of `path`. Returns false once the search is over.
+        bool DeliverMatches(SearchQueue& queue,
+                            const Path& path,
+                            shared_ptr<const Path>& shared,
+                            std::vector<FileMatch>& found) {
+            std::lock_guard lock(queue.deliverMutex);
+            for (const FileMatch& match : found) {
+                if (queue.finished) { break; }
+                if (!shared) { shared = make_shared<const Path>(path); }
+                ++queue.delivered;
+                queue.finished = !(*queue.onMatch)(SearchMatch {shared, match.line, match.offset, match.pattern}) ||
+                                 queue.delivered >= queue.maxResults;
+            }
+            found.clear();
+            return !queue.finished;
+        }
+
+        /// Runs `func` on `count` threads of its own, the caller's among them, and returns once all of them have
+        /// finished. For work that blocks on its siblings, which must not hold executor workers for its whole run.
+        /// The first exception `func` throws is rethrown here after every thread has left.
+        void RunOnThreads(u32 count, const std::function<void()>& func) {
+            std::mutex mutex;
+            std::exception_ptr error;
+            const auto run = [&]() noexcept {
+                try {
+                    func();
+                } catch (...) {
+                    std::lock_guard lock(mutex);
+                    if (!error) { error = std::current_exception(); }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            try {
+                threads.reserve(count > 0 ? count - 1 : 0);
+                for (u32 i = 1; i < count; ++i) {
+                    threads.emplace_back(run);
+                }
+            } catch (const std::system_error&) {}  // Out of threads; the ones running, the caller's included, suffice
+            run();
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            if (error) { std::rethrow_exception(error); }
+        }
+
+        /// Searches one file, delivering its matches a batch at a time so a huge file streams its results.
+        /// `overlap` is the longest pattern length less one. Returns false once the search is over.
+        bool SearchFile(const Path& path,
+                        const PatternMatcher& matcher,
+                        size_t overlap,
+                        const SearchOptions& options,
+                        std::vector<char>& buffer,
+                        std::vector<FileMatch>& found,
+                        SearchQueue& queue) {
+            X_FS_OP(io, IoOp::SearchFile, path.CStr());
+
+            struct stat st {};
+            if (stat(path.CStr(), &st) != 0 || !S_ISREG(st.st_mode)) {
+                queue.failedFiles.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            strview text;
+            std::optional<MappedFile> mapped;
+            const auto size = CAST<u64>(st.st_size);
+            if (size < kSearchMapThreshold) {
+                buffer.resize(CAST<size_t>(size));
+                const i64 read = ReadWholeFile(path, RCAST<u8*>(buffer.data()), size);
+                if (read < 0) {
+                    queue.failedFiles.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                text = strview(buffer.data(), CAST<size_t>(read));
+            } else {
+                mapped.emplace(path);
+                if (!mapped->IsOpen()) {
+                    queue.failedFiles.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                text = mapped->View();
+            }
+
+            if (text.empty()) {  // Nothing to probe or scan, and an empty buffer may have a null data()
+                queue.filesSearched.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (options.skipBinary && std::memchr(text.data(), '\0', X_MIN(text.size(), kBinaryProbeSize))) {
+                queue.binaryFiles.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            queue.filesSearched.fetch_add(1, std::memory_order_relaxed);
+            queue.bytesSearched.fetch_add(text.size(), std::memory_order_relaxed);
+            X_IO_DONE(io, text.size());
+
+            // Scanned a chunk at a time so cancellation is seen within a large file. Each window starts `overlap`
+            // bytes back and keeps only matches ending inside the chunk, so matches across a boundary are found
+            // exactly once and still arrive in order of where they end. Line numbers are counted incrementally
+            // between matches; overlapping matches can step back a little.
+            shared_ptr<const Path> shared;
+            u64 line           = 1;
+            size_t lineCounted = 0;
+            bool more          = true;
+            for (size_t chunk = 0; more && chunk < text.size(); chunk += kCancelChunkSize) {
+                if (options.token.IsCancelled()) { return false; }
+                const size_t from = chunk > overlap ? chunk - overlap : 0;
+                const size_t to   = X_MIN(text.size(), chunk + kCancelChunkSize);
+                matcher.Scan(std::span(text.data() + from, to - from), [&](const PatternMatch& match) {
+                    const size_t offset = from + match.offset;
+                    if (offset + matcher.PatternLength(match.pattern) <= chunk) {  // Reported with the last chunk
+                        return true;
+                    }
+                    if (offset >= lineCounted) {
+                        line += CountNewlines(text.data() + lineCounted, text.data() + offset);
+                    } else {
+                        line -= CountNewlines(text.data() + offset, text.data() + lineCounted);
+                    }
+                    lineCounted = offset;
+                    found.push_back({line, offset, match.pattern});
+                    if (found.size() >= kMatchBatch) { more = DeliverMatches(queue, path, shared, found); }
+                    more = more && !options.token.IsCancelled();
+                    return more;
+                });
+                if (more && !found.empty()) { more = DeliverMatches(queue, path, shared, found); }
+            }
+            return more;
+        }
+    }  // namespace
+
+    SearchStats FileSearcher::Search(const Path& root,
+                                     std::span<const strview> patterns,
+                                     const MatchCallback& onMatch,
+                                     const SearchOptions& options) {
+        SearchStats stats;
+        if (patterns.empty()) { return stats; }
+
+        const PatternMatcher matcher(patterns);
+        size_t longest = 1;
+        for (const strview pattern : patterns) {
+            longest = X_MAX(longest, pattern.size());
+        }
+        const size_t overlap = longest - 1;  // Bytes each chunk of a file rescans so no match is split
+        const u32 threads    = options.threads ? options.threads : X_MAX(1u, std::thread::hardware_concurrency());
+
+        SearchQueue queue;
+        queue.onMatch    = &onMatch;
+        queue.maxResults = options.maxResults ? options.maxResults : UINT64_MAX;
+        if (root.IsDirectory()) {
+            queue.dirs.push_back(root);
+        } else {
+            queue.files.push_back(root);
+        }
+
+        // The workers wait on each other for work, so they get threads of their own rather than the executor's
+        RunOnThreads(threads, [&] {
+            std::vector<char> buffer;
+            std::vector<FileMatch> found;
+            std::vector<Path> dirs;
+            std::vector<Path> files;
+
+            // Takes an item off the books however its processing ends. Unless it finished normally the search
+            // stops, so no thread waits on work that will never be queued.
+            struct InFlight {
+                SearchQueue& queue;
+                bool stop = true;
+                ~InFlight() {
+                    {
+                        std::lock_guard lock(queue.mutex);
+                        --queue.busy;
+                        queue.stop = queue.stop || stop;
+                    }
+                    queue.ready.notify_all();
+                }
+            };
+
+            for (;;) {
+                Path item;
+                bool isDir = false;
+                {
+                    std::unique_lock lock(queue.mutex);
+                    queue.ready.wait(lock, [&] {
+                        return queue.stop || !queue.dirs.empty() || !queue.files.empty() || queue.busy == 0;
+                    });
+                    if (queue.stop || (queue.dirs.empty() && queue.files.empty())) { return; }
+
+                    // Listing keeps the queue fed, but past a backlog of files searching them comes first
+                    isDir = !queue.dirs.empty() && queue.files.size() < kFileBacklog;
+                    auto& source = isDir ? queue.dirs : queue.files;
+                    item         = std::move(source.front());
+                    source.pop_front();
+                    ++queue.busy;
+                }
+
+                InFlight inFlight {queue};
+                dirs.clear();
+                files.clear();
+                found.clear();
+                bool more = true;
+                if (isDir) {
+                    ListDirectory(item, dirs, files);
+                    if (!options.recursive) { dirs.clear(); }  // Only the root is ever listed
+                    std::erase_if(files, [&](const Path& file) { return !HasExtension(file, options.extensions); });
+                } else {
+                    more = SearchFile(item, matcher, overlap, options, buffer, found, queue);
+                }
+
+                {
+                    std::lock_guard lock(queue.mutex);
+                    for (Path& dir : dirs) {
+                        queue.dirs.push_back(std::move(dir));
+                    }
+                    for (Path& file : files) {
+                        queue.files.push_back(std::move(file));
+                    }
+                }
+                inFlight.stop = !more || options.token.IsCancelled();
+            }
+        });
+
+        stats.filesSearched = queue.filesSearched.load();
+        stats.binaryFiles   = queue.binaryFiles.load();
+        stats.failedFiles   = queue.failedFiles.load();
+        stats.bytesSearched = queue.bytesSearched.load();
+        stats.matches       = queue.delivered;
+        stats.stoppedEarly  = queue.stop;
+        return stats;
+    }
+
+    SearchStats FileSearcher::Search(const Path& root,
+                                     strview pattern,
+                                     const MatchCallback& onMatch,
+                                     const SearchOptions& options) {
+        return Search(root, std::span<const strview>(&pattern, 1), onMatch, options);
+    }
+#pragma endregion
+
 #pragma region Path
     Path Path::Current() {
+#ifdef _WIN32
         char buffer[MAX_PATH];
         ::GetModuleFileNameA(nullptr, buffer, MAX_PATH);
-        const str::size_type pos = str(buffer).find_last_of("\\/");
-        return Path(str(buffer).substr(0, pos));
+        const str module(buffer);
+#else
+        char buffer[PATH_MAX];
+        const ssize_t length = ::readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+        if (length <= 0) {  // No procfs (e.g. macOS), so fall back to the working directory
+            return Path(::getcwd(buffer, sizeof(buffer)) ? str(buffer) : str("."));
+        }
+        const str module(buffer, CAST<size_t>(length));
+#endif
+        const str::size_type pos = module.find_last_of("\\/");
+        return Path(module.substr(0, pos));
     }
 
     Path Path::Parent() const {
         const size_t lastSeparator = mPath.find_last_of(PATH_SEPARATOR);
-        if (lastSeparator == std::string::npos || lastSeparator == 0) { return Path(X_TOSTR(PATH_SEPARATOR)); }
-        return Path(mPath.substr(0, lastSeparator));
+        if (lastSeparator == std::string::npos || lastSeparator == 0) { return Path(X_TOCHARS(PATH_SEPARATOR).Str()); }
+        return Path(str(mPath.View().substr(0, lastSeparator)));
     }
 
     bool Path::Exists() const {
@@ -336,14 +2078,19 @@ namespace x {
         return pos != str::npos && (sep == str::npos || pos > sep);
     }
 
+    bool Path::HasExtension(strview extension) const {
+        if (!HasExtension()) { return false; }
+        return EqualsIgnoreCase(mPath.View().substr(mPath.find_last_of('.') + 1), extension);
+    }
+
     str Path::Extension() const {
         if (!HasExtension()) { return ""; }
-        return mPath.substr(mPath.find_last_of('.') + 1);
+        return str(mPath.View().substr(mPath.find_last_of('.') + 1));
     }
 
     Path Path::ReplaceExtension(const str& ext) const {
-        if (!HasExtension()) return Path(mPath + "." + ext);
-        return Path(mPath.substr(0, mPath.find_last_of('.')) + "." + ext);
+        if (!HasExtension()) return Path(Str() + "." + ext);
+        return Path(str(mPath.View().substr(0, mPath.find_last_of('.'))) + "." + ext);
     }
 
     Path Path::Join(const str& subPath) const {
@@ -355,7 +2102,7 @@ namespace x {
     }
 
     str Path::Str() const {
-        return mPath;
+        return mPath.Str();
     }
 
     const char* Path::CStr() const {
@@ -364,10 +2111,10 @@ namespace x {
 
     str Path::Filename() const {
         size_t pos = mPath.rfind('\\');
-        if (pos != str::npos) { return mPath.substr(pos + 1); }
+        if (pos != str::npos) { return str(mPath.View().substr(pos + 1)); }
         pos = mPath.rfind('/');
-        if (pos != str::npos) { return mPath.substr(pos + 1); }
-        return mPath;
+        if (pos != str::npos) { return str(mPath.View().substr(pos + 1)); }
+        return mPath.Str();
     }
 
     Path Path::RelativeTo(const Path& basePath) const {
@@ -390,7 +2137,7 @@ namespace x {
     }
 
     Path& Path::Join(const str& subPath) {
-        mPath = Join(Str(), subPath);
+        mPath = Join(mPath, subPath);
         return *this;
     }
 
@@ -407,7 +2154,7 @@ namespace x {
             if (error != ERROR_ALREADY_EXISTS) { return false; }
         }
 #else
-        if (mkdir(path.c_str(), 0755) != 0) {
+        if (mkdir(mPath.c_str(), 0755) != 0) {
             if (errno != EEXIST) { return false; }
         }
 #endif
@@ -427,23 +2174,46 @@ namespace x {
         return Create();
     }
 
-    bool Path::Copy(const Path& dest) const {
+    bool Path::Copy(const Path& dest, IoRateLimiter* limiter) const {
         X_ASSERT(IsFile());
         if (dest == *this) { return true; }
-        if (!::CopyFileA(mPath.c_str(), dest.mPath.c_str(), FALSE)) { return false; }
-        return true;
+#ifdef _WIN32
+        if (!limiter) {
+            if (!::CopyFileA(mPath.c_str(), dest.mPath.c_str(), FALSE)) { return false; }
+            return true;
+        }
+#endif
+
+        // CopyFileA can't be paced and POSIX has no portable equivalent, so stream the file through a chunk-sized
+        // buffer instead
+        std::ifstream in(mPath.c_str(), std::ios::binary);
+        if (!in) { return false; }
+        const IoControl control {limiter};
+        if (!control.AcquireOp()) { return false; }
+        std::ofstream out(dest.mPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) { return false; }
+
+        std::vector<char> buffer(control.ChunkSize());
+        while (in) {
+            in.read(buffer.data(), CAST<std::streamsize>(buffer.size()));
+            const auto count = CAST<size_t>(in.gcount());
+            if (count == 0) { break; }
+            if (!WritePaced(out, buffer.data(), count, control)) { return false; }
+        }
+        return !in.bad() && out.good();
     }
 
-    bool Path::CopyDirectory(const Path& dest) const {
+    bool Path::CopyDirectory(const Path& dest, IoRateLimiter* limiter) const {
         X_ASSERT(IsDirectory());
 
+#ifdef _WIN32
         const DWORD srcAttrs = ::GetFileAttributesA(mPath.c_str());
         if (srcAttrs == INVALID_FILE_ATTRIBUTES) { return false; }
         if (!(srcAttrs & FILE_ATTRIBUTE_DIRECTORY)) { return false; }
 
         if (!::CreateDirectoryA(dest.CStr(), nullptr) && ::GetLastError() != ERROR_ALREADY_EXISTS) { return false; }
 
-        const str searchPattern = mPath + "\\*";
+        const str searchPattern = Str() + "\\*";
         WIN32_FIND_DATAA findData;
         const HANDLE hFind = ::FindFirstFileA(searchPattern.c_str(), &findData);
         if (hFind == INVALID_HANDLE_VALUE) { return false; }
@@ -456,9 +2226,9 @@ namespace x {
             Path destPath = dest / findData.cFileName;
 
             if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-                if (!srcPath.CopyDirectory(destPath)) { success = false; }
+                if (!srcPath.CopyDirectory(destPath, limiter)) { success = false; }
             } else {
-                if (!srcPath.Copy(destPath)) { success = false; }
+                if (!srcPath.Copy(destPath, limiter)) { success = false; }
             }
         } while (::FindNextFileA(hFind, &findData));
 
@@ -468,73 +2238,122 @@ namespace x {
         if (lastError != ERROR_NO_MORE_FILES) { success = false; }
 
         return success;
+#else
+        if (::mkdir(dest.CStr(), 0755) != 0 && errno != EEXIST) { return false; }
+
+        DIR* dir = ::opendir(mPath.c_str());
+        if (!dir) { return false; }
+
+        bool success {true};
+        while (const dirent* entry = ::readdir(dir)) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) { continue; }
+
+            Path srcPath  = Join(entry->d_name);
+            Path destPath = dest / entry->d_name;
+
+            struct stat st {};
+            if (stat(srcPath.CStr(), &st) != 0) {
+                success = false;
+            } else if (S_ISDIR(st.st_mode)) {
+                if (!srcPath.CopyDirectory(destPath, limiter)) { success = false; }
+            } else {
+                if (!srcPath.Copy(destPath, limiter)) { success = false; }
+            }
+        }
+        ::closedir(dir);
+
+        return success;
+#endif
     }
 
     DirectoryEntries Path::Entries() const {
         return DirectoryEntries(*this);
     }
 
-    str Path::Join(const str& lhs, const str& rhs) {
-        if (lhs.empty()) { return lhs; }
-        if (rhs.empty()) { return rhs; }
-        if (lhs.back() == PATH_SEPARATOR) return lhs + rhs;
-        return lhs + PATH_SEPARATOR + rhs;
+    str Path::Join(strview lhs, strview rhs) {
+        if (lhs.empty()) { return str(lhs); }
+        if (rhs.empty()) { return str(rhs); }
+        str joined;
+        joined.reserve(lhs.size() + rhs.size() + 1);
+        joined.append(lhs);
+        if (lhs.back() != PATH_SEPARATOR) { joined += PATH_SEPARATOR; }
+        joined.append(rhs);
+        return joined;
     }
 
     str Path::Normalize(const str& rawPath) {
-        str result;
-        std::vector<str> parts;
+        // Components are appended in place; ".." backs up to the previous separator instead of popping a list
+        StringBuilder result;
+        result.Reserve(rawPath.size() + 1);
+        size_t poppable = 0;  // Components in `result` that a ".." may remove, i.e. everything but leading ".."s
+        const strview raw(rawPath);
         size_t start = 0;
-        while (start < rawPath.size()) {
-            size_t end = rawPath.find(PATH_SEPARATOR, start);
-            if (end == std::string::npos) { end = rawPath.size(); }
-            str part = rawPath.substr(start, end - start);
-            if (part == ".." && !parts.empty() && parts.back() != "..") {
-                parts.pop_back();
+        while (start < raw.size()) {
+            size_t end = raw.find(PATH_SEPARATOR, start);
+            if (end == strview::npos) { end = raw.size(); }
+            const strview part = raw.substr(start, end - start);
+            if (part == ".." && poppable > 0) {
+                result.Truncate(result.View().rfind(PATH_SEPARATOR));
+                --poppable;
             } else if (!part.empty() && part != ".") {
-                parts.push_back(part);
+                result.Append(PATH_SEPARATOR).Append(part);
+                if (part != "..") { ++poppable; }
             }
             start = end + 1;
         }
-        for (const auto& part : parts) {
-            result += PATH_SEPARATOR + part;
-        }
 
+        if (result.Empty()) { return str(1, PATH_SEPARATOR); }
 #ifdef _WIN32
         // Remove the first '/' if Windows path
-        result = result.substr(1, result.size() - 1);
+        return str(result.View().substr(1));
+#else
+        return result.Str();
 #endif
-
-        return result.empty() ? str(1, PATH_SEPARATOR) : result;
     }
 
-    FindHandleWrapper::FindHandleWrapper() : mHandle(INVALID_HANDLE_VALUE) {}
+    namespace {
+#ifdef _WIN32
+        const FindHandle kInvalidFindHandle = INVALID_HANDLE_VALUE;
+
+        void CloseFindHandle(FindHandle handle) {
+            ::FindClose(handle);
+        }
+#else
+        constexpr FindHandle kInvalidFindHandle = nullptr;
+
+        void CloseFindHandle(FindHandle handle) {
+            ::closedir(handle);
+        }
+#endif
+    }  // namespace
+
+    FindHandleWrapper::FindHandleWrapper() : mHandle(kInvalidFindHandle) {}
 
-    FindHandleWrapper::FindHandleWrapper(HANDLE handle) : mHandle(handle) {}
+    FindHandleWrapper::FindHandleWrapper(FindHandle handle) : mHandle(handle) {}
 
     FindHandleWrapper::~FindHandleWrapper() {
-        if (mHandle != INVALID_HANDLE_VALUE) { ::FindClose(mHandle); }
+        if (mHandle != kInvalidFindHandle) { CloseFindHandle(mHandle); }
     }
 
     FindHandleWrapper::FindHandleWrapper(FindHandleWrapper&& other) noexcept : mHandle(other.mHandle) {
-        other.mHandle = INVALID_HANDLE_VALUE;
+        other.mHandle = kInvalidFindHandle;
     }
 
     FindHandleWrapper& FindHandleWrapper::operator=(FindHandleWrapper&& other) noexcept {
         if (this != &other) {
-            if (mHandle != INVALID_HANDLE_VALUE) { ::FindClose(mHandle); }
+            if (mHandle != kInvalidFindHandle) { CloseFindHandle(mHandle); }
             mHandle       = other.mHandle;
-            other.mHandle = INVALID_HANDLE_VALUE;
+            other.mHandle = kInvalidFindHandle;
         }
         return *this;
     }
 
-    HANDLE FindHandleWrapper::Get() const {
+    FindHandle FindHandleWrapper::Get() const {
         return mHandle;
     }
 
     bool FindHandleWrapper::IsValid() const {
-        return mHandle != INVALID_HANDLE_VALUE;
+        return mHandle != kInvalidFindHandle;
     }
 
     DirectoryEntries::DirectoryEntries(const Path& path) : mPath(path) {}
@@ -547,8 +2366,9 @@ namespace x {
             return;
         }
 
+#ifdef _WIN32
         str searchPattern = mRoot.Str() + "\\*";
-        WIN32_FIND_DATA findData;
+        WIN32_FIND_DATAA findData;
         mFindHandle = FindHandleWrapper(::FindFirstFileA(searchPattern.c_str(), &findData));
 
         if (!mFindHandle.IsValid()) {
@@ -556,7 +2376,17 @@ namespace x {
             return;
         }
 
-        ProcessCurrentEntry(findData);
+        ProcessCurrentEntry(findData.cFileName);
+#else
+        mFindHandle = FindHandleWrapper(::opendir(mRoot.CStr()));
+
+        if (!mFindHandle.IsValid()) {
+            mIsEnd = true;
+            return;
+        }
+
+        ReadNextEntry();
+#endif
     }
 
     DirectoryIterator::reference DirectoryIterator::operator*() const {
@@ -569,14 +2399,7 @@ namespace x {
 
     DirectoryIterator& DirectoryIterator::operator++() {
         if (mIsEnd) { return *this; }
-
-        WIN32_FIND_DATAA findData;
-        if (::FindNextFileA(mFindHandle.Get(), &findData) == 0) {
-            mIsEnd = true;
-            return *this;
-        }
-
-        ProcessCurrentEntry(findData);
+        ReadNextEntry();
         return *this;
     }
 
@@ -590,13 +2413,33 @@ namespace x {
         return !(*this == other);
     }
 
-    void DirectoryIterator::ProcessCurrentEntry(const WIN32_FIND_DATAA& findData) {
-        if (strcmp(findData.cFileName, ".") == 0 || strcmp(findData.cFileName, "..") == 0) {
+    void DirectoryIterator::ReadNextEntry() {
+#ifdef _WIN32
+        WIN32_FIND_DATAA findData;
+        if (::FindNextFileA(mFindHandle.Get(), &findData) == 0) {
+            mIsEnd = true;
+            return;
+        }
+
+        ProcessCurrentEntry(findData.cFileName);
+#else
+        const dirent* entry = ::readdir(mFindHandle.Get());
+        if (!entry) {
+            mIsEnd = true;
+            return;
+        }
+
+        ProcessCurrentEntry(entry->d_name);
+#endif
+    }
+
+    void DirectoryIterator::ProcessCurrentEntry(const char* name) {
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
             this->operator++();
             return;
         }
 
-        mCurrent = mRoot / findData.cFileName;
+        mCurrent = mRoot / name;
     }
 
     DirectoryIterator DirectoryEntries::begin() {
@@ -6,10 +6,15 @@
 
 #include "Typedefs.hpp"
 #include "Macros.hpp"
+#include "IoExecutor.hpp"
+#include "Future.hpp"
+#include "Generator.hpp"
+#include "SmallString.hpp"
 #include <fstream>
+#include <functional>
 #include <vector>
 #include <span>
-#include <future>
+#include <mutex>
 
 #ifdef _WIN32
     #ifndef NOMINMAX
@@ -25,20 +30,30 @@
     #define getcwd _getcwd
     #define PATH_SEPARATOR '\\'
 #else
+    #include <dirent.h>
     #include <unistd.h>
     #define PATH_SEPARATOR '/'
 #endif
 
 namespace x {
     class Path;
+    class IoRateLimiter;
 
     class FileReader {
     public:
         static std::vector<u8> ReadBytes(const Path& path);
         static str ReadText(const Path& path);
+        /// @brief ReadText that also requires the contents to be valid UTF-8. On failure returns an empty string and
+        /// sets `invalidOffset` to the first bad byte within the text as read; otherwise sets it to str::npos.
+        static str ReadText(const Path& path, size_t& invalidOffset);
         static std::vector<str> ReadLines(const Path& path);
         static std::vector<u8> ReadBlock(const Path& path, size_t size, u64 offset = 0);
         static size_t QueryFileSize(const Path& path);
+
+        /// @brief Lazy ReadLines. Reads through a fixed `bufferSize` window, so memory stays bounded by the buffer
+        /// (or the longest line, if that is larger) regardless of file size. Each view is valid until the next
+        /// line is requested. Accepts LF and CRLF line endings.
+        static Generator<strview> StreamLines(Path path, size_t bufferSize = 64_KILOBYTES);
     };
 
     class FileWriter {
@@ -51,37 +66,46 @@ namespace x {
 
     class AsyncFileReader {
     public:
-        static std::future<std::vector<u8>> ReadBytes(const Path& path);
-        static std::future<str> ReadText(const Path& path);
-        static std::future<std::vector<str>> ReadLines(const Path& path);
-        static std::future<std::vector<u8>> ReadBlock(const Path& path, size_t size, u64 offset = 0);
+        // Cancelled or expired requests resolve to an empty result
+        static Future<std::vector<u8>> ReadBytes(const Path& path, const AsyncOptions& options = {});
+        static Future<str> ReadText(const Path& path, const AsyncOptions& options = {});
+        static Future<std::vector<str>> ReadLines(const Path& path, const AsyncOptions& options = {});
+        static Future<std::vector<u8>>
+        ReadBlock(const Path& path, size_t size, u64 offset = 0, const AsyncOptions& options = {});
 
     private:
+        // Reads nobody is waiting on anymore are skipped if they have not started yet
         template<typename Func>
-        static auto RunAsync(Func&& func) -> std::future<decltype(func())> {
-            using ReturnType = decltype(func());
-            auto task        = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Func>(func));
-            std::future<ReturnType> future = task->get_future();
-            std::thread([task]() { (*task)(); }).detach();
-            return future;
+        static auto RunAsync(const AsyncOptions& options, Func&& func) {
+            return Async<AbandonPolicy::Skip>(IoExecutor::Default(), options.priority, std::forward<Func>(func));
         }
     };
 
     class AsyncFileWriter {
     public:
-        static std::future<bool> WriteBytes(const Path& path, const std::vector<u8>& data);
-        static std::future<bool> WriteText(const Path& path, const str& text);
-        static std::future<bool> WriteLines(const Path& path, const std::vector<str>& lines);
-        static std::future<bool> WriteBlock(const Path& path, const std::span<const u8>& data, u64 offset = 0);
+        // Cancelled or expired requests resolve to false; a write stopped midway leaves a partial file
+        static Future<bool>
+        WriteBytes(const Path& path, const std::vector<u8>& data, const AsyncOptions& options = {});
+        static Future<bool> WriteText(const Path& path, const str& text, const AsyncOptions& options = {});
+        static Future<bool>
+        WriteLines(const Path& path, const std::vector<str>& lines, const AsyncOptions& options = {});
+        static Future<bool> WriteBlock(const Path& path,
+                                       const std::span<const u8>& data,
+                                       u64 offset                  = 0,
+                                       const AsyncOptions& options = {});
+
+        /// @brief Paces every subsequent async write through `limiter`. Pass nullptr to remove it.
+        static void SetRateLimiter(shared_ptr<IoRateLimiter> limiter);
+        static shared_ptr<IoRateLimiter> RateLimiter();
 
     private:
+        static std::mutex& RateLimiterMutex();
+        static shared_ptr<IoRateLimiter>& RateLimiterSlot();
+
+        // Writes always run, callers commonly drop the future of a fire-and-forget write
         template<typename Func>
-        static auto RunAsync(Func&& func) -> std::future<decltype(func())> {
-            using ReturnType = decltype(func());
-            auto task        = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Func>(func));
-            std::future<ReturnType> future = task->get_future();
-            std::thread([task]() { (*task)(); }).detach();
-            return future;
+        static auto RunAsync(const AsyncOptions& options, Func&& func) {
+            return Async<AbandonPolicy::Run>(IoExecutor::Default(), options.priority, std::forward<Func>(func));
         }
     };
 
@@ -99,6 +123,15 @@ namespace x {
         bool Read(std::vector<u8>& data, size_t size);
         bool ReadAll(std::vector<u8>& data);
         bool ReadLine(str& line);
+        /// @brief Reads up to the next occurrence of `delimiter`, which may be several bytes long. The delimiter is
+        /// consumed but not stored. A final record without a trailing delimiter is still returned.
+        bool ReadUntil(strview delimiter, str& record);
+
+        /// @brief When enabled, ReadLine and ReadUntil return false for a line or record that is not valid UTF-8.
+        /// The text is still stored so the caller can inspect it, and InvalidUtf8Position reports where it broke.
+        void SetUtf8Validation(bool enabled);
+        /// @brief File offset of the first invalid byte found since validation was enabled, or ~0 if none.
+        X_NODISCARD u64 InvalidUtf8Position() const;
 
         X_NODISCARD bool IsOpen() const;
         X_NODISCARD size_t Size() const;
@@ -109,7 +142,216 @@ namespace x {
 
     private:
         std::ifstream mStream;
-        size_t mSize = 0;
+        size_t mSize             = 0;
+        i32 mStatsPrefixId       = -1;
+        bool mValidateUtf8       = false;
+        u64 mInvalidUtf8Position = ~0ULL;
+
+        bool CheckUtf8(strview text, u64 start);
+    };
+
+    enum class LengthPrefix : u8 {
+        U8,
+        U16LE,
+        U16BE,
+        U32LE,
+        U32BE,
+        U64LE,
+        U64BE,
+        Varint,  // Unsigned LEB128, as used by protobuf
+    };
+
+    /// @brief Buffered reader that splits a file into records and returns them as views into its own buffer.
+    ///
+    /// A returned view is valid until the next call on the reader. The buffer only grows when a single record
+    /// is larger than it.
+    class RecordReader {
+    public:
+        explicit RecordReader(const Path& path, size_t bufferSize = 64_KILOBYTES);
+
+        RecordReader(const RecordReader&)            = delete;
+        RecordReader& operator=(const RecordReader&) = delete;
+
+        RecordReader(RecordReader&&) noexcept            = default;
+        RecordReader& operator=(RecordReader&&) noexcept = default;
+
+        /// @brief Reads up to the next `delimiter` (one or more bytes) and consumes it. A final record without a
+        /// trailing delimiter is still returned.
+        bool ReadUntil(strview delimiter, strview& record);
+        /// @brief Reads a LF or CRLF terminated line without its terminator.
+        bool ReadLine(strview& line);
+        /// @brief Reads a length header in the given encoding, then that many bytes.
+        bool ReadLengthPrefixed(LengthPrefix prefix, std::span<const u8>& record);
+        bool ReadExact(size_t size, std::span<const u8>& record);
+
+        /// @brief Length-prefixed records claiming more than this fail instead of growing the buffer. 256 MiB by
+        /// default.
+        void SetMaxRecordSize(size_t size);
+
+        X_NODISCARD bool IsOpen() const;
+        /// @brief True once a truncated or oversized record was hit. Reads fail from then on.
+        X_NODISCARD bool HasError() const;
+        /// @brief Bytes consumed so far.
+        X_NODISCARD u64 Position() const;
+
+    private:
+        std::ifstream mStream;
+        std::vector<char> mBuffer;
+        size_t mBegin         = 0;  // First unconsumed byte
+        size_t mEnd           = 0;  // One past the last valid byte
+        size_t mScanned       = 0;  // ReadUntil has ruled out delimiter starts before this
+        u64 mBufferOffset     = 0;  // File offset of mBuffer[0]
+        size_t mMaxRecordSize = 256_MEGABYTES;
+        bool mEof             = false;
+        bool mError           = false;
+        i32 mStatsPrefixId    = -1;
+
+        X_NODISCARD size_t Available() const {
+            return mEnd - mBegin;
+        }
+
+        /// Makes at least `size` bytes available from mBegin; false if the file ends first
+        bool Ensure(size_t size);
+        /// Appends more data behind the unconsumed bytes; false at end of file
+        bool Fill(size_t minimumSize);
+        bool Fail();
+    };
+
+    /// @brief Read-only memory mapping of a whole file, for parsing or searching large files in place without
+    /// copying them into a buffer first.
+    ///
+    /// An empty file opens successfully but maps nothing. The view is valid until the MappedFile is closed or
+    /// destroyed; a file truncated by someone else while mapped can fault on access.
+    class MappedFile {
+    public:
+        explicit MappedFile(const Path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&&) noexcept;
+        MappedFile& operator=(MappedFile&&) noexcept;
+
+        X_NODISCARD bool IsOpen() const;
+        X_NODISCARD const char* Data() const;
+        X_NODISCARD size_t Size() const;
+        X_NODISCARD strview View() const;
+        X_NODISCARD std::span<const u8> Bytes() const;
+
+        void Close();
+
+    private:
+        const char* mData = nullptr;
+        size_t mSize      = 0;
+        bool mOpen        = false;
+    };
+
+    struct CsvOptions {
+        char delimiter = ',';  // '\t' for TSV
+        char quote     = '"';
+    };
+
+    /// @brief One record from a CsvReader: its fields as views into the reader's buffer or the parsed text.
+    ///
+    /// Fields wrapped in quotes are returned without them. A doubled quote inside stays doubled in the view; use
+    /// Unescaped for the literal text. Reusing one CsvRow across reads keeps its field list allocated.
+    class CsvRow {
+    public:
+        X_NODISCARD size_t Size() const {
+            return mFields.size();
+        }
+
+        X_NODISCARD strview operator[](size_t index) const {
+            return mFields[index];
+        }
+
+        X_NODISCARD auto begin() const {
+            return mFields.begin();
+        }
+
+        X_NODISCARD auto end() const {
+            return mFields.end();
+        }
+
+        /// @brief The field with doubled quotes collapsed. Copies into `scratch` only if there are any to collapse.
+        strview Unescaped(size_t index, str& scratch) const;
+
+        /// @brief Offset of the row's first byte in the file or text being parsed.
+        X_NODISCARD u64 Offset() const {
+            return mOffset;
+        }
+
+    private:
+        friend class CsvReader;
+
+        std::vector<strview> mFields;
+        u64 mOffset = 0;
+        char mQuote = '"';
+    };
+
+    /// @brief RFC 4180 CSV (or TSV) reader that yields rows of field views.
+    ///
+    /// Input is classified 64 bytes at a time into bitmasks of quotes, delimiters and newlines; a prefix XOR over
+    /// the quote bits marks which bytes are inside quotes, so every separator of a block is found without a
+    /// branch per byte. The inside-quotes state carries across blocks and buffer refills, so quoted fields may
+    /// contain delimiters and newlines and may straddle any buffer boundary. Rows end at LF or CRLF; blank lines
+    /// are skipped.
+    ///
+    /// Row views are valid until the next call to Next. When reading in place from a string view they stay valid
+    /// as long as the text does.
+    class CsvReader {
+    public:
+        explicit CsvReader(const Path& path, const CsvOptions& options = {}, size_t bufferSize = 1_MEGABYTES);
+        /// @brief Parses `text` in place, e.g. a MappedFile's View(); nothing is copied.
+        explicit CsvReader(strview text, const CsvOptions& options = {});
+
+        CsvReader(const CsvReader&)            = delete;
+        CsvReader& operator=(const CsvReader&) = delete;
+
+        CsvReader(CsvReader&&) noexcept            = default;
+        CsvReader& operator=(CsvReader&&) noexcept = default;
+
+        /// @brief Reads the next row; false once the input is exhausted.
+        bool Next(CsvRow& row);
+
+        X_NODISCARD bool IsOpen() const;
+        /// @brief Bytes consumed so far.
+        X_NODISCARD u64 Position() const;
+
+        /// @brief Parses `text` on up to `threads` threads (0 = one per core) and calls `onRow` for every row.
+        /// Returns the number of rows.
+        ///
+        /// The text is cut into chunks. A first parallel pass counts the quotes in each chunk, which tells every
+        /// chunk whether it starts inside a quoted field, so each can find its first row boundary exactly and
+        /// parse independently. `onRow` runs concurrently from several threads; rows of one chunk arrive in order,
+        /// and `chunk` numbers the chunks in file order so results can be merged deterministically. If `onRow`
+        /// throws, no further chunks are started and the first exception is rethrown once the running ones finish.
+        static u64 ParseParallel(strview text,
+                                 const std::function<void(size_t chunk, const CsvRow& row)>& onRow,
+                                 const CsvOptions& options = {},
+                                 u32 threads               = 0);
+
+    private:
+        std::ifstream mStream;
+        std::vector<char> mBuffer;
+        std::vector<u32> mSeparators;  // Unconsumed delimiter/newline offsets outside quotes, relative to mIndexBase
+        CsvOptions mOptions;
+        const char* mData  = nullptr;  // mBuffer, or the text being parsed in place
+        size_t mBegin      = 0;  // Start of the next row
+        size_t mEnd        = 0;  // One past the last valid byte
+        size_t mIndexed    = 0;  // Bytes classified so far
+        size_t mIndexBase  = 0;
+        size_t mNextSep    = 0;  // First unconsumed entry of mSeparators
+        u64 mDataOffset    = 0;  // Offset of mData[0] in the input
+        u64 mInQuotes      = 0;  // All ones while the classified input ends inside quotes
+        bool mInPlace      = false;
+        bool mEof          = false;
+        i32 mStatsPrefixId = -1;
+
+        /// Classifies more input; false once there is none left
+        bool Advance();
+        void Index(size_t end);
     };
 
     class StreamWriter {
@@ -128,6 +370,9 @@ namespace x {
         bool WriteLine(const str& line);
         bool Flush();
 
+        /// @brief Paces writes through `limiter`, which may be shared with other writers. Pass nullptr to remove it.
+        void SetRateLimiter(shared_ptr<IoRateLimiter> limiter);
+
         bool IsOpen() const;
         bool Seek(u64 offset);
         u64 Position();
@@ -135,6 +380,8 @@ namespace x {
 
     private:
         std::ofstream mStream;
+        shared_ptr<IoRateLimiter> mLimiter;
+        i32 mStatsPrefixId = -1;
     };
 
     class DirectoryIterator;
@@ -152,6 +399,10 @@ namespace x {
         X_NODISCARD bool IsDirectory() const;
         X_NODISCARD bool HasExtension() const;
 
+        /// @brief Whether the extension is `extension` (without the period), ignoring ASCII case, so "jpg" matches
+        /// 'photo.JPG'
+        X_NODISCARD bool HasExtension(strview extension) const;
+
         /// @brief Returns the file extension without the period '.'
         ///
         /// i.e. 'txt' or 'jpeg'
@@ -171,22 +422,29 @@ namespace x {
 
         X_NODISCARD bool Create() const;
         X_NODISCARD bool CreateAll() const;
-        X_NODISCARD bool Copy(const Path& dest) const;
-        X_NODISCARD bool CopyDirectory(const Path& dest) const;
+        /// @brief Copies this file to `dest`. When `limiter` is given the copy is paced through it chunk by chunk.
+        X_NODISCARD bool Copy(const Path& dest, IoRateLimiter* limiter = nullptr) const;
+        X_NODISCARD bool CopyDirectory(const Path& dest, IoRateLimiter* limiter = nullptr) const;
 
         X_NODISCARD DirectoryEntries Entries() const;
 
     private:
-        str mPath;
-        static str Join(const str& lhs, const str& rhs);
+        SmallString<103> mPath;  // Most paths fit inline, and Path stays at 128 bytes
+        static str Join(strview lhs, strview rhs);
         static str Normalize(const str& rawPath);
     };
 
+#ifdef _WIN32
+    using FindHandle = HANDLE;
+#else
+    using FindHandle = DIR*;
+#endif
+
     class FindHandleWrapper {
     public:
         FindHandleWrapper();
 
-        explicit FindHandleWrapper(HANDLE handle);
+        explicit FindHandleWrapper(FindHandle handle);
 
         ~FindHandleWrapper();
 
@@ -196,11 +454,11 @@ namespace x {
         FindHandleWrapper(FindHandleWrapper&& other) noexcept;
         FindHandleWrapper& operator=(FindHandleWrapper&& other) noexcept;
 
-        HANDLE Get() const;
+        FindHandle Get() const;
         bool IsValid() const;
 
     private:
-        HANDLE mHandle;
+        FindHandle mHandle;
     };
 
     class DirectoryEntries {
@@ -241,6 +499,147 @@ namespace x {
         Path mCurrent;
         FindHandleWrapper mFindHandle;
 
-        void ProcessCurrentEntry(const WIN32_FIND_DATAA& findData);
+        void ReadNextEntry();
+        void ProcessCurrentEntry(const char* name);
+    };
+
+    enum class BulkLoadOrder : u8 {
+        Input,           // Read in the order given
+        Inode,           // Inode (NTFS file index) order, a cheap proxy for placement on disk
+        PhysicalOffset,  // Order of the first extent on the device (FIEMAP / FSCTL_GET_RETRIEVAL_POINTERS)
+    };
+
+    struct BulkLoadOptions {
+        BulkLoadOrder order = BulkLoadOrder::Inode;
+        u32 queueDepth      = 32;  // Reads kept in flight at once
+        IoPriority priority = IoPriority::Normal;
+        CancellationToken token;
+    };
+
+    /// @brief Contents of every file from one BulkLoader call, packed into a single arena.
+    class BulkLoadResult {
+    public:
+        X_NODISCARD size_t Count() const;
+        X_NODISCARD bool Loaded(size_t index) const;
+        X_NODISCARD size_t FailedCount() const;
+        X_NODISCARD u64 TotalBytes() const;
+
+        /// @brief Contents of the index'th requested path, empty if it could not be read. Valid for the lifetime
+        /// of this result.
+        X_NODISCARD std::span<const u8> operator[](size_t index) const;
+
+    private:
+        friend class BulkLoader;
+
+        struct Entry {
+            u64 offset  = 0;
+            u64 size    = 0;
+            bool loaded = false;
+        };
+
+        unique_ptr<u8[]> mArena;
+        std::vector<Entry> mEntries;
+        u64 mTotalBytes = 0;
+    };
+
+    /// @brief Loads many files at once: stats them in parallel, orders the reads by on-disk placement and keeps
+    /// `queueDepth` positional reads in flight, all landing in one allocation.
+    class BulkLoader {
+    public:
+        static BulkLoadResult Load(std::span<const Path> paths, const BulkLoadOptions& options = {});
+        static Future<BulkLoadResult> LoadAsync(std::vector<Path> paths, const BulkLoadOptions& options = {});
+    };
+
+    struct BulkWriteItem {
+        Path path;
+        std::span<const u8> data;  // Must stay valid until the write completes
+    };
+
+    struct BulkWriteOptions {
+        u32 concurrency     = 32;  // Files being written at once
+        IoPriority priority = IoPriority::Normal;
+        /// Make everything durable before returning: one syncfs() per filesystem on Linux, a flush per file
+        /// elsewhere
+        bool sync = false;
+        CancellationToken token;
+    };
+
+    class BulkWriteResult {
+    public:
+        X_NODISCARD size_t Count() const;
+        X_NODISCARD bool Written(size_t index) const;
+        X_NODISCARD size_t FailedCount() const;
+        X_NODISCARD u64 TotalBytes() const;
+        /// @brief True if every item was written and, when requested, synced.
+        X_NODISCARD bool Succeeded() const;
+
+    private:
+        friend class BulkWriter;
+
+        std::vector<u8> mWritten;  // Not vector<bool>, items are filled in concurrently
+        u64 mTotalBytes = 0;
+        bool mSynced    = true;
+    };
+
+    /// @brief Writes many files at once. Parent directories are created up front in one deduplicated pass, then
+    /// up to `concurrency` files are written in parallel on the I/O executor. Honors AsyncFileWriter's rate
+    /// limiter.
+    class BulkWriter {
+    public:
+        static BulkWriteResult Write(std::span<const BulkWriteItem> items, const BulkWriteOptions& options = {});
+        static Future<BulkWriteResult> WriteAsync(std::vector<BulkWriteItem> items,
+                                                  const BulkWriteOptions& options = {});
+    };
+
+    struct SearchOptions {
+        u64 maxResults  = 0;  // Stop after this many matches; 0 for no limit
+        u32 threads     = 0;  // 0 for one per core
+        bool recursive  = true;
+        bool skipBinary = true;  // Skip files with a NUL byte in their first 8 KiB, as grep and git do
+        std::vector<str> extensions;  // Only search files with one of these extensions (no period, any case)
+        CancellationToken token;
+    };
+
+    /// @brief One match found by FileSearcher
+    struct SearchMatch {
+        shared_ptr<const Path> path;  // Shared by every match in the file
+        u64 line    = 0;  // 1-based line holding the first byte of the match
+        u64 offset  = 0;  // Byte offset of the match in the file
+        u32 pattern = 0;  // Index of the pattern that matched
+    };
+
+    struct SearchStats {
+        u64 filesSearched = 0;
+        u64 binaryFiles   = 0;  // Skipped because they look binary
+        u64 failedFiles   = 0;  // Could not be opened or read
+        u64 bytesSearched = 0;
+        u64 matches       = 0;  // Matches delivered to the callback
+        bool stoppedEarly = false;  // Hit maxResults, stopped by the callback, or cancelled
+    };
+
+    /// @brief Fixed-string search of every file under a directory, like `grep -rF`.
+    ///
+    /// Directories are listed and files searched in parallel from one shared work queue, so the walk and the
+    /// searching overlap. The search runs on threads of its own, leaving IoExecutor free for other I/O. Small files
+    /// are read into a per-thread buffer and large ones memory-mapped. All patterns are matched in one pass by a
+    /// PatternMatcher (Str.hpp). Symbolic links are not followed.
+    class FileSearcher {
+    public:
+        /// @brief Receives matches one at a time, never concurrently, so it need not be thread-safe. Return false
+        /// to stop the search; it is not called again afterwards. Matches of one file arrive in order of where
+        /// they end, in batches as the file is scanned, so a large file streams its results; batches of different
+        /// files may interleave. An exception it throws stops the search and is rethrown from Search once every
+        /// search thread has finished.
+        using MatchCallback = std::function<bool(const SearchMatch& match)>;
+
+        /// @brief Searches `root`, a directory or a single file, for any of `patterns`.
+        static SearchStats Search(const Path& root,
+                                  std::span<const strview> patterns,
+                                  const MatchCallback& onMatch,
+                                  const SearchOptions& options = {});
+        static SearchStats Search(const Path& root,
+                                  strview pattern,
+                                  const MatchCallback& onMatch,
+                                  const SearchOptions& options = {});
     };
 }  // namespace x
\ No newline at end of file
@@ -0,0 +1,203 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include "Str.hpp"
+#include <compare>
+#include <functional>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<format>)
+    #include <format>
+#endif
+
+namespace x {
+    /// @brief NUL-terminated string of at most N characters stored inline, for identifiers and keys that should
+    /// live in structs or shared memory without touching the heap.
+    ///
+    /// Trivially copyable, so it can be memcpy'd or placed in a mapped region. Writes that do not fit are truncated
+    /// the way StrCopyTruncate/StrConcatTruncate do it: as much as fits is kept, the result is always terminated,
+    /// and the call reports whether anything was dropped.
+    template<size_t N>
+    class FixedString {
+        static_assert(N > 0, "FixedString needs room for at least one character");
+
+    public:
+        // Smallest integer that can count to N, so short strings stay compact
+        using SizeType = std::conditional_t<N <= 0xFF, u8, std::conditional_t<N <= 0xFFFF, u16, u32>>;
+
+        static constexpr size_t kCapacity = N;
+
+        constexpr FixedString() = default;
+
+        constexpr FixedString(const char* text) {
+            Assign(text);
+        }
+
+        constexpr FixedString(strview text) {
+            Assign(text);
+        }
+
+        /// @brief Replaces the contents. Returns false if `text` had to be truncated. `text` may be a view of this
+        /// string's own contents.
+        constexpr bool Assign(strview text) {
+            mSize = 0;
+            return Append(text);
+        }
+
+        constexpr bool Assign(const char* text) {
+            if (std::is_constant_evaluated() || Aliases(text)) { return Assign(text ? strview(text) : strview()); }
+
+            // Fused scan-and-copy: no separate strlen over `text`
+            mSize = CAST<SizeType>(StrCopyTruncate(mData, N + 1, text));
+            return !text || text[mSize] == '\0';
+        }
+
+        /// @brief Appends as much of `text` as fits. Returns false if it had to be truncated.
+        constexpr bool Append(strview text) {
+            const size_t count = X_MIN(text.size(), N - mSize);
+            if (std::is_constant_evaluated()) {
+                for (size_t i = 0; i < count; ++i) {
+                    mData[mSize + i] = text[i];
+                }
+            } else {
+                // Assign() hands in views of our own buffer, which can overlap the destination
+                std::memmove(mData + mSize, text.data(), count);
+            }
+            mSize += CAST<SizeType>(count);
+            mData[mSize] = '\0';
+            return count == text.size();
+        }
+
+        constexpr bool Append(char c) {
+            if (mSize == N) { return false; }
+            mData[mSize++] = c;
+            mData[mSize]   = '\0';
+            return true;
+        }
+
+        constexpr FixedString& operator+=(strview text) {
+            Append(text);
+            return *this;
+        }
+
+        constexpr FixedString& operator+=(char c) {
+            Append(c);
+            return *this;
+        }
+
+        constexpr void Clear() {
+            mSize    = 0;
+            mData[0] = '\0';
+        }
+
+        /// @brief Shortens the string to `size` characters; does nothing if it is already that short.
+        constexpr void Truncate(size_t size) {
+            if (size >= mSize) { return; }
+            mSize        = CAST<SizeType>(size);
+            mData[mSize] = '\0';
+        }
+
+        X_NODISCARD constexpr size_t Size() const {
+            return mSize;
+        }
+
+        X_NODISCARD constexpr bool Empty() const {
+            return mSize == 0;
+        }
+
+        X_NODISCARD static constexpr size_t Capacity() {
+            return N;
+        }
+
+        X_NODISCARD constexpr const char* CStr() const {
+            return mData;
+        }
+
+        X_NODISCARD constexpr char* Data() {
+            return mData;
+        }
+
+        X_NODISCARD constexpr strview View() const {
+            return {mData, mSize};
+        }
+
+        X_NODISCARD str Str() const {
+            return str(mData, mSize);
+        }
+
+        constexpr operator strview() const {
+            return View();
+        }
+
+        constexpr char& operator[](size_t index) {
+            return mData[index];
+        }
+
+        constexpr const char& operator[](size_t index) const {
+            return mData[index];
+        }
+
+        constexpr const char* begin() const {
+            return mData;
+        }
+
+        constexpr const char* end() const {
+            return mData + mSize;
+        }
+
+        template<size_t M>
+        friend constexpr bool operator==(const FixedString& lhs, const FixedString<M>& rhs) {
+            return lhs.View() == rhs.View();
+        }
+
+        friend constexpr bool operator==(const FixedString& lhs, strview rhs) {
+            return lhs.View() == rhs;
+        }
+
+        template<size_t M>
+        friend constexpr std::strong_ordering operator<=>(const FixedString& lhs, const FixedString<M>& rhs) {
+            return lhs.View() <=> rhs.View();
+        }
+
+        friend constexpr std::strong_ordering operator<=>(const FixedString& lhs, strview rhs) {
+            return lhs.View() <=> rhs;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const FixedString& text) {
+            return os << text.View();
+        }
+
+    private:
+        char mData[N + 1] = {};
+        SizeType mSize    = 0;
+
+        // std::less gives a total order even for pointers into unrelated objects
+        X_NODISCARD bool Aliases(const char* text) const {
+            return text && !std::less<const char*>()(text, mData) && std::less<const char*>()(text, mData + N + 1);
+        }
+    };
+}  // namespace x
+
+template<size_t N>
+struct std::hash<x::FixedString<N>> {
+    size_t operator()(const x::FixedString<N>& text) const noexcept {
+        return std::hash<std::string_view> {}(text.View());
+    }
+};
+
+#if defined(__cpp_lib_format)
+template<size_t N>
+struct std::formatter<x::FixedString<N>> : std::formatter<std::string_view> {
+    template<typename FormatContext>
+    auto format(const x::FixedString<N>& text, FormatContext& ctx) const {
+        return std::formatter<std::string_view>::format(text.View(), ctx);
+    }
+};
+#endif
@@ -0,0 +1,529 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include "IoExecutor.hpp"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace x {
+    template<typename T>
+    class Future;
+
+    template<typename T>
+    class Promise;
+
+    /// @brief What an Async() task does when its Future was dropped before the task started.
+    enum class AbandonPolicy : u8 {
+        Run,   // Side effects matter (writes), always run
+        Skip,  // Nobody can observe the result (reads), resolve with a default value instead
+    };
+
+    template<typename T>
+    struct WhenAnyResult {
+        size_t index;
+        T value;
+    };
+
+    namespace detail {
+        template<typename T>
+        using FutureStorage = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        /// @brief Shared state between a producer and a single Future.
+        ///
+        /// Completion, waiting and continuation hand-off all go through one atomic word, so there is no mutex or
+        /// condition variable. Waiters park on the word with atomic wait/notify, and the notify is skipped
+        /// entirely when nobody is blocked. The state is reference counted intrusively; whoever publishes the
+        /// result holds a reference until Publish() returns.
+        class FutureStateBase {
+        public:
+            using Callback = void (*)(void* context);
+
+            static constexpr u32 kReady        = X_BIT(0);
+            static constexpr u32 kContinuation = X_BIT(1);
+            static constexpr u32 kWaiting      = X_BIT(2);
+            static constexpr u32 kAbandoned    = X_BIT(3);
+
+            explicit FutureStateBase(u32 refs) : mRefs(refs) {}
+            virtual ~FutureStateBase() = default;
+
+            FutureStateBase(const FutureStateBase&)            = delete;
+            FutureStateBase& operator=(const FutureStateBase&) = delete;
+
+            void AddRef() {
+                mRefs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void Release() {
+                if (mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) { delete this; }
+            }
+
+            X_NODISCARD bool IsReady() const {
+                return (mFlags.load(std::memory_order_acquire) & kReady) != 0;
+            }
+
+            X_NODISCARD bool IsAbandoned() const {
+                return (mFlags.load(std::memory_order_relaxed) & kAbandoned) != 0;
+            }
+
+            void Abandon() {
+                mFlags.fetch_or(kAbandoned, std::memory_order_relaxed);
+            }
+
+            void Wait() {
+                u32 flags = mFlags.load(std::memory_order_acquire);
+                while (!(flags & kReady)) {
+                    if (!(flags & kWaiting)) {
+                        flags = mFlags.fetch_or(kWaiting, std::memory_order_acq_rel) | kWaiting;
+                        continue;
+                    }
+                    mFlags.wait(flags, std::memory_order_acquire);
+                    flags = mFlags.load(std::memory_order_acquire);
+                }
+            }
+
+            /// Runs `callback(context)` once the result is published, immediately if it already is. A state
+            /// supports a single continuation.
+            void OnReady(Callback callback, void* context) {
+                mCallback      = callback;
+                mContext       = context;
+                const u32 prev = mFlags.fetch_or(kContinuation, std::memory_order_acq_rel);
+                if (prev & kReady) { callback(context); }
+            }
+
+            void SetException(std::exception_ptr exception) {
+                mException = std::move(exception);
+                Publish();
+            }
+
+        protected:
+            void Publish() {
+                const u32 prev = mFlags.fetch_or(kReady, std::memory_order_acq_rel);
+                if (prev & kContinuation) { mCallback(mContext); }
+                if (prev & kWaiting) { mFlags.notify_all(); }
+            }
+
+            void RethrowIfFailed() const {
+                if (mException) { std::rethrow_exception(mException); }
+            }
+
+        private:
+            std::atomic<u32> mFlags {0};
+            std::atomic<u32> mRefs;
+            Callback mCallback = nullptr;
+            void* mContext     = nullptr;
+            std::exception_ptr mException;
+        };
+
+        template<typename T>
+        class FutureState : public FutureStateBase {
+        public:
+            using FutureStateBase::FutureStateBase;
+
+            template<typename... Args>
+            void SetValue(Args&&... args) {
+                mValue.emplace(std::forward<Args>(args)...);
+                Publish();
+            }
+
+            /// Moves the result out, rethrowing the stored exception if the producer failed
+            FutureStorage<T> Take() {
+                RethrowIfFailed();
+                return std::move(*mValue);
+            }
+
+        private:
+            std::optional<FutureStorage<T>> mValue;
+        };
+
+        template<typename R, typename F, typename... Args>
+        void InvokeInto(FutureState<R>& state, F& func, Args&&... args) {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    std::invoke(func, std::forward<Args>(args)...);
+                    state.SetValue();
+                } else {
+                    state.SetValue(std::invoke(func, std::forward<Args>(args)...));
+                }
+            } catch (...) { state.SetException(std::current_exception()); }
+        }
+
+        /// Function and result of an Async() call in one allocation, handed to the executor by pointer
+        template<typename F, typename R, AbandonPolicy Policy>
+        class AsyncState final : public FutureState<R> {
+        public:
+            explicit AsyncState(F&& func) : FutureState<R>(2), mFunc(std::move(func)) {}
+
+            static void Run(void* context) noexcept {
+                auto* self = CAST<AsyncState*>(context);
+                if constexpr (Policy == AbandonPolicy::Skip && std::is_default_constructible_v<FutureStorage<R>>) {
+                    if (self->IsAbandoned()) {
+                        self->SetValue();
+                        self->Release();
+                        return;
+                    }
+                }
+                InvokeInto<R>(*self, self->mFunc);
+                self->Release();
+            }
+
+        private:
+            F mFunc;
+        };
+
+        template<typename T, typename F>
+        using ThenResult = std::conditional_t<std::is_void_v<T>, std::invoke_result<F>, std::invoke_result<F, T>>;
+
+        /// Continuation of `Upstream`; runs `F` on the executor once the upstream state is ready
+        template<typename T, typename F>
+        class ThenState final : public FutureState<typename ThenResult<T, F>::type> {
+        public:
+            using R = typename ThenResult<T, F>::type;
+
+            ThenState(FutureState<T>* upstream, F&& func, IoExecutor& executor, IoPriority priority)
+                : FutureState<R>(2), mUpstream(upstream), mFunc(std::move(func)), mExecutor(executor),
+                  mPriority(priority) {}
+
+            static void OnUpstreamReady(void* context) {
+                auto* self = CAST<ThenState*>(context);
+                self->mExecutor.Submit(self->mPriority, &Run, self);
+            }
+
+        private:
+            FutureState<T>* mUpstream;
+            F mFunc;
+            IoExecutor& mExecutor;
+            IoPriority mPriority;
+
+            static void Run(void* context) noexcept {
+                auto* self = CAST<ThenState*>(context);
+                try {
+                    if constexpr (std::is_void_v<T>) {
+                        self->mUpstream->Take();
+                        InvokeInto<R>(*self, self->mFunc);
+                    } else {
+                        InvokeInto<R>(*self, self->mFunc, self->mUpstream->Take());
+                    }
+                } catch (...) { self->SetException(std::current_exception()); }
+                self->mUpstream->Release();
+                self->Release();
+            }
+        };
+
+        template<typename T>
+        class WhenAllState final : public FutureState<vector<T>> {
+        public:
+            explicit WhenAllState(vector<FutureState<T>*>&& inputs)
+                : FutureState<vector<T>>(CAST<u32>(inputs.size()) + 1), mInputs(std::move(inputs)),
+                  mResults(mInputs.size()), mSlots(mInputs.size()), mRemaining(mInputs.size()) {}
+
+            void Start() {
+                if (mInputs.empty()) {
+                    this->SetValue();
+                    return;
+                }
+                for (size_t i = 0; i < mInputs.size(); ++i) {
+                    mSlots[i] = {this, i};
+                    mInputs[i]->OnReady(&OnInputReady, &mSlots[i]);
+                }
+            }
+
+        private:
+            struct Slot {
+                WhenAllState* owner;
+                size_t index;
+            };
+
+            vector<FutureState<T>*> mInputs;
+            vector<std::optional<T>> mResults;
+            vector<Slot> mSlots;
+            std::atomic<size_t> mRemaining;
+            std::atomic<bool> mFailed {false};
+
+            // Runs inline on whichever thread completed the input; only moves the value into its slot
+            static void OnInputReady(void* context) {
+                const auto* slot = CAST<Slot*>(context);
+                auto* self       = slot->owner;
+                auto* input      = self->mInputs[slot->index];
+                try {
+                    self->mResults[slot->index].emplace(input->Take());
+                } catch (...) {
+                    if (!self->mFailed.exchange(true, std::memory_order_acq_rel)) {
+                        self->SetException(std::current_exception());
+                    }
+                }
+                input->Release();
+
+                if (self->mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+                    !self->mFailed.load(std::memory_order_acquire)) {
+                    vector<T> values;
+                    values.reserve(self->mResults.size());
+                    for (auto& result : self->mResults) {
+                        values.push_back(std::move(*result));
+                    }
+                    self->SetValue(std::move(values));
+                }
+                self->Release();
+            }
+        };
+
+        template<typename T>
+        class WhenAnyState final : public FutureState<WhenAnyResult<T>> {
+        public:
+            explicit WhenAnyState(vector<FutureState<T>*>&& inputs)
+                : FutureState<WhenAnyResult<T>>(CAST<u32>(inputs.size()) + 1), mInputs(std::move(inputs)),
+                  mSlots(mInputs.size()) {}
+
+            void Start() {
+                for (size_t i = 0; i < mInputs.size(); ++i) {
+                    mSlots[i] = {this, i};
+                    mInputs[i]->OnReady(&OnInputReady, &mSlots[i]);
+                }
+            }
+
+        private:
+            struct Slot {
+                WhenAnyState* owner;
+                size_t index;
+            };
+
+            vector<FutureState<T>*> mInputs;
+            vector<Slot> mSlots;
+            std::atomic<bool> mDone {false};
+
+            static void OnInputReady(void* context) {
+                const auto* slot = CAST<Slot*>(context);
+                auto* self       = slot->owner;
+                auto* input      = self->mInputs[slot->index];
+                if (!self->mDone.exchange(true, std::memory_order_acq_rel)) {
+                    try {
+                        self->SetValue(WhenAnyResult<T> {slot->index, input->Take()});
+                    } catch (...) { self->SetException(std::current_exception()); }
+                }
+                input->Release();
+                self->Release();
+            }
+        };
+    }  // namespace detail
+
+    /// @brief Move-only handle to a value produced asynchronously.
+    ///
+    /// Unlike std::future it supports continuations: Then() schedules a function on an IoExecutor once the value
+    /// is ready instead of blocking a thread on Get(). Dropping a Future that is not ready marks its work as
+    /// abandoned, which lets queued reads skip the I/O entirely.
+    template<typename T>
+    class Future {
+    public:
+        using ValueType = T;
+
+        Future() = default;
+
+        /// Adopts one reference to `state`
+        explicit Future(detail::FutureState<T>* state) : mState(state) {}
+
+        ~Future() {
+            Reset();
+        }
+
+        Future(const Future&)            = delete;
+        Future& operator=(const Future&) = delete;
+
+        Future(Future&& other) noexcept : mState(std::exchange(other.mState, nullptr)) {}
+
+        Future& operator=(Future&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                mState = std::exchange(other.mState, nullptr);
+            }
+            return *this;
+        }
+
+        X_NODISCARD bool Valid() const {
+            return mState != nullptr;
+        }
+
+        X_NODISCARD bool IsReady() const {
+            return mState && mState->IsReady();
+        }
+
+        void Wait() const {
+            if (mState) { mState->Wait(); }
+        }
+
+        /// @brief Blocks until the value is ready and moves it out. The Future is invalid afterwards.
+        T Get() {
+            X_ASSERT(mState);
+            mState->Wait();
+            auto* state = std::exchange(mState, nullptr);
+            struct ReleaseGuard {
+                detail::FutureState<T>* state;
+                ~ReleaseGuard() {
+                    state->Release();
+                }
+            } guard {state};
+            if constexpr (std::is_void_v<T>) {
+                state->Take();
+            } else {
+                return state->Take();
+            }
+        }
+
+        /// @brief Runs `func(value)` on `executor` once this Future is ready. Exceptions skip `func` and propagate
+        /// to the returned Future. Consumes this Future.
+        template<typename F>
+        auto Then(IoExecutor& executor, IoPriority priority, F&& func)
+          -> Future<typename detail::ThenResult<T, std::decay_t<F>>::type> {
+            using State = detail::ThenState<T, std::decay_t<F>>;
+            X_ASSERT(mState);
+            auto* upstream = std::exchange(mState, nullptr);
+            auto* state    = new State(upstream, std::decay_t<F>(std::forward<F>(func)), executor, priority);
+            Future<typename State::R> result(state);
+            upstream->OnReady(&State::OnUpstreamReady, state);
+            return result;
+        }
+
+        template<typename F>
+        auto Then(F&& func, IoPriority priority = IoPriority::Normal) {
+            return Then(IoExecutor::Default(), priority, std::forward<F>(func));
+        }
+
+    private:
+        template<typename>
+        friend class Future;
+
+        template<typename U>
+        friend Future<vector<U>> WhenAll(vector<Future<U>> futures);
+
+        template<typename U>
+        friend Future<WhenAnyResult<U>> WhenAny(vector<Future<U>> futures);
+
+        detail::FutureState<T>* mState = nullptr;
+
+        detail::FutureState<T>* Detach() {
+            return std::exchange(mState, nullptr);
+        }
+
+        void Reset() {
+            if (!mState) { return; }
+            if (!mState->IsReady()) { mState->Abandon(); }
+            std::exchange(mState, nullptr)->Release();
+        }
+    };
+
+    /// @brief Producer side of a Future, for results that are not computed by Async().
+    template<typename T>
+    class Promise {
+    public:
+        Promise() : mState(new detail::FutureState<T>(2)) {}
+
+        ~Promise() {
+            if (!mState) { return; }
+            if (!mSatisfied) {
+                mState->SetException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            }
+            if (!mRetrieved) { mState->Release(); }
+            mState->Release();
+        }
+
+        Promise(const Promise&)            = delete;
+        Promise& operator=(const Promise&) = delete;
+
+        Promise(Promise&& other) noexcept
+            : mState(std::exchange(other.mState, nullptr)), mRetrieved(other.mRetrieved),
+              mSatisfied(other.mSatisfied) {}
+
+        Promise& operator=(Promise&&) = delete;
+
+        /// @brief Returns the Future for this promise. May only be called once.
+        Future<T> GetFuture() {
+            X_ASSERT(!mRetrieved);
+            mRetrieved = true;
+            return Future<T>(mState);
+        }
+
+        template<typename... Args>
+        void SetValue(Args&&... args) {
+            X_ASSERT(!mSatisfied);
+            mSatisfied = true;
+            mState->SetValue(std::forward<Args>(args)...);
+        }
+
+        void SetException(std::exception_ptr exception) {
+            X_ASSERT(!mSatisfied);
+            mSatisfied = true;
+            mState->SetException(std::move(exception));
+        }
+
+        /// @brief True once the Future has been dropped without the value being ready.
+        X_NODISCARD bool IsAbandoned() const {
+            return mState->IsAbandoned();
+        }
+
+    private:
+        detail::FutureState<T>* mState;
+        bool mRetrieved = false;
+        bool mSatisfied = false;
+    };
+
+    /// @brief Runs `func` on `executor` and returns its result as a Future. The function and the result share a
+    /// single allocation and reach the executor without going through std::function.
+    template<AbandonPolicy Policy = AbandonPolicy::Run, typename F>
+    auto Async(IoExecutor& executor, IoPriority priority, F&& func) -> Future<std::invoke_result_t<std::decay_t<F>>> {
+        using R     = std::invoke_result_t<std::decay_t<F>>;
+        using State = detail::AsyncState<std::decay_t<F>, R, Policy>;
+        auto* state = new State(std::decay_t<F>(std::forward<F>(func)));
+        executor.Submit(priority, &State::Run, state);
+        return Future<R>(state);
+    }
+
+    template<typename T>
+    Future<std::decay_t<T>> MakeReadyFuture(T&& value) {
+        auto* state = new detail::FutureState<std::decay_t<T>>(1);
+        state->SetValue(std::forward<T>(value));
+        return Future<std::decay_t<T>>(state);
+    }
+
+    /// @brief Resolves once every input is ready, with the values in input order. The first failure wins.
+    template<typename T>
+    Future<vector<T>> WhenAll(vector<Future<T>> futures) {
+        static_assert(!std::is_void_v<T>, "WhenAll requires futures that produce a value");
+        vector<detail::FutureState<T>*> inputs;
+        inputs.reserve(futures.size());
+        for (auto& future : futures) {
+            X_ASSERT(future.Valid());
+            inputs.push_back(future.Detach());
+        }
+        auto* state = new detail::WhenAllState<T>(std::move(inputs));
+        Future<vector<T>> result(state);
+        state->Start();
+        return result;
+    }
+
+    /// @brief Resolves with the index and value of the first input to become ready. The remaining inputs keep
+    /// running; their results are discarded.
+    template<typename T>
+    Future<WhenAnyResult<T>> WhenAny(vector<Future<T>> futures) {
+        static_assert(!std::is_void_v<T>, "WhenAny requires futures that produce a value");
+        X_ASSERT(!futures.empty());
+        vector<detail::FutureState<T>*> inputs;
+        inputs.reserve(futures.size());
+        for (auto& future : futures) {
+            X_ASSERT(future.Valid());
+            inputs.push_back(future.Detach());
+        }
+        auto* state = new detail::WhenAnyState<T>(std::move(inputs));
+        Future<WhenAnyResult<T>> result(state);
+        state->Start();
+        return result;
+    }
+}  // namespace x
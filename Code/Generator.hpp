@@ -0,0 +1,139 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace x {
+    /// @brief Lazy sequence produced by a coroutine that `co_yield`s values of type T.
+    ///
+    /// A move-only, single-pass view, so it composes with the standard range adaptors:
+    ///
+    ///     for (auto line : FileReader::StreamLines(path) | std::views::filter(NotEmpty)) { ... }
+    ///
+    /// Nothing runs until the first begin(). A yielded value is only guaranteed to live until the iterator is
+    /// advanced; for view types such as std::string_view that usually means it points into the coroutine's own
+    /// buffer, so copy it if it must outlive the step.
+    template<typename T>
+    class Generator : public std::ranges::view_interface<Generator<T>> {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference  = std::conditional_t<std::is_reference_v<T>, T, const T&>;
+
+        struct promise_type {
+            std::add_pointer_t<reference> value = nullptr;
+            std::exception_ptr exception;
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            // A temporary yielded here lives until the end of the co_yield expression, which spans the suspension
+            std::suspend_always yield_value(reference yielded) noexcept {
+                value = std::addressof(yielded);
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() {
+                exception = std::current_exception();
+            }
+
+            // Generators only yield; awaiting inside one is a mistake
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        class Iterator {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = Generator::value_type;
+            using difference_type  = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            reference operator*() const {
+                return static_cast<reference>(*mHandle.promise().value);
+            }
+
+            Iterator& operator++() {
+                Generator::Resume(mHandle);
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            friend bool operator==(const Iterator& it, std::default_sentinel_t) {
+                return !it.mHandle || it.mHandle.done();
+            }
+
+        private:
+            friend class Generator;
+            explicit Iterator(Handle handle) : mHandle(handle) {}
+
+            Handle mHandle;
+        };
+
+        Generator() = default;
+
+        ~Generator() {
+            if (mHandle) { mHandle.destroy(); }
+        }
+
+        Generator(const Generator&)            = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        Generator(Generator&& other) noexcept : mHandle(std::exchange(other.mHandle, {})) {}
+
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (mHandle) { mHandle.destroy(); }
+                mHandle = std::exchange(other.mHandle, {});
+            }
+            return *this;
+        }
+
+        /// @brief Runs the coroutine to its first value. May only be called once.
+        Iterator begin() {
+            if (mHandle) { Resume(mHandle); }
+            return Iterator(mHandle);
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return {};
+        }
+
+    private:
+        Handle mHandle;
+
+        explicit Generator(Handle handle) : mHandle(handle) {}
+
+        static void Resume(Handle handle) {
+            handle.resume();
+            if (auto& exception = handle.promise().exception) { std::rethrow_exception(std::exchange(exception, {})); }
+        }
+    };
+}  // namespace x
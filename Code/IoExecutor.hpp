@@ -0,0 +1,233 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace x {
+    enum class IoPriority : u8 {
+        Interactive,  // Someone is waiting on the result right now
+        Normal,
+        Background,  // Bulk work that should never delay the other lanes
+        Count,
+    };
+
+    /// @brief Cheap, copyable view of a CancellationSource. A default-constructed token is never cancelled.
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+
+        X_NODISCARD bool IsCancelled() const {
+            return mFlag && mFlag->load(std::memory_order_relaxed);
+        }
+
+        X_NODISCARD bool CanBeCancelled() const {
+            return mFlag != nullptr;
+        }
+
+    private:
+        friend class CancellationSource;
+        explicit CancellationToken(shared_ptr<std::atomic<bool>> flag) : mFlag(std::move(flag)) {}
+
+        shared_ptr<std::atomic<bool>> mFlag;
+    };
+
+    /// @brief Owner side of a cancellation flag. Cancellation is cooperative: operations poll their token between
+    /// chunks and give up at the next check.
+    class CancellationSource {
+    public:
+        CancellationSource() : mFlag(make_shared<std::atomic<bool>>(false)) {}
+
+        void Cancel() {
+            mFlag->store(true, std::memory_order_relaxed);
+        }
+
+        X_NODISCARD bool IsCancelled() const {
+            return mFlag->load(std::memory_order_relaxed);
+        }
+
+        X_NODISCARD CancellationToken Token() const {
+            return CancellationToken(mFlag);
+        }
+
+    private:
+        shared_ptr<std::atomic<bool>> mFlag;
+    };
+
+    /// @brief Scheduling options accepted by every AsyncFileReader/AsyncFileWriter call.
+    struct AsyncOptions {
+        using Clock = std::chrono::steady_clock;
+
+        IoPriority priority = IoPriority::Normal;
+        CancellationToken token;
+        /// Work still queued past its deadline is dropped; work already running stops at its next chunk
+        Clock::time_point deadline = Clock::time_point::max();
+
+        static AsyncOptions WithPriority(IoPriority priority) {
+            AsyncOptions options;
+            options.priority = priority;
+            return options;
+        }
+
+        AsyncOptions& Timeout(Clock::duration timeout) {
+            deadline = Clock::now() + timeout;
+            return *this;
+        }
+
+        X_NODISCARD bool ShouldStop() const {
+            return token.IsCancelled() || (deadline != Clock::time_point::max() && Clock::now() >= deadline);
+        }
+    };
+
+    /// @brief Fixed worker pool behind the async file APIs, with one queue per IoPriority.
+    ///
+    /// Workers always take from the highest-priority non-empty lane. Background work is additionally capped to a
+    /// fraction of the workers so a flood of long background jobs cannot occupy every thread and delay an
+    /// interactive request that arrives later.
+    class IoExecutor {
+    public:
+        using Task = std::function<void()>;
+
+        /// Type-erased unit of work. Futures submit these directly so scheduling does not allocate.
+        struct Job {
+            void (*invoke)(void* context) noexcept;
+            void* context;
+        };
+
+        explicit IoExecutor(u32 threadCount = DefaultThreadCount()) {
+            threadCount      = X_MAX(threadCount, 1u);
+            mBackgroundLimit = X_MAX(threadCount / 4, 1u);
+            mWorkers.reserve(threadCount);
+            for (u32 i = 0; i < threadCount; ++i) {
+                mWorkers.emplace_back([this]() { WorkerLoop(); });
+            }
+        }
+
+        /// Finishes everything already queued, then joins the workers.
+        ~IoExecutor() {
+            {
+                std::lock_guard lock(mMutex);
+                mStopping = true;
+            }
+            mCondition.notify_all();
+            for (auto& worker : mWorkers) {
+                worker.join();
+            }
+        }
+
+        IoExecutor(const IoExecutor&)            = delete;
+        IoExecutor& operator=(const IoExecutor&) = delete;
+
+        /// @brief Queues `invoke(context)`. Nothing waits on a job to receive its exception, so `invoke` must be
+        /// noexcept and store failures itself, the way Future states do.
+        void Submit(IoPriority priority, void (*invoke)(void* context) noexcept, void* context) {
+            {
+                std::lock_guard lock(mMutex);
+                mLanes[CAST<size_t>(priority)].push_back({invoke, context});
+            }
+            mCondition.notify_one();
+        }
+
+        /// @brief Queues a fire-and-forget task. A task that throws terminates the process at the throw instead of
+        /// unwinding through a worker and leaving the pool's bookkeeping inconsistent; use Async() to get failures
+        /// back as a Future.
+        void Submit(IoPriority priority, Task task) {
+            Submit(
+              priority,
+              [](void* context) noexcept {
+                  const std::unique_ptr<Task> owned(CAST<Task*>(context));
+                  (*owned)();
+              },
+              new Task(std::move(task)));
+        }
+
+        X_NODISCARD size_t Pending(IoPriority priority) const {
+            std::lock_guard lock(mMutex);
+            return mLanes[CAST<size_t>(priority)].size();
+        }
+
+        X_NODISCARD u32 ThreadCount() const {
+            return CAST<u32>(mWorkers.size());
+        }
+
+        /// @brief Executor used by AsyncFileReader and AsyncFileWriter.
+        static IoExecutor& Default() {
+            // Leaked on purpose: joining at static destruction could block exit behind throttled background writes
+            static auto* executor = new IoExecutor();
+            return *executor;
+        }
+
+        static u32 DefaultThreadCount() {
+            // File I/O mostly blocks, so oversubscribe the cores a little
+            return X_CLAMP(std::thread::hardware_concurrency(), 4u, 32u);
+        }
+
+    private:
+        static constexpr size_t kLaneCount = CAST<size_t>(IoPriority::Count);
+
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        array<std::deque<Job>, kLaneCount> mLanes;
+        vector<std::thread> mWorkers;
+        u32 mBackgroundLimit   = 1;
+        u32 mBackgroundRunning = 0;
+        bool mStopping         = false;
+
+        /// Lane to run next, or kLaneCount if nothing is runnable. Caller holds mMutex.
+        X_NODISCARD size_t NextLane() const {
+            for (size_t lane = 0; lane < kLaneCount; ++lane) {
+                if (mLanes[lane].empty()) { continue; }
+                if (lane == CAST<size_t>(IoPriority::Background) && mBackgroundRunning >= mBackgroundLimit) {
+                    continue;
+                }
+                return lane;
+            }
+            return kLaneCount;
+        }
+
+        void WorkerLoop() {
+            constexpr auto kBackground = CAST<size_t>(IoPriority::Background);
+
+            std::unique_lock lock(mMutex);
+            for (;;) {
+                mCondition.wait(lock, [this]() {
+                    return NextLane() != kLaneCount || (mStopping && AllLanesEmpty());
+                });
+
+                const size_t lane = NextLane();
+                if (lane == kLaneCount) { return; }
+
+                const Job job = mLanes[lane].front();
+                mLanes[lane].pop_front();
+                if (lane == kBackground) { ++mBackgroundRunning; }
+
+                lock.unlock();
+                job.invoke(job.context);
+                lock.lock();
+
+                if (lane == kBackground) {
+                    --mBackgroundRunning;
+                    // A background slot opened up; a worker may be waiting on it
+                    if (!mLanes[kBackground].empty()) { mCondition.notify_one(); }
+                }
+            }
+        }
+
+        X_NODISCARD bool AllLanesEmpty() const {
+            for (const auto& lane : mLanes) {
+                if (!lane.empty()) { return false; }
+            }
+            return true;
+        }
+    };
+}  // namespace x
@@ -0,0 +1,149 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace x {
+    /// @brief Token bucket limiting both bandwidth (bytes/sec) and IOPS (ops/sec).
+    ///
+    /// Callers may take more than the bucket holds; the bucket then goes into debt and later callers wait until it
+    /// is paid back. That keeps the long-run rate exact without ever rejecting a large request. A rate of 0 means
+    /// that dimension is unlimited.
+    ///
+    /// A limiter can be attached to a single StreamWriter, or shared by several users (AsyncFileWriter,
+    /// CopyDirectory, other StreamWriters) so they are paced as one class of traffic. Shared(name) returns a
+    /// process-wide limiter for a named class.
+    class IoRateLimiter {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using NowFn = Clock::time_point (*)();
+
+        /// @param bytesPerSecond Sustained bandwidth, 0 for unlimited
+        /// @param opsPerSecond Sustained operations per second, 0 for unlimited
+        /// @param burstBytes Bucket size in bytes, defaults to one second of bandwidth
+        /// @param burstOps Bucket size in operations, defaults to one second of operations
+        explicit IoRateLimiter(u64 bytesPerSecond = 0, u64 opsPerSecond = 0, u64 burstBytes = 0, u64 burstOps = 0) {
+            SetRates(bytesPerSecond, opsPerSecond, burstBytes, burstOps);
+        }
+
+        IoRateLimiter(const IoRateLimiter&)            = delete;
+        IoRateLimiter& operator=(const IoRateLimiter&) = delete;
+
+        /// @brief Reconfigures the limiter. The bucket starts full at the new burst sizes.
+        void SetRates(u64 bytesPerSecond, u64 opsPerSecond = 0, u64 burstBytes = 0, u64 burstOps = 0) {
+            std::lock_guard lock(mMutex);
+            mBytesPerSecond = CAST<f64>(bytesPerSecond);
+            mOpsPerSecond   = CAST<f64>(opsPerSecond);
+            mBurstBytes     = CAST<f64>(burstBytes ? burstBytes : bytesPerSecond);
+            mBurstOps       = CAST<f64>(burstOps ? burstOps : opsPerSecond);
+            mBytes          = mBurstBytes;
+            mOps            = mBurstOps;
+            mLastRefill     = mNow();
+        }
+
+        /// @brief Replaces the time source used for refills, so tests can drive the bucket with a fake clock.
+        /// Reserve() and TryAcquire() never sleep, so they are fully deterministic under one.
+        void SetClock(NowFn now) {
+            std::lock_guard lock(mMutex);
+            mNow        = now ? now : &Clock::now;
+            mLastRefill = mNow();
+        }
+
+        /// @brief Blocks until `bytes` and `ops` may proceed.
+        void Acquire(u64 bytes, u64 ops = 1) {
+            const auto wait = Reserve(bytes, ops);
+            if (wait > Clock::duration::zero()) { std::this_thread::sleep_for(wait); }
+        }
+
+        /// @brief Takes the tokens only if they are available right now.
+        bool TryAcquire(u64 bytes, u64 ops = 1) {
+            std::lock_guard lock(mMutex);
+            Refill();
+            if ((mBytesPerSecond > 0 && mBytes < CAST<f64>(bytes)) || (mOpsPerSecond > 0 && mOps < CAST<f64>(ops))) {
+                return false;
+            }
+            Take(bytes, ops);
+            return true;
+        }
+
+        /// @brief Takes the tokens unconditionally and returns how long the caller must wait before doing the I/O.
+        X_NODISCARD Clock::duration Reserve(u64 bytes, u64 ops = 1) {
+            std::lock_guard lock(mMutex);
+            Refill();
+            Take(bytes, ops);
+
+            f64 seconds = 0.0;
+            if (mBytesPerSecond > 0 && mBytes < 0) { seconds = -mBytes / mBytesPerSecond; }
+            if (mOpsPerSecond > 0 && mOps < 0) { seconds = X_MAX(seconds, -mOps / mOpsPerSecond); }
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<f64>(seconds));
+        }
+
+        /// @brief Returns tokens taken by Reserve() for I/O that was abandoned before it ran, such as a transfer
+        /// cancelled while it waited. The bucket refills no higher than its burst size.
+        void Release(u64 bytes, u64 ops = 1) {
+            std::lock_guard lock(mMutex);
+            Refill();
+            if (mBytesPerSecond > 0) { mBytes = X_MIN(mBurstBytes, mBytes + CAST<f64>(bytes)); }
+            if (mOpsPerSecond > 0) { mOps = X_MIN(mBurstOps, mOps + CAST<f64>(ops)); }
+        }
+
+        /// @brief Largest single I/O a paced caller should issue, so one request never consumes more than the
+        /// configured burst.
+        X_NODISCARD size_t ChunkSize() const {
+            std::lock_guard lock(mMutex);
+            if (mBurstBytes <= 0) { return kMaxChunkSize; }
+            return X_CLAMP(CAST<size_t>(mBurstBytes), kMinChunkSize, kMaxChunkSize);
+        }
+
+        X_NODISCARD bool IsUnlimited() const {
+            std::lock_guard lock(mMutex);
+            return mBytesPerSecond <= 0 && mOpsPerSecond <= 0;
+        }
+
+        /// @brief Returns the process-wide limiter for the traffic class `name`, creating an unlimited one on first
+        /// use. Configure it with SetRates().
+        static shared_ptr<IoRateLimiter> Shared(const str& name) {
+            static std::mutex mutex;
+            static unordered_map<str, shared_ptr<IoRateLimiter>> classes;
+
+            std::lock_guard lock(mutex);
+            auto& limiter = classes[name];
+            if (!limiter) { limiter = make_shared<IoRateLimiter>(); }
+            return limiter;
+        }
+
+    private:
+        static constexpr size_t kMinChunkSize = 4_KILOBYTES;
+        static constexpr size_t kMaxChunkSize = 1_MEGABYTES;
+
+        mutable std::mutex mMutex;
+        f64 mBytesPerSecond = 0;
+        f64 mOpsPerSecond   = 0;
+        f64 mBurstBytes     = 0;
+        f64 mBurstOps       = 0;
+        f64 mBytes          = 0;
+        f64 mOps            = 0;
+        NowFn mNow          = &Clock::now;
+        Clock::time_point mLastRefill;
+
+        void Refill() {
+            const auto now    = mNow();
+            const f64 elapsed = std::chrono::duration<f64>(now - mLastRefill).count();
+            mLastRefill       = now;
+            mBytes            = X_MIN(mBurstBytes, mBytes + elapsed * mBytesPerSecond);
+            mOps              = X_MIN(mBurstOps, mOps + elapsed * mOpsPerSecond);
+        }
+
+        void Take(u64 bytes, u64 ops) {
+            if (mBytesPerSecond > 0) { mBytes -= CAST<f64>(bytes); }
+            if (mOpsPerSecond > 0) { mOps -= CAST<f64>(ops); }
+        }
+    };
+}  // namespace x
@@ -0,0 +1,490 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Opt-in I/O instrumentation for the Filesystem utilities. Define X_ENABLE_IO_STATS (for every translation unit,
+// including Filesystem.cpp) to record per-operation counts, bytes and latency histograms. Without it the
+// X_IO_* hooks expand to nothing and the Filesystem code carries no instrumentation at all.
+//
+// Each thread records into its own shard, so the hot path is a handful of uncontended relaxed atomics. Shards
+// are only merged when IoStats::Snapshot() is called.
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace x {
+    enum class IoOp : u8 {
+        ReadBytes,
+        ReadText,
+        ReadLines,
+        ReadBlock,
+        QueryFileSize,
+        WriteBytes,
+        WriteText,
+        WriteLines,
+        WriteBlock,
+        StreamRead,
+        StreamReadLine,
+        StreamWrite,
+        StreamWriteLine,
+        StreamFlush,
+        StreamReadUntil,
+        RecordRead,
+        BulkLoad,
+        BulkWrite,
+        CsvRead,
+        MapFile,
+        SearchFile,
+        Count,
+    };
+
+    inline constexpr size_t kIoOpCount = CAST<size_t>(IoOp::Count);
+
+    inline constexpr cstr IoOpName(IoOp op) {
+        constexpr cstr names[] = {
+          "FileReader::ReadBytes",
+          "FileReader::ReadText",
+          "FileReader::ReadLines",
+          "FileReader::ReadBlock",
+          "FileReader::QueryFileSize",
+          "FileWriter::WriteBytes",
+          "FileWriter::WriteText",
+          "FileWriter::WriteLines",
+          "FileWriter::WriteBlock",
+          "StreamReader::Read",
+          "StreamReader::ReadLine",
+          "StreamWriter::Write",
+          "StreamWriter::WriteLine",
+          "StreamWriter::Flush",
+          "StreamReader::ReadUntil",
+          "RecordReader::Fill",
+          "BulkLoader::Load",
+          "BulkWriter::Write",
+          "CsvReader::Advance",
+          "MappedFile::Open",
+          "FileSearcher::SearchFile",
+        };
+        return op < IoOp::Count ? names[CAST<size_t>(op)] : "Unknown";
+    }
+
+    /// @brief Log-linear latency histogram.
+    ///
+    /// Values below 8 get exact buckets; above that every power of two is split into 8 linear sub-buckets,
+    /// giving a worst-case relative error of 12.5%. Values are clamped at 2^40 ns (~18 minutes).
+    class IoHistogram {
+    public:
+        static constexpr u32 kSubBucketBits  = 3;
+        static constexpr u32 kSubBucketCount = 1u << kSubBucketBits;
+        static constexpr u32 kMaxExponent    = 39;
+        static constexpr u32 kBucketCount    = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+        static constexpr u32 BucketIndex(u64 value) {
+            if (value < kSubBucketCount) { return CAST<u32>(value); }
+            u32 exponent = 63 - CAST<u32>(std::countl_zero(value));
+            if (exponent > kMaxExponent) {
+                exponent = kMaxExponent;
+                value    = (u64(2) << kMaxExponent) - 1;
+            }
+            const u32 shift    = exponent - kSubBucketBits;
+            const u32 mantissa = CAST<u32>(value >> shift) & (kSubBucketCount - 1);
+            return (shift + 1) * kSubBucketCount + mantissa;
+        }
+
+        /// Highest value that maps to `index`
+        static constexpr u64 BucketUpperBound(u32 index) {
+            if (index < kSubBucketCount) { return index; }
+            const u32 shift    = index / kSubBucketCount - 1;
+            const u64 mantissa = kSubBucketCount + index % kSubBucketCount;
+            return ((mantissa + 1) << shift) - 1;
+        }
+
+        void Record(u64 value, u64 count = 1) {
+            mBuckets[BucketIndex(value)] += count;
+        }
+
+        void AddBucket(u32 index, u64 count) {
+            mBuckets[index] += count;
+        }
+
+        void Merge(const IoHistogram& other) {
+            for (u32 i = 0; i < kBucketCount; ++i) {
+                mBuckets[i] += other.mBuckets[i];
+            }
+        }
+
+        X_NODISCARD u64 Count() const {
+            u64 total = 0;
+            for (const auto bucket : mBuckets) {
+                total += bucket;
+            }
+            return total;
+        }
+
+        /// @brief Returns the value at percentile `p` (0-100), rounded up to its bucket's upper bound.
+        X_NODISCARD u64 Percentile(f64 p) const {
+            const u64 total = Count();
+            if (total == 0) { return 0; }
+            const f64 clamped = X_CLAMP(p, 0.0, 100.0);
+            u64 rank          = CAST<u64>(clamped / 100.0 * CAST<f64>(total) + 0.5);
+            if (rank == 0) { rank = 1; }
+            u64 seen = 0;
+            for (u32 i = 0; i < kBucketCount; ++i) {
+                seen += mBuckets[i];
+                if (seen >= rank) { return BucketUpperBound(i); }
+            }
+            return BucketUpperBound(kBucketCount - 1);
+        }
+
+        X_NODISCARD const array<u64, kBucketCount>& Buckets() const {
+            return mBuckets;
+        }
+
+    private:
+        array<u64, kBucketCount> mBuckets {};
+    };
+
+    struct IoOpStats {
+        u64 count   = 0;
+        u64 errors  = 0;
+        u64 bytes   = 0;
+        u64 totalNs = 0;
+        u64 maxNs   = 0;
+        IoHistogram latency;
+
+        X_NODISCARD f64 MeanNs() const {
+            return count == 0 ? 0.0 : CAST<f64>(totalNs) / CAST<f64>(count);
+        }
+
+        void Merge(const IoOpStats& other) {
+            count += other.count;
+            errors += other.errors;
+            bytes += other.bytes;
+            totalNs += other.totalNs;
+            maxNs = X_MAX(maxNs, other.maxNs);
+            latency.Merge(other.latency);
+        }
+    };
+
+    using IoOpStatsTable = array<IoOpStats, kIoOpCount>;
+
+    struct IoPrefixStats {
+        str prefix;
+        IoOpStatsTable ops {};
+    };
+
+    struct IoStatsSnapshot {
+        IoOpStatsTable ops {};
+        vector<IoPrefixStats> prefixes;
+
+        /// @brief Human-readable table of every operation that was recorded at least once.
+        X_NODISCARD str ToString() const {
+            str out;
+            AppendTable(out, "all", ops);
+            for (const auto& prefix : prefixes) {
+                AppendTable(out, prefix.prefix, prefix.ops);
+            }
+            return out;
+        }
+
+    private:
+        static void AppendTable(str& out, const str& label, const IoOpStatsTable& table) {
+            char line[256];
+            std::snprintf(line, sizeof(line), "[%s]\n", label.c_str());
+            out += line;
+            for (size_t i = 0; i < kIoOpCount; ++i) {
+                const auto& s = table[i];
+                if (s.count == 0) { continue; }
+                std::snprintf(line,
+                              sizeof(line),
+                              "  %-26s count=%llu errors=%llu bytes=%llu p50=%lluns p99=%lluns max=%lluns\n",
+                              IoOpName(CAST<IoOp>(i)),
+                              CAST<unsigned long long>(s.count),
+                              CAST<unsigned long long>(s.errors),
+                              CAST<unsigned long long>(s.bytes),
+                              CAST<unsigned long long>(X_MIN(s.latency.Percentile(50), s.maxNs)),
+                              CAST<unsigned long long>(X_MIN(s.latency.Percentile(99), s.maxNs)),
+                              CAST<unsigned long long>(s.maxNs));
+                out += line;
+            }
+        }
+    };
+
+    namespace detail {
+        /// Counters owned by a single thread. They are atomics only so Snapshot() and Reset() can touch them
+        /// from another thread; the owner never contends with anyone.
+        struct IoOpCounters {
+            std::atomic<u64> count {0};
+            std::atomic<u64> errors {0};
+            std::atomic<u64> bytes {0};
+            std::atomic<u64> totalNs {0};
+            std::atomic<u64> maxNs {0};
+            std::atomic<u64> buckets[IoHistogram::kBucketCount] {};
+
+            void Record(u64 byteCount, u64 latencyNs, bool ok) {
+                count.fetch_add(1, std::memory_order_relaxed);
+                if (!ok) { errors.fetch_add(1, std::memory_order_relaxed); }
+                bytes.fetch_add(byteCount, std::memory_order_relaxed);
+                totalNs.fetch_add(latencyNs, std::memory_order_relaxed);
+                if (latencyNs > maxNs.load(std::memory_order_relaxed)) {
+                    maxNs.store(latencyNs, std::memory_order_relaxed);
+                }
+                buckets[IoHistogram::BucketIndex(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void AddTo(IoOpStats& stats) const {
+                stats.count += count.load(std::memory_order_relaxed);
+                stats.errors += errors.load(std::memory_order_relaxed);
+                stats.bytes += bytes.load(std::memory_order_relaxed);
+                stats.totalNs += totalNs.load(std::memory_order_relaxed);
+                stats.maxNs = X_MAX(stats.maxNs, maxNs.load(std::memory_order_relaxed));
+                for (u32 i = 0; i < IoHistogram::kBucketCount; ++i) {
+                    const u64 n = buckets[i].load(std::memory_order_relaxed);
+                    if (n) { stats.latency.AddBucket(i, n); }
+                }
+            }
+
+            void Reset() {
+                count.store(0, std::memory_order_relaxed);
+                errors.store(0, std::memory_order_relaxed);
+                bytes.store(0, std::memory_order_relaxed);
+                totalNs.store(0, std::memory_order_relaxed);
+                maxNs.store(0, std::memory_order_relaxed);
+                for (auto& bucket : buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        using IoOpCounterTable = array<IoOpCounters, kIoOpCount>;
+    }  // namespace detail
+
+    class IoStats {
+    public:
+        static constexpr u32 kMaxPrefixes = 16;
+
+#ifdef X_ENABLE_IO_STATS
+        static constexpr bool kEnabled = true;
+#else
+        static constexpr bool kEnabled = false;
+#endif
+
+        /// @brief Registers a path prefix to aggregate separately. Paths are attributed to the longest registered
+        /// prefix they start with. Prefixes are compared against the normalized Path string.
+        ///
+        /// Returns the prefix id, or -1 if kMaxPrefixes have already been registered.
+        static i32 AddPathPrefix(strview prefix) {
+            auto& registry = Registry();
+            std::lock_guard lock(registry.mutex);
+            const u32 count = registry.prefixCount.load(std::memory_order_relaxed);
+            for (u32 i = 0; i < count; ++i) {
+                if (registry.prefixes[i] == prefix) { return CAST<i32>(i); }
+            }
+            if (count == kMaxPrefixes) { return -1; }
+            registry.prefixes[count] = str(prefix);
+            registry.prefixCount.store(count + 1, std::memory_order_release);
+            return CAST<i32>(count);
+        }
+
+        /// @brief Returns the id of the longest registered prefix `path` starts with, or -1.
+        static i32 MatchPrefix(strview path) {
+            const auto& registry = Registry();
+            const u32 count      = registry.prefixCount.load(std::memory_order_acquire);
+            i32 best             = -1;
+            size_t bestLength    = 0;
+            for (u32 i = 0; i < count; ++i) {
+                const str& prefix = registry.prefixes[i];
+                if (prefix.size() >= bestLength && path.starts_with(prefix)) {
+                    best       = CAST<i32>(i);
+                    bestLength = prefix.size();
+                }
+            }
+            return best;
+        }
+
+        static void Record(IoOp op, i32 prefixId, u64 bytes, u64 latencyNs, bool ok) {
+            auto& shard = LocalShard();
+            const auto index = CAST<size_t>(op);
+            shard.global[index].Record(bytes, latencyNs, ok);
+            if (prefixId >= 0) { shard.Prefix(CAST<u32>(prefixId))[index].Record(bytes, latencyNs, ok); }
+        }
+
+        /// @brief Merges every live thread shard plus the totals of threads that have already exited.
+        static IoStatsSnapshot Snapshot() {
+            auto& registry = Registry();
+            std::lock_guard lock(registry.mutex);
+
+            IoStatsSnapshot snapshot;
+            snapshot.ops = registry.retired;
+
+            const u32 prefixCount = registry.prefixCount.load(std::memory_order_relaxed);
+            snapshot.prefixes.resize(prefixCount);
+            for (u32 i = 0; i < prefixCount; ++i) {
+                snapshot.prefixes[i].prefix = registry.prefixes[i];
+                snapshot.prefixes[i].ops    = registry.retiredPrefixes[i];
+            }
+
+            for (const auto* shard : registry.shards) {
+                shard->AddTo(snapshot.ops, snapshot.prefixes);
+            }
+
+            return snapshot;
+        }
+
+        /// @brief Zeroes all counters. Registered prefixes are kept.
+        static void Reset() {
+            auto& registry = Registry();
+            std::lock_guard lock(registry.mutex);
+            registry.retired = {};
+            for (auto& table : registry.retiredPrefixes) {
+                table = {};
+            }
+            for (auto* shard : registry.shards) {
+                shard->Reset();
+            }
+        }
+
+    private:
+        struct Shard;
+
+        struct RegistryState {
+            std::mutex mutex;
+            vector<Shard*> shards;
+            IoOpStatsTable retired {};
+            array<IoOpStatsTable, kMaxPrefixes> retiredPrefixes {};
+            array<str, kMaxPrefixes> prefixes;
+            std::atomic<u32> prefixCount {0};
+        };
+
+        struct Shard {
+            detail::IoOpCounterTable global;
+            // Allocated lazily by the owning thread the first time it touches a prefix
+            array<std::atomic<detail::IoOpCounterTable*>, kMaxPrefixes> prefixes {};
+
+            Shard() {
+                auto& registry = Registry();
+                std::lock_guard lock(registry.mutex);
+                registry.shards.push_back(this);
+            }
+
+            ~Shard() {
+                auto& registry = Registry();
+                std::lock_guard lock(registry.mutex);
+                AddTo(registry.retired, registry.retiredPrefixes);
+                std::erase(registry.shards, this);
+                for (auto& table : prefixes) {
+                    delete table.load(std::memory_order_relaxed);
+                }
+            }
+
+            Shard(const Shard&)            = delete;
+            Shard& operator=(const Shard&) = delete;
+
+            detail::IoOpCounterTable& Prefix(u32 id) {
+                auto* table = prefixes[id].load(std::memory_order_relaxed);
+                if (!table) {
+                    table = new detail::IoOpCounterTable();
+                    prefixes[id].store(table, std::memory_order_release);
+                }
+                return *table;
+            }
+
+            template<typename PrefixTables>
+            void AddTo(IoOpStatsTable& ops, PrefixTables& prefixTables) const {
+                for (size_t i = 0; i < kIoOpCount; ++i) {
+                    global[i].AddTo(ops[i]);
+                }
+                for (size_t p = 0; p < prefixTables.size() && p < kMaxPrefixes; ++p) {
+                    const auto* table = prefixes[p].load(std::memory_order_acquire);
+                    if (!table) { continue; }
+                    auto& dst = Ops(prefixTables[p]);
+                    for (size_t i = 0; i < kIoOpCount; ++i) {
+                        (*table)[i].AddTo(dst[i]);
+                    }
+                }
+            }
+
+            void Reset() {
+                for (auto& counters : global) {
+                    counters.Reset();
+                }
+                for (auto& entry : prefixes) {
+                    auto* table = entry.load(std::memory_order_acquire);
+                    if (!table) { continue; }
+                    for (auto& counters : *table) {
+                        counters.Reset();
+                    }
+                }
+            }
+
+        private:
+            static IoOpStatsTable& Ops(IoOpStatsTable& table) {
+                return table;
+            }
+
+            static IoOpStatsTable& Ops(IoPrefixStats& stats) {
+                return stats.ops;
+            }
+        };
+
+        static RegistryState& Registry() {
+            // Leaked on purpose so thread shards can still retire into it during static destruction
+            static auto* registry = new RegistryState();
+            return *registry;
+        }
+
+        static Shard& LocalShard() {
+            thread_local Shard shard;
+            return shard;
+        }
+    };
+
+    /// @brief Times a single operation and records it on destruction. Operations that never call Done() are
+    /// counted as errors.
+    class IoOpScope {
+    public:
+        IoOpScope(IoOp op, strview path) : IoOpScope(op, IoStats::MatchPrefix(path)) {}
+
+        IoOpScope(IoOp op, i32 prefixId)
+            : mStart(std::chrono::steady_clock::now()), mPrefixId(prefixId), mOp(op) {}
+
+        ~IoOpScope() {
+            const auto elapsed = std::chrono::steady_clock::now() - mStart;
+            const auto ns      = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            IoStats::Record(mOp, mPrefixId, mBytes, CAST<u64>(ns), mOk);
+        }
+
+        IoOpScope(const IoOpScope&)            = delete;
+        IoOpScope& operator=(const IoOpScope&) = delete;
+
+        void Done(u64 bytes) {
+            mBytes = bytes;
+            mOk    = true;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point mStart;
+        u64 mBytes = 0;
+        i32 mPrefixId;
+        IoOp mOp;
+        bool mOk = false;
+    };
+}  // namespace x
+
+#ifdef X_ENABLE_IO_STATS
+    /// Declares a timed scope named `name` for `op` on `path` (a Path string or a prefix id)
+    #define X_IO_SCOPE(name, op, path) ::x::IoOpScope name(op, path)
+    /// Marks the scope as successful after transferring `bytes`
+    #define X_IO_DONE(name, bytes) (name).Done(bytes)
+    /// Expands `expr` only when instrumentation is enabled
+    #define X_IO_ONLY(expr) expr
+#else
+    #define X_IO_SCOPE(name, op, path)
+    #define X_IO_DONE(name, bytes) ((void)0)
+    #define X_IO_ONLY(expr)
+#endif
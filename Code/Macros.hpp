@@ -41,6 +41,7 @@ inline constexpr size_t operator"" _GIGABYTES(unsigned long long n) {
 #define X_STRINGIFY(x) #x
 #define X_STRINGIFY_EXPAND(x) X_STRINGIFY(x)
 #define X_CONCAT(a, b) a##b
+#define X_CONCAT_EXPAND(a, b) X_CONCAT(a, b)
 
 #define X_BIT(x) (1ULL << (x))
 #define X_SETBIT(x, bit) ((x) |= X_BIT(bit))
@@ -72,10 +73,47 @@ inline constexpr size_t operator"" _GIGABYTES(unsigned long long n) {
 
 #define X_CACHE_ALIGNED __declspec(align(64))
 
+// Vector instruction sets the compiler is allowed to emit unconditionally for this build
+#if defined(__AVX2__)
+    #define X_SIMD_AVX2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX__) || defined(X_SIMD_AVX2)
+    #define X_SIMD_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define X_SIMD_SSE2 1
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+    #define X_SIMD_NEON 1
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define X_ARCH_X86 1
+#endif
+
+// Lets one function use instructions beyond the build's baseline; callers must check the CPU supports them first.
+// MSVC exposes every intrinsic unconditionally, so it needs no annotation.
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define X_TARGET(isa)
+    #define X_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+    #define X_TARGET(isa) __attribute__((target(isa)))
+    #define X_NO_SANITIZE_ADDRESS __attribute__((no_sanitize("address")))
+#endif
+
 #define X_NODISCARD [[nodiscard]]
 
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define X_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define X_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 #define X_CSTR_EMPTY(val) std::strcmp(val, "") == 0
 
 #define X_STRCMP(a, b) std::strcmp(a, b) == 0
 
-#define X_TOSTR(val) std::to_string(val)
\ No newline at end of file
+#define X_TOSTR(val) std::to_string(val)
+
+/// Allocation-free X_TOSTR: the number (or char) as an inline x::NumberText, from NumberFormat.hpp
+#define X_TOCHARS(val) x::ToChars(val)
\ No newline at end of file
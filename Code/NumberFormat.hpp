@@ -0,0 +1,177 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Number-to-text conversion into caller buffers, with no allocation and no locale. Integers are written two digits
+// at a time from a table of digit pairs, halving the divisions a digit-by-digit loop needs; floats use
+// std::to_chars, which both supported standard libraries implement with Ryu for the shortest round-trip form.
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include "FixedString.hpp"
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <system_error>
+
+namespace x {
+    /// @brief Longest output of FormatInteger: u64 max has 20 digits, i64 min has 19 and a sign
+    inline constexpr size_t kMaxIntegerChars = 20;
+
+    /// @brief Longest output of FormatFloat, e.g. "-2.2250738585072014e-308"
+    inline constexpr size_t kMaxFloatChars = 24;
+
+    namespace detail {
+        inline constexpr char kDigitPairs[] = "00010203040506070809"
+                                              "10111213141516171819"
+                                              "20212223242526272829"
+                                              "30313233343536373839"
+                                              "40414243444546474849"
+                                              "50515253545556575859"
+                                              "60616263646566676869"
+                                              "70717273747576777879"
+                                              "80818283848586878889"
+                                              "90919293949596979899";
+
+        inline constexpr u64 kPowersOf10[] = {
+          1ULL,
+          10ULL,
+          100ULL,
+          1000ULL,
+          10000ULL,
+          100000ULL,
+          1000000ULL,
+          10000000ULL,
+          100000000ULL,
+          1000000000ULL,
+          10000000000ULL,
+          100000000000ULL,
+          1000000000000ULL,
+          10000000000000ULL,
+          100000000000000ULL,
+          1000000000000000ULL,
+          10000000000000000ULL,
+          100000000000000000ULL,
+          1000000000000000000ULL,
+          10000000000000000000ULL,
+        };
+
+        /// Decimal digits in `value` without a division loop: bit_width * log10(2) estimates the digit count to
+        /// within one, and a single table lookup settles it. Zero has one digit.
+        constexpr u32 CountDigits(u64 value) {
+            const u32 estimate = (CAST<u32>(std::bit_width(value | 1)) * 1233) >> 12;
+            return estimate + ((value | 1) >= kPowersOf10[estimate] ? 1 : 0);
+        }
+
+        // Writes exactly `count` digits of `value` backwards from dst + count
+        constexpr void WriteDigits(char* dst, u64 value, u32 count) {
+            char* out = dst + count;
+            while (value >= 100) {
+                const size_t pair = CAST<size_t>(value % 100) * 2;
+                value /= 100;
+                out -= 2;
+                out[0] = kDigitPairs[pair];
+                out[1] = kDigitPairs[pair + 1];
+            }
+            if (value >= 10) {
+                out -= 2;
+                out[0] = kDigitPairs[value * 2];
+                out[1] = kDigitPairs[value * 2 + 1];
+            } else {
+                *--out = CAST<char>('0' + value);
+            }
+        }
+
+        template<typename T>
+        concept FormattableInteger =
+          std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> && sizeof(T) <= sizeof(u64);
+    }  // namespace detail
+
+    /// @brief Writes `value` in decimal to `dst`, which must hold kMaxIntegerChars. Not NUL-terminated; returns the
+    /// number of characters written.
+    template<detail::FormattableInteger T>
+    constexpr size_t FormatInteger(char* dst, T value) {
+        u64 magnitude = CAST<u64>(value);
+        size_t sign   = 0;
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0) {
+                magnitude = 0 - magnitude;  // Well-defined even for the minimum value
+                dst[0]    = '-';
+                sign      = 1;
+            }
+        }
+        const u32 count = detail::CountDigits(magnitude);
+        detail::WriteDigits(dst + sign, magnitude, count);
+        return sign + count;
+    }
+
+    /// @brief Writes `value` left-padded with `fill` to at least `width` characters, e.g. FormatPadded(dst, 7, 3)
+    /// gives "007". With the default '0' fill a minus sign goes before the padding. The output is the longer of
+    /// `width` and the unpadded number, so X_MAX(width, kMaxIntegerChars) always fits. Not NUL-terminated; returns
+    /// the number of characters written.
+    template<detail::FormattableInteger T>
+    constexpr size_t FormatPadded(char* dst, T value, size_t width, char fill = '0') {
+        char digits[kMaxIntegerChars] {};
+        const size_t count = FormatInteger(digits, value);
+        if (count >= width) {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = digits[i];
+            }
+            return count;
+        }
+
+        size_t out       = 0;
+        size_t firstChar = 0;
+        if (fill == '0' && digits[0] == '-') {
+            dst[out++] = '-';
+            firstChar  = 1;
+        }
+        for (size_t i = count; i < width; ++i) {
+            dst[out++] = fill;
+        }
+        for (size_t i = firstChar; i < count; ++i) {
+            dst[out++] = digits[i];
+        }
+        return out;
+    }
+
+    /// @brief Writes the shortest text that parses back to exactly `value`, e.g. "0.1" rather than
+    /// "0.10000000000000001". `dst` must hold kMaxFloatChars. Not NUL-terminated; returns the number of characters
+    /// written.
+    template<std::floating_point T>
+        requires(sizeof(T) <= sizeof(double))
+    size_t FormatFloat(char* dst, T value) {
+        const auto result = std::to_chars(dst, dst + kMaxFloatChars, value);
+        return CAST<size_t>(result.ptr - dst);
+    }
+
+    /// @brief Writes `value` with exactly `precision` digits after the decimal point. Fixed notation has no length
+    /// bound (1e300 has 301 digits), so this takes the buffer size and returns 0 if the text does not fit.
+    template<std::floating_point T>
+    size_t FormatFixed(char* dst, size_t dstSize, T value, int precision) {
+        const auto result = std::to_chars(dst, dst + dstSize, value, std::chars_format::fixed, precision);
+        return result.ec == std::errc() ? CAST<size_t>(result.ptr - dst) : 0;
+    }
+
+    /// @brief Inline text of a number or character, returned by value: the allocation-free counterpart of
+    /// X_TOSTR/std::to_string. Unlike std::to_string, a char converts to itself rather than to its code.
+    using NumberText = FixedString<kMaxFloatChars>;
+
+    template<detail::FormattableInteger T>
+    NumberText ToChars(T value) {
+        char buffer[kMaxIntegerChars];
+        return NumberText(strview(buffer, FormatInteger(buffer, value)));
+    }
+
+    template<std::floating_point T>
+        requires(sizeof(T) <= sizeof(double))
+    NumberText ToChars(T value) {
+        char buffer[kMaxFloatChars];
+        return NumberText(strview(buffer, FormatFloat(buffer, value)));
+    }
+
+    inline NumberText ToChars(char c) {
+        return NumberText(strview(&c, 1));
+    }
+}  // namespace x
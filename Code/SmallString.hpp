@@ -0,0 +1,412 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+namespace x {
+    /// @brief String that keeps up to `Inline` characters inside the object and only allocates beyond that.
+    ///
+    /// Mirrors the std::string members most code uses (size, data, c_str, append, find, substr, ...) so it can
+    /// replace one in place, but with an inline buffer sized for the data: std::string's small-string buffer holds 15
+    /// characters on libstdc++, too few for most paths and keys. Moves steal the heap buffer, or copy at most
+    /// `Inline` bytes when there is none.
+    ///
+    /// Heap storage comes from `Allocator`. PmrSmallString takes a std::pmr::memory_resource, so strings can be
+    /// carved from an arena such as std::pmr::monotonic_buffer_resource and released all at once.
+    template<size_t Inline, typename Allocator = std::allocator<char>>
+    class SmallString {
+        using Traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type      = char;
+        using size_type       = size_t;
+        using iterator        = char*;
+        using const_iterator  = const char*;
+        using allocator_type  = Allocator;
+        using traits_type     = std::char_traits<char>;
+        using reference       = char&;
+        using const_reference = const char&;
+
+        static constexpr size_t npos            = strview::npos;
+        static constexpr size_t kInlineCapacity = Inline;
+
+        SmallString() noexcept(noexcept(Allocator())) : SmallString(Allocator()) {}
+
+        explicit SmallString(const Allocator& allocator) noexcept : mAllocator(allocator) {}
+
+        SmallString(strview text, const Allocator& allocator = Allocator()) : mAllocator(allocator) {
+            assign(text);
+        }
+
+        SmallString(const char* text, const Allocator& allocator = Allocator()) : mAllocator(allocator) {
+            assign(strview(text));
+        }
+
+        SmallString(const str& text, const Allocator& allocator = Allocator()) : mAllocator(allocator) {
+            assign(strview(text));
+        }
+
+        SmallString(const SmallString& other)
+            : mAllocator(Traits::select_on_container_copy_construction(other.mAllocator)) {
+            assign(other.View());
+        }
+
+        SmallString(SmallString&& other) noexcept : mAllocator(std::move(other.mAllocator)) {
+            TakeFrom(other);
+        }
+
+        ~SmallString() {
+            Release();
+        }
+
+        SmallString& operator=(const SmallString& other) {
+            if (this == &other) { return *this; }
+            if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+                if (mAllocator != other.mAllocator) {
+                    Release();
+                    ResetInline();
+                }
+                mAllocator = other.mAllocator;
+            }
+            assign(other.View());
+            return *this;
+        }
+
+        SmallString& operator=(SmallString&& other) noexcept(Traits::propagate_on_container_move_assignment::value ||
+                                                             Traits::is_always_equal::value) {
+            if (this == &other) { return *this; }
+            if constexpr (!Traits::propagate_on_container_move_assignment::value && !Traits::is_always_equal::value) {
+                // The other buffer belongs to a different arena; it cannot be adopted, only copied
+                if (mAllocator != other.mAllocator) {
+                    assign(other.View());
+                    other.clear();
+                    return *this;
+                }
+            }
+            Release();
+            if constexpr (Traits::propagate_on_container_move_assignment::value) {
+                mAllocator = std::move(other.mAllocator);
+            }
+            TakeFrom(other);
+            return *this;
+        }
+
+        SmallString& operator=(strview text) {
+            return assign(text);
+        }
+
+        SmallString& operator=(const char* text) {
+            return assign(strview(text));
+        }
+
+        SmallString& operator=(const str& text) {
+            return assign(strview(text));
+        }
+
+        SmallString& assign(strview text) {
+            if (text.size() > mCapacity) {
+                Reallocate(text.size(), 0, text);
+            } else {
+                std::memmove(mData, text.data(), text.size());  // `text` may point into this string
+                SetSize(text.size());
+            }
+            return *this;
+        }
+
+        SmallString& append(strview text) {
+            if (mSize + text.size() > mCapacity) {
+                Reallocate(GrowthFor(mSize + text.size()), mSize, text);
+            } else {
+                std::memmove(mData + mSize, text.data(), text.size());
+                SetSize(mSize + text.size());
+            }
+            return *this;
+        }
+
+        SmallString& append(const char* text, size_t count) {
+            return append(strview(text, count));
+        }
+
+        SmallString& append(size_t count, char c) {
+            if (mSize + count > mCapacity) { reserve(GrowthFor(mSize + count)); }
+            std::memset(mData + mSize, c, count);
+            SetSize(mSize + count);
+            return *this;
+        }
+
+        SmallString& operator+=(strview text) {
+            return append(text);
+        }
+
+        SmallString& operator+=(const char* text) {
+            return append(strview(text));
+        }
+
+        SmallString& operator+=(char c) {
+            push_back(c);
+            return *this;
+        }
+
+        void push_back(char c) {
+            if (mSize == mCapacity) { reserve(GrowthFor(mSize + 1)); }
+            mData[mSize] = c;
+            SetSize(mSize + 1);
+        }
+
+        void pop_back() {
+            SetSize(mSize - 1);
+        }
+
+        void reserve(size_t capacity) {
+            if (capacity > mCapacity) { Reallocate(capacity, mSize, {}); }
+        }
+
+        void resize(size_t size, char fill = '\0') {
+            if (size > mSize) {
+                reserve(size);
+                std::memset(mData + mSize, fill, size - mSize);
+            }
+            SetSize(size);
+        }
+
+        void clear() {
+            SetSize(0);
+        }
+
+        X_NODISCARD size_t size() const {
+            return mSize;
+        }
+
+        X_NODISCARD size_t length() const {
+            return mSize;
+        }
+
+        X_NODISCARD bool empty() const {
+            return mSize == 0;
+        }
+
+        X_NODISCARD size_t capacity() const {
+            return mCapacity;
+        }
+
+        /// @brief True until the string first outgrows the inline buffer; like std::string it never shrinks back
+        X_NODISCARD bool IsInline() const {
+            return mData == mInline;
+        }
+
+        X_NODISCARD char* data() {
+            return mData;
+        }
+
+        X_NODISCARD const char* data() const {
+            return mData;
+        }
+
+        X_NODISCARD const char* c_str() const {
+            return mData;
+        }
+
+        X_NODISCARD strview View() const {
+            return {mData, mSize};
+        }
+
+        X_NODISCARD str Str() const {
+            return str(mData, mSize);
+        }
+
+        operator strview() const {
+            return View();
+        }
+
+        X_NODISCARD allocator_type get_allocator() const {
+            return mAllocator;
+        }
+
+        char& operator[](size_t index) {
+            return mData[index];
+        }
+
+        const char& operator[](size_t index) const {
+            return mData[index];
+        }
+
+        char& front() {
+            return mData[0];
+        }
+
+        const char& front() const {
+            return mData[0];
+        }
+
+        char& back() {
+            return mData[mSize - 1];
+        }
+
+        const char& back() const {
+            return mData[mSize - 1];
+        }
+
+        iterator begin() {
+            return mData;
+        }
+
+        iterator end() {
+            return mData + mSize;
+        }
+
+        const_iterator begin() const {
+            return mData;
+        }
+
+        const_iterator end() const {
+            return mData + mSize;
+        }
+
+        X_NODISCARD SmallString substr(size_t pos = 0, size_t count = npos) const {
+            return SmallString(View().substr(pos, count), Traits::select_on_container_copy_construction(mAllocator));
+        }
+
+        X_NODISCARD size_t find(strview needle, size_t pos = 0) const {
+            return View().find(needle, pos);
+        }
+
+        X_NODISCARD size_t find(char c, size_t pos = 0) const {
+            return View().find(c, pos);
+        }
+
+        X_NODISCARD size_t rfind(strview needle, size_t pos = npos) const {
+            return View().rfind(needle, pos);
+        }
+
+        X_NODISCARD size_t rfind(char c, size_t pos = npos) const {
+            return View().rfind(c, pos);
+        }
+
+        X_NODISCARD size_t find_first_of(strview chars, size_t pos = 0) const {
+            return View().find_first_of(chars, pos);
+        }
+
+        X_NODISCARD size_t find_first_of(char c, size_t pos = 0) const {
+            return View().find_first_of(c, pos);
+        }
+
+        X_NODISCARD size_t find_last_of(strview chars, size_t pos = npos) const {
+            return View().find_last_of(chars, pos);
+        }
+
+        X_NODISCARD size_t find_last_of(char c, size_t pos = npos) const {
+            return View().find_last_of(c, pos);
+        }
+
+        X_NODISCARD bool starts_with(strview prefix) const {
+            return View().starts_with(prefix);
+        }
+
+        X_NODISCARD bool ends_with(strview suffix) const {
+            return View().ends_with(suffix);
+        }
+
+        X_NODISCARD int compare(strview other) const {
+            return View().compare(other);
+        }
+
+        template<size_t M, typename A>
+        friend bool operator==(const SmallString& lhs, const SmallString<M, A>& rhs) {
+            return lhs.View() == rhs.View();
+        }
+
+        friend bool operator==(const SmallString& lhs, strview rhs) {
+            return lhs.View() == rhs;
+        }
+
+        template<size_t M, typename A>
+        friend std::strong_ordering operator<=>(const SmallString& lhs, const SmallString<M, A>& rhs) {
+            return lhs.View() <=> rhs.View();
+        }
+
+        friend std::strong_ordering operator<=>(const SmallString& lhs, strview rhs) {
+            return lhs.View() <=> rhs;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const SmallString& text) {
+            return os << text.View();
+        }
+
+    private:
+        char* mData      = mInline;
+        size_t mSize     = 0;
+        size_t mCapacity = Inline;  // Excluding the terminator
+        char mInline[Inline + 1] {};
+        X_NO_UNIQUE_ADDRESS Allocator mAllocator;
+
+        void SetSize(size_t size) {
+            mSize        = size;
+            mData[mSize] = '\0';
+        }
+
+        // Grow geometrically so repeated appends stay amortized O(1)
+        size_t GrowthFor(size_t required) const {
+            return X_MAX(required, mCapacity * 2);
+        }
+
+        /// Moves to a `capacity` buffer keeping the first `keep` characters, then appends `extra`. The old buffer is
+        /// released last because `extra` may point into it.
+        void Reallocate(size_t capacity, size_t keep, strview extra) {
+            char* buffer = Traits::allocate(mAllocator, capacity + 1);
+            std::memcpy(buffer, mData, keep);
+            std::memcpy(buffer + keep, extra.data(), extra.size());
+            Release();
+            mData     = buffer;
+            mCapacity = capacity;
+            SetSize(keep + extra.size());
+        }
+
+        void Release() {
+            if (!IsInline()) { Traits::deallocate(mAllocator, mData, mCapacity + 1); }
+        }
+
+        void ResetInline() {
+            mData     = mInline;
+            mCapacity = Inline;
+            SetSize(0);
+        }
+
+        // Adopts other's heap buffer, or copies its inline contents; expects this string to own no heap buffer
+        void TakeFrom(SmallString& other) {
+            if (other.IsInline()) {
+                mData     = mInline;
+                mCapacity = Inline;
+                std::memcpy(mInline, other.mInline, other.mSize + 1);
+                mSize = other.mSize;
+            } else {
+                mData     = other.mData;
+                mSize     = other.mSize;
+                mCapacity = other.mCapacity;
+            }
+            other.ResetInline();
+        }
+    };
+
+    /// @brief SmallString whose heap storage comes from a std::pmr::memory_resource, e.g. an arena.
+    template<size_t Inline>
+    using PmrSmallString = SmallString<Inline, std::pmr::polymorphic_allocator<char>>;
+}  // namespace x
+
+template<size_t Inline, typename Allocator>
+struct std::hash<x::SmallString<Inline, Allocator>> {
+    size_t operator()(const x::SmallString<Inline, Allocator>& text) const noexcept {
+        return std::hash<std::string_view> {}(text.View());
+    }
+};
@@ -4,99 +4,2027 @@
 #pragma once
 #pragma warning(disable : 4996)
 
+#include "Utf.hpp"
+#include "Cpu.hpp"
+#include <bit>
+#include <cctype>
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
 #include <string>
-#include <locale>
-#include <codecvt>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(X_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(X_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
 
 namespace x {
+    /// @brief UTF-16/32 (per wchar_t) to UTF-8. Returns an empty string if `input` is not valid.
     inline std::string WideToAnsi(const std::wstring& input) {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-        try {
-            return converter.to_bytes(input);
-        } catch (const std::range_error&) { return std::string(); }
+        return WideToUtf8(input);
     }
 
+    /// @brief UTF-8 to UTF-16/32 (per wchar_t). Returns an empty string if `input` is not valid UTF-8.
     inline std::wstring AnsiToWide(const std::string& input) {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-        try {
-            return converter.from_bytes(input);
-        } catch (const std::range_error&) { return std::wstring(); }
+        return Utf8ToWide(input);
     }
 
+    // The bounded scans below never read past the end of the 4 KiB page holding the last byte they are allowed to
+    // look at: single-string scans load whole aligned vectors (which cannot straddle a page), and the two-string
+    // compare falls back to bytes whenever either side is about to cross a page. Lanes past `maxLen` or before the
+    // string are loaded but masked off, hence the sanitizer opt-out.
+    namespace detail {
+        inline constexpr uintptr_t kPageSize = 4096;
+
+        inline bool NearPageEnd(const char* p, size_t width) {
+            return (RCAST<uintptr_t>(p) & (kPageSize - 1)) > kPageSize - width;
+        }
+
+        /// Offset of the first NUL in the first `maxLen` bytes, or maxLen
+        inline size_t FindNulScalar(const char* str, size_t maxLen) {
+            size_t i = 0;
+            for (; i < maxLen && str[i] != '\0'; ++i) {}
+            return i;
+        }
+
+        /// Offset of the first byte outside printable ASCII (which includes NUL), or maxLen
+        inline size_t FindNonPrintableScalar(const char* str, size_t maxLen) {
+            size_t i = 0;
+            for (; i < maxLen && CAST<u8>(str[i] - 0x20) <= 0x5E; ++i) {}
+            return i;
+        }
+
+        /// Offset of the first byte that differs or ends `a`, or maxLen
+        inline size_t FindMismatchScalar(const char* a, const char* b, size_t maxLen) {
+            size_t i = 0;
+            for (; i < maxLen && a[i] == b[i] && a[i] != '\0'; ++i) {}
+            return i;
+        }
+
+        /// Copies `src` up to its NUL or `limit` bytes, whichever comes first, without terminating `dst`. Returns
+        /// the bytes copied.
+        inline size_t CopyUntilNulScalar(char* dst, const char* src, size_t limit) {
+            size_t i = 0;
+            for (; i < limit && src[i] != '\0'; ++i) {
+                dst[i] = src[i];
+            }
+            return i;
+        }
+
+#if defined(X_SIMD_SSE2)
+        template<bool kNonPrintable>
+        inline u32 MatchSse2(__m128i v) {
+            if constexpr (kNonPrintable) {
+                // Shift 0x20..0x7E onto -128..-34 so one signed compare picks out printable bytes
+                const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(0x60));
+                return ~CAST<u32>(_mm_movemask_epi8(_mm_cmplt_epi8(shifted, _mm_set1_epi8(-33)))) & 0xFFFF;
+            } else {
+                return CAST<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())));
+            }
+        }
+
+        template<bool kNonPrintable>
+        X_NO_SANITIZE_ADDRESS inline size_t ScanSse2(const char* str, size_t maxLen) {
+            const size_t misalign = RCAST<uintptr_t>(str) & 15;
+            u32 mask = MatchSse2<kNonPrintable>(_mm_load_si128(RCAST<const __m128i*>(str - misalign))) >> misalign;
+            if (mask) { return X_MIN(CAST<size_t>(std::countr_zero(mask)), maxLen); }
+            for (size_t i = 16 - misalign; i < maxLen; i += 16) {
+                mask = MatchSse2<kNonPrintable>(_mm_load_si128(RCAST<const __m128i*>(str + i)));
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+            }
+            return maxLen;
+        }
+
+        X_NO_SANITIZE_ADDRESS inline size_t FindMismatchSse2(const char* a, const char* b, size_t maxLen) {
+            size_t i = 0;
+            while (i < maxLen) {
+                if (NearPageEnd(a + i, 16) || NearPageEnd(b + i, 16)) {
+                    if (a[i] != b[i] || a[i] == '\0') { return i; }
+                    ++i;
+                    continue;
+                }
+                const __m128i va = _mm_loadu_si128(RCAST<const __m128i*>(a + i));
+                const __m128i vb = _mm_loadu_si128(RCAST<const __m128i*>(b + i));
+                const u32 mask   = (~CAST<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) & 0xFFFF) |
+                                 CAST<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, _mm_setzero_si128())));
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+                i += 16;
+            }
+            return maxLen;
+        }
+
+        // Each source vector is scanned and, if it holds no NUL, stored straight away; only the final partial
+        // vector goes through memcpy
+        X_NO_SANITIZE_ADDRESS inline size_t CopyUntilNulSse2(char* dst, const char* src, size_t limit) {
+            const size_t misalign = RCAST<uintptr_t>(src) & 15;
+            const size_t head     = 16 - misalign;
+            u32 mask              = MatchSse2<false>(_mm_load_si128(RCAST<const __m128i*>(src - misalign))) >> misalign;
+            const size_t n        = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : head, limit);
+            std::memcpy(dst, src, n);
+            if (n < head) { return n; }
+
+            for (size_t i = head; i < limit; i += 16) {
+                const __m128i v = _mm_load_si128(RCAST<const __m128i*>(src + i));
+                mask            = MatchSse2<false>(v);
+                if (mask == 0 && i + 16 <= limit) {
+                    _mm_storeu_si128(RCAST<__m128i*>(dst + i), v);
+                    continue;
+                }
+                const size_t tail = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : 16, limit - i);
+                std::memcpy(dst + i, src + i, tail);
+                return i + tail;
+            }
+            return limit;
+        }
+#endif
+
+#if defined(X_ARCH_X86)
+        template<bool kNonPrintable>
+        X_TARGET("avx2") inline u32 MatchAvx2(__m256i v) {
+            if constexpr (kNonPrintable) {
+                const __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(0x60));
+                return ~CAST<u32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(-33), shifted)));
+            } else {
+                return CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+            }
+        }
+
+        template<bool kNonPrintable>
+        X_TARGET("avx2") X_NO_SANITIZE_ADDRESS inline size_t ScanAvx2(const char* str, size_t maxLen) {
+            const size_t misalign = RCAST<uintptr_t>(str) & 31;
+            u32 mask = MatchAvx2<kNonPrintable>(_mm256_load_si256(RCAST<const __m256i*>(str - misalign))) >> misalign;
+            if (mask) { return X_MIN(CAST<size_t>(std::countr_zero(mask)), maxLen); }
+            for (size_t i = 32 - misalign; i < maxLen; i += 32) {
+                mask = MatchAvx2<kNonPrintable>(_mm256_load_si256(RCAST<const __m256i*>(str + i)));
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+            }
+            return maxLen;
+        }
+
+        X_TARGET("avx2")
+        X_NO_SANITIZE_ADDRESS inline size_t FindMismatchAvx2(const char* a, const char* b, size_t maxLen) {
+            size_t i = 0;
+            while (i < maxLen) {
+                if (NearPageEnd(a + i, 32) || NearPageEnd(b + i, 32)) {
+                    if (a[i] != b[i] || a[i] == '\0') { return i; }
+                    ++i;
+                    continue;
+                }
+                const __m256i va = _mm256_loadu_si256(RCAST<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(RCAST<const __m256i*>(b + i));
+                const u32 mask   = ~CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) |
+                                 CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, _mm256_setzero_si256())));
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+                i += 32;
+            }
+            return maxLen;
+        }
+
+        X_TARGET("avx2")
+        X_NO_SANITIZE_ADDRESS inline size_t CopyUntilNulAvx2(char* dst, const char* src, size_t limit) {
+            const size_t misalign = RCAST<uintptr_t>(src) & 31;
+            const size_t head     = 32 - misalign;
+            u32 mask = MatchAvx2<false>(_mm256_load_si256(RCAST<const __m256i*>(src - misalign))) >> misalign;
+            const size_t n = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : head, limit);
+            std::memcpy(dst, src, n);
+            if (n < head) { return n; }
+
+            for (size_t i = head; i < limit; i += 32) {
+                const __m256i v = _mm256_load_si256(RCAST<const __m256i*>(src + i));
+                mask            = MatchAvx2<false>(v);
+                if (mask == 0 && i + 32 <= limit) {
+                    _mm256_storeu_si256(RCAST<__m256i*>(dst + i), v);
+                    continue;
+                }
+                const size_t tail = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : 32, limit - i);
+                std::memcpy(dst + i, src + i, tail);
+                return i + tail;
+            }
+            return limit;
+        }
+
+        template<bool kNonPrintable>
+        X_TARGET("avx512f,avx512bw") inline u64 MatchAvx512(__m512i v) {
+            if constexpr (kNonPrintable) {
+                return _mm512_cmpgt_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8(0x20)), _mm512_set1_epi8(0x5E));
+            } else {
+                return _mm512_testn_epi8_mask(v, v);
+            }
+        }
+
+        template<bool kNonPrintable>
+        X_TARGET("avx512f,avx512bw") X_NO_SANITIZE_ADDRESS inline size_t ScanAvx512(const char* str, size_t maxLen) {
+            const size_t misalign = RCAST<uintptr_t>(str) & 63;
+            u64 mask = MatchAvx512<kNonPrintable>(_mm512_load_si512(str - misalign)) >> misalign;
+            if (mask) { return X_MIN(CAST<size_t>(std::countr_zero(mask)), maxLen); }
+            for (size_t i = 64 - misalign; i < maxLen; i += 64) {
+                mask = MatchAvx512<kNonPrintable>(_mm512_load_si512(str + i));
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+            }
+            return maxLen;
+        }
+
+        X_TARGET("avx512f,avx512bw")
+        X_NO_SANITIZE_ADDRESS inline size_t FindMismatchAvx512(const char* a, const char* b, size_t maxLen) {
+            size_t i = 0;
+            while (i < maxLen) {
+                if (NearPageEnd(a + i, 64) || NearPageEnd(b + i, 64)) {
+                    if (a[i] != b[i] || a[i] == '\0') { return i; }
+                    ++i;
+                    continue;
+                }
+                const __m512i va = _mm512_loadu_si512(a + i);
+                const __m512i vb = _mm512_loadu_si512(b + i);
+                const u64 mask   = _mm512_cmpneq_epi8_mask(va, vb) | _mm512_testn_epi8_mask(va, va);
+                if (mask) { return X_MIN(i + std::countr_zero(mask), maxLen); }
+                i += 64;
+            }
+            return maxLen;
+        }
+
+        X_TARGET("avx512f,avx512bw")
+        X_NO_SANITIZE_ADDRESS inline size_t CopyUntilNulAvx512(char* dst, const char* src, size_t limit) {
+            const size_t misalign = RCAST<uintptr_t>(src) & 63;
+            const size_t head     = 64 - misalign;
+            u64 mask              = MatchAvx512<false>(_mm512_load_si512(src - misalign)) >> misalign;
+            const size_t n        = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : head, limit);
+            std::memcpy(dst, src, n);
+            if (n < head) { return n; }
+
+            for (size_t i = head; i < limit; i += 64) {
+                const __m512i v = _mm512_load_si512(src + i);
+                mask            = MatchAvx512<false>(v);
+                if (mask == 0 && i + 64 <= limit) {
+                    _mm512_storeu_si512(dst + i, v);
+                    continue;
+                }
+                // A masked store writes only the lanes before the NUL or the limit
+                const size_t tail = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask)) : 64, limit - i);
+                _mm512_mask_storeu_epi8(dst + i, tail == 64 ? ~0ULL : (1ULL << tail) - 1, v);
+                return i + tail;
+            }
+            return limit;
+        }
+#endif
+
+#if defined(X_SIMD_NEON)
+        // Narrows a lane mask to 4 bits per byte; divide countr_zero by 4 for the lane index
+        inline u64 NeonMask(uint8x16_t lanes) {
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4)), 0);
+        }
+
+        template<bool kNonPrintable>
+        inline u64 MatchNeon(uint8x16_t v) {
+            if constexpr (kNonPrintable) {
+                return NeonMask(vcgtq_u8(vsubq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8(0x5E)));
+            } else {
+                return NeonMask(vceqq_u8(v, vdupq_n_u8(0)));
+            }
+        }
+
+        template<bool kNonPrintable>
+        X_NO_SANITIZE_ADDRESS inline size_t ScanNeon(const char* str, size_t maxLen) {
+            const size_t misalign = RCAST<uintptr_t>(str) & 15;
+            u64 mask = MatchNeon<kNonPrintable>(vld1q_u8(RCAST<const u8*>(str - misalign))) >> (misalign * 4);
+            if (mask) { return X_MIN(CAST<size_t>(std::countr_zero(mask) / 4), maxLen); }
+            for (size_t i = 16 - misalign; i < maxLen; i += 16) {
+                mask = MatchNeon<kNonPrintable>(vld1q_u8(RCAST<const u8*>(str + i)));
+                if (mask) { return X_MIN(i + std::countr_zero(mask) / 4, maxLen); }
+            }
+            return maxLen;
+        }
+
+        X_NO_SANITIZE_ADDRESS inline size_t FindMismatchNeon(const char* a, const char* b, size_t maxLen) {
+            size_t i = 0;
+            while (i < maxLen) {
+                if (NearPageEnd(a + i, 16) || NearPageEnd(b + i, 16)) {
+                    if (a[i] != b[i] || a[i] == '\0') { return i; }
+                    ++i;
+                    continue;
+                }
+                const uint8x16_t va = vld1q_u8(RCAST<const u8*>(a + i));
+                const uint8x16_t vb = vld1q_u8(RCAST<const u8*>(b + i));
+                const u64 mask      = NeonMask(vorrq_u8(vmvnq_u8(vceqq_u8(va, vb)), vceqq_u8(va, vdupq_n_u8(0))));
+                if (mask) { return X_MIN(i + std::countr_zero(mask) / 4, maxLen); }
+                i += 16;
+            }
+            return maxLen;
+        }
+
+        X_NO_SANITIZE_ADDRESS inline size_t CopyUntilNulNeon(char* dst, const char* src, size_t limit) {
+            const size_t misalign = RCAST<uintptr_t>(src) & 15;
+            const size_t head     = 16 - misalign;
+            u64 mask = MatchNeon<false>(vld1q_u8(RCAST<const u8*>(src - misalign))) >> (misalign * 4);
+            const size_t n = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask) / 4) : head, limit);
+            std::memcpy(dst, src, n);
+            if (n < head) { return n; }
+
+            for (size_t i = head; i < limit; i += 16) {
+                const uint8x16_t v = vld1q_u8(RCAST<const u8*>(src + i));
+                mask               = MatchNeon<false>(v);
+                if (mask == 0 && i + 16 <= limit) {
+                    vst1q_u8(RCAST<u8*>(dst + i), v);
+                    continue;
+                }
+                const size_t tail = X_MIN(mask ? CAST<size_t>(std::countr_zero(mask) / 4) : 16, limit - i);
+                std::memcpy(dst + i, src + i, tail);
+                return i + tail;
+            }
+            return limit;
+        }
+#endif
+
+        struct StrKernels {
+            size_t (*findNul)(const char*, size_t)                   = FindNulScalar;
+            size_t (*findNonPrintable)(const char*, size_t)          = FindNonPrintableScalar;
+            size_t (*findMismatch)(const char*, const char*, size_t) = FindMismatchScalar;
+            size_t (*copyUntilNul)(char*, const char*, size_t)       = CopyUntilNulScalar;
+        };
+
+#if defined(X_SIMD_SSE2)
+        inline constexpr StrKernels kBaselineStrKernels {
+          ScanSse2<false>,
+          ScanSse2<true>,
+          FindMismatchSse2,
+          CopyUntilNulSse2,
+        };
+#elif defined(X_SIMD_NEON)
+        inline constexpr StrKernels kBaselineStrKernels {
+          ScanNeon<false>,
+          ScanNeon<true>,
+          FindMismatchNeon,
+          CopyUntilNulNeon,
+        };
+#else
+        inline constexpr StrKernels kBaselineStrKernels {};
+#endif
+
+#if defined(X_ARCH_X86)
+        inline constexpr StrKernels kAvx2StrKernels {
+          ScanAvx2<false>,
+          ScanAvx2<true>,
+          FindMismatchAvx2,
+          CopyUntilNulAvx2,
+        };
+        inline constexpr StrKernels kAvx512StrKernels {
+          ScanAvx512<false>,
+          ScanAvx512<true>,
+          FindMismatchAvx512,
+          CopyUntilNulAvx512,
+        };
+#endif
+
+        /// The widest kernel set this CPU runs, chosen on first use
+        inline CpuDispatch<const StrKernels*> gStrKernels {+[] {
+#if defined(X_ARCH_X86)
+            return CpuSelect<const StrKernels*>(
+              {
+                {CpuMask({CpuFeature::Avx512F, CpuFeature::Avx512Bw}), &kAvx512StrKernels},
+                {CpuMask({CpuFeature::Avx2}), &kAvx2StrKernels},
+              },
+              &kBaselineStrKernels);
+#else
+            return &kBaselineStrKernels;
+#endif
+        }};
+
+        inline const StrKernels& SelectStrKernels() {
+            return *gStrKernels.Get();
+        }
+    }  // namespace detail
+
     inline bool StrCopy(char* dst, const size_t dstSize, const char* src) {
         if (!dst || !src || dstSize == 0) { return false; }
 
-        size_t srcLen = 0;
-        for (; srcLen < dstSize && src[srcLen] != '\0'; ++srcLen) {}
-
-        if (srcLen >= dstSize) {
+        // Scan and copy in one pass; src only fits if its NUL turns up within the room left for it
+        const size_t srcLen = detail::SelectStrKernels().copyUntilNul(dst, src, dstSize - 1);
+        if (src[srcLen] != '\0') {
             dst[0] = '\0';
             return false;
         }
 
-        std::memcpy(dst, src, srcLen);
         dst[srcLen] = '\0';
-
         return true;
     }
 
     inline bool StrConcat(char* dst, const size_t dstSize, const char* src) {
         if (!dst || !src || dstSize == 0) { return false; }
 
-        size_t dstLen = 0;
-        for (; dstLen < dstSize && dst[dstLen] != '\0'; ++dstLen) {}
-
+        const auto& kernels = detail::SelectStrKernels();
+        const size_t dstLen = kernels.findNul(dst, dstSize);
         if (dstLen >= dstSize) {
             dst[0] = '\0';
             return false;
         }
 
-        const size_t spaceLeft = dstSize - dstLen;
-        size_t srcLen          = 0;
-        for (; srcLen < spaceLeft && src[srcLen] != '\0'; ++srcLen) {}
-
-        if (srcLen >= spaceLeft) {
-            return false;  // Not enough space for concatenation
+        const size_t srcLen = kernels.copyUntilNul(dst + dstLen, src, dstSize - dstLen - 1);
+        if (src[srcLen] != '\0') {
+            dst[dstLen] = '\0';  // Not enough space for concatenation; drop what was copied
+            return false;
         }
 
-        std::memcpy(dst + dstLen, src, srcLen);
         dst[dstLen + srcLen] = '\0';
-
         return true;
     }
 
-    inline size_t StrLen(const char* str, const size_t maxLen) {
-        if (!str) { return 0; }
+    /// @brief Copies as much of `src` as fits and always NUL-terminates. Returns the bytes written, excluding the
+    /// terminator; the copy was truncated if src[result] is not NUL.
+    inline size_t StrCopyTruncate(char* dst, const size_t dstSize, const char* src) {
+        if (!dst || dstSize == 0) { return 0; }
+
+        const size_t written = src ? detail::SelectStrKernels().copyUntilNul(dst, src, dstSize - 1) : 0;
+        dst[written]         = '\0';
+        return written;
+    }
+
+    /// @brief Appends as much of `src` as fits and always NUL-terminates. Returns the bytes appended. A `dst` with
+    /// no terminator inside `dstSize` is reset to empty first, as StrConcat does.
+    inline size_t StrConcatTruncate(char* dst, const size_t dstSize, const char* src) {
+        if (!dst || dstSize == 0) { return 0; }
 
-        size_t len = 0;
-        for (; len < maxLen && str[len] != '\0'; ++len) {}
+        const size_t dstLen = detail::SelectStrKernels().findNul(dst, dstSize);
+        if (dstLen >= dstSize) {
+            dst[0] = '\0';
+            return 0;
+        }
 
-        return len;
+        return StrCopyTruncate(dst + dstLen, dstSize - dstLen, src);
     }
 
-    inline int StrCompare(const char* strA, const char* strB, const size_t maxLen) {
-        if (!strA || !strB) { return strA ? 1 : (strB ? -1 : 0); }
+    /// @brief Writes `fragments` back to back into `dst` and NUL-terminates, truncating once `dst` is full.
+    /// Returns the bytes written, excluding the terminator.
+    inline size_t StrConcatBatch(char* dst, const size_t dstSize, std::span<const strview> fragments) {
+        if (!dst || dstSize == 0) { return 0; }
+
+        size_t written = 0;
+        for (const strview fragment : fragments) {
+            const size_t count = X_MIN(fragment.size(), dstSize - 1 - written);
+            std::memcpy(dst + written, fragment.data(), count);
+            written += count;
+            if (count < fragment.size()) { break; }
+        }
+
+        dst[written] = '\0';
+        return written;
+    }
 
-        for (size_t i = 0; i < maxLen; ++i) {
-            if (strA[i] != strB[i] || strA[i] == '\0') { return strA[i] - strB[i]; }
+    inline size_t StrConcatBatch(char* dst, const size_t dstSize, std::initializer_list<strview> fragments) {
+        return StrConcatBatch(dst, dstSize, std::span(fragments.begin(), fragments.size()));
+    }
+
+    /// @brief StrConcatBatch for NUL-terminated fragments. Each one is scanned and copied in a single pass, and the
+    /// write position carries over, so nothing already written is rescanned.
+    inline size_t StrConcatBatch(char* dst, const size_t dstSize, std::span<const char* const> fragments) {
+        if (!dst || dstSize == 0) { return 0; }
+
+        const auto copyUntilNul = detail::SelectStrKernels().copyUntilNul;
+        size_t written          = 0;
+        for (const char* fragment : fragments) {
+            if (!fragment) { continue; }
+            const size_t room  = dstSize - 1 - written;
+            const size_t count = copyUntilNul(dst + written, fragment, room);
+            written += count;
+            if (count == room && fragment[count] != '\0') { break; }
         }
 
-        return 0;
+        dst[written] = '\0';
+        return written;
+    }
+
+    inline size_t StrLen(const char* str, const size_t maxLen) {
+        if (!str || maxLen == 0) { return 0; }
+        return detail::SelectStrKernels().findNul(str, maxLen);
+    }
+
+    inline int StrCompare(const char* strA, const char* strB, const size_t maxLen) {
+        if (!strA || !strB) { return strA ? 1 : (strB ? -1 : 0); }
+        if (maxLen == 0) { return 0; }
+
+        const size_t i = detail::SelectStrKernels().findMismatch(strA, strB, maxLen);
+        return i < maxLen ? strA[i] - strB[i] : 0;
     }
 
     inline bool StrValidate(const char* str, const size_t maxLen) {
         if (!str) { return false; }
 
-        bool foundNull = false;
-        for (size_t i = 0; i < maxLen; ++i) {
-            if (str[i] == '\0') {
-                foundNull = true;
-                break;
-            }
+        const auto findNonPrintable = detail::SelectStrKernels().findNonPrintable;
+        size_t i                    = 0;
+        while (i < maxLen) {
+            i += findNonPrintable(str + i, maxLen - i);
+            if (i == maxLen) { break; }
+            if (str[i] == '\0') { return i > 0; }
 
+            // Outside printable ASCII; only the current locale knows whether a high byte is printable
             if (!isprint(static_cast<uint8_t>(str[i]))) { return false; }
+            ++i;
+        }
+
+        return false;
+    }
+
+    namespace detail {
+        /// Scalar UTF-8 check from `offset`; returns the first invalid offset or npos
+        inline size_t FindInvalidUtf8Scalar(const u8* data, size_t size, size_t offset) {
+            size_t i = offset;
+            while (i < size) {
+                if (i + 8 <= size) {
+                    u64 word;
+                    std::memcpy(&word, data + i, sizeof(word));
+                    if ((word & 0x8080808080808080ULL) == 0) {
+                        i += 8;
+                        continue;
+                    }
+                }
+                char32_t codePoint;
+                const size_t length = DecodeUtf8(data + i, size - i, codePoint);
+                if (length == 0) { return i; }
+                i += length;
+            }
+            return str::npos;
         }
 
-        return foundNull && (StrLen(str, maxLen) > 0);
+#if defined(X_ARCH_X86) || defined(X_SIMD_NEON)
+    #if defined(X_ARCH_X86)
+        struct Utf8LanesAvx2 {
+            using Vec                     = __m256i;
+            static constexpr size_t kWidth = 32;
+
+            X_TARGET("avx2") static Vec Load(const u8* p) {
+                return _mm256_loadu_si256(RCAST<const __m256i*>(p));
+            }
+            X_TARGET("avx2") static Vec Splat(u8 v) {
+                return _mm256_set1_epi8(CAST<char>(v));
+            }
+            X_TARGET("avx2") static Vec Table(const u8* t) {
+                return _mm256_broadcastsi128_si256(_mm_loadu_si128(RCAST<const __m128i*>(t)));
+            }
+            X_TARGET("avx2") static Vec Lookup(Vec table, Vec index) {
+                return _mm256_shuffle_epi8(table, index);
+            }
+            X_TARGET("avx2") static Vec HighNibble(Vec v) {
+                return _mm256_and_si256(_mm256_srli_epi16(v, 4), Splat(0x0F));
+            }
+            X_TARGET("avx2") static Vec LowNibble(Vec v) {
+                return _mm256_and_si256(v, Splat(0x0F));
+            }
+            template<int N>
+            X_TARGET("avx2") static Vec Prev(Vec current, Vec previous) {
+                return _mm256_alignr_epi8(current, _mm256_permute2x128_si256(previous, current, 0x21), 16 - N);
+            }
+            X_TARGET("avx2") static Vec SubSat(Vec a, Vec b) {
+                return _mm256_subs_epu8(a, b);
+            }
+            X_TARGET("avx2") static Vec And(Vec a, Vec b) {
+                return _mm256_and_si256(a, b);
+            }
+            X_TARGET("avx2") static Vec Or(Vec a, Vec b) {
+                return _mm256_or_si256(a, b);
+            }
+            X_TARGET("avx2") static Vec Xor(Vec a, Vec b) {
+                return _mm256_xor_si256(a, b);
+            }
+            X_TARGET("avx2") static bool Any(Vec v) {
+                return !_mm256_testz_si256(v, v);
+            }
+            X_TARGET("avx2") static bool IsAscii(Vec v) {
+                return _mm256_movemask_epi8(v) == 0;
+            }
+        };
+
+        struct Utf8LanesSsse3 {
+            using Vec                     = __m128i;
+            static constexpr size_t kWidth = 16;
+
+            X_TARGET("ssse3") static Vec Load(const u8* p) {
+                return _mm_loadu_si128(RCAST<const __m128i*>(p));
+            }
+            X_TARGET("ssse3") static Vec Splat(u8 v) {
+                return _mm_set1_epi8(CAST<char>(v));
+            }
+            X_TARGET("ssse3") static Vec Table(const u8* t) {
+                return Load(t);
+            }
+            X_TARGET("ssse3") static Vec Lookup(Vec table, Vec index) {
+                return _mm_shuffle_epi8(table, index);
+            }
+            X_TARGET("ssse3") static Vec HighNibble(Vec v) {
+                return _mm_and_si128(_mm_srli_epi16(v, 4), Splat(0x0F));
+            }
+            X_TARGET("ssse3") static Vec LowNibble(Vec v) {
+                return _mm_and_si128(v, Splat(0x0F));
+            }
+            template<int N>
+            X_TARGET("ssse3") static Vec Prev(Vec current, Vec previous) {
+                return _mm_alignr_epi8(current, previous, 16 - N);
+            }
+            X_TARGET("ssse3") static Vec SubSat(Vec a, Vec b) {
+                return _mm_subs_epu8(a, b);
+            }
+            X_TARGET("ssse3") static Vec And(Vec a, Vec b) {
+                return _mm_and_si128(a, b);
+            }
+            X_TARGET("ssse3") static Vec Or(Vec a, Vec b) {
+                return _mm_or_si128(a, b);
+            }
+            X_TARGET("ssse3") static Vec Xor(Vec a, Vec b) {
+                return _mm_xor_si128(a, b);
+            }
+            X_TARGET("ssse3") static bool Any(Vec v) {
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF;
+            }
+            X_TARGET("ssse3") static bool IsAscii(Vec v) {
+                return _mm_movemask_epi8(v) == 0;
+            }
+        };
+    #else
+        struct Utf8LanesNeon {
+            using Vec                     = uint8x16_t;
+            static constexpr size_t kWidth = 16;
+
+            static Vec Load(const u8* p) {
+                return vld1q_u8(p);
+            }
+            static Vec Splat(u8 v) {
+                return vdupq_n_u8(v);
+            }
+            static Vec Table(const u8* t) {
+                return vld1q_u8(t);
+            }
+            static Vec Lookup(Vec table, Vec index) {
+                return vqtbl1q_u8(table, index);
+            }
+            static Vec HighNibble(Vec v) {
+                return vshrq_n_u8(v, 4);
+            }
+            static Vec LowNibble(Vec v) {
+                return vandq_u8(v, Splat(0x0F));
+            }
+            template<int N>
+            static Vec Prev(Vec current, Vec previous) {
+                return vextq_u8(previous, current, 16 - N);
+            }
+            static Vec SubSat(Vec a, Vec b) {
+                return vqsubq_u8(a, b);
+            }
+            static Vec And(Vec a, Vec b) {
+                return vandq_u8(a, b);
+            }
+            static Vec Or(Vec a, Vec b) {
+                return vorrq_u8(a, b);
+            }
+            static Vec Xor(Vec a, Vec b) {
+                return veorq_u8(a, b);
+            }
+            static bool Any(Vec v) {
+                return vmaxvq_u8(v) != 0;
+            }
+            static bool IsAscii(Vec v) {
+                return vmaxvq_u8(v) < 0x80;
+            }
+        };
+    #endif
+
+        /// Lookup tables for Keiser & Lemire's validator, indexed by one nibble of a byte or of its predecessor; each
+        /// entry holds the error classes that nibble allows
+        struct Utf8ErrorTables {
+            static constexpr u8 kTooShort   = 1 << 0;
+            static constexpr u8 kTooLong    = 1 << 1;
+            static constexpr u8 kOverlong3  = 1 << 2;
+            static constexpr u8 kTooLarge   = 1 << 3;
+            static constexpr u8 kSurrogate  = 1 << 4;
+            static constexpr u8 kOverlong2  = 1 << 5;
+            static constexpr u8 kTooLarge1k = 1 << 6;
+            static constexpr u8 kOverlong4  = 1 << 6;
+            static constexpr u8 kTwoConts   = 1 << 7;
+            static constexpr u8 kCarry      = kTooShort | kTooLong | kTwoConts;
+            static constexpr u8 kBig        = kCarry | kTooLarge | kTooLarge1k;
+            static constexpr u8 kCont       = kTooLong | kOverlong2 | kTwoConts;
+
+            alignas(16) static constexpr u8 kByte1High[16] = {
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTooLong,
+              kTwoConts,
+              kTwoConts,
+              kTwoConts,
+              kTwoConts,
+              kTooShort | kOverlong2,
+              kTooShort,
+              kTooShort | kOverlong3 | kSurrogate,
+              kTooShort | kTooLarge | kTooLarge1k | kOverlong4,
+            };
+            alignas(16) static constexpr u8 kByte1Low[16] = {
+              kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+              kCarry | kOverlong2,
+              kCarry,
+              kCarry,
+              kCarry | kTooLarge,
+              kBig,
+              kBig,
+              kBig,
+              kBig,
+              kBig,
+              kBig,
+              kBig,
+              kBig,
+              kBig | kSurrogate,
+              kBig,
+              kBig,
+            };
+            alignas(16) static constexpr u8 kByte2High[16] = {
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kCont | kOverlong3 | kTooLarge1k | kOverlong4,
+              kCont | kOverlong3 | kTooLarge,
+              kCont | kSurrogate | kTooLarge,
+              kCont | kSurrogate | kTooLarge,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+              kTooShort,
+            };
+            // A lead in the last three lanes whose sequence has not finished inside the block
+            alignas(32) static constexpr u8 kIncomplete[32] = {
+              0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+              0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+            };
+        };
+
+        /// Keiser & Lemire's lookup validator over the lanes `L`: three 16-entry tables indexed by the nibbles of
+        /// each byte and its predecessor flag every error that spans two bytes, and a saturating subtract on the
+        /// bytes two and three back catches missing or surplus continuations. Returns the offset of the first block
+        /// with an error (which may have started in the block before it), or npos.
+        ///
+        /// A macro rather than a template so each kernel below carries its own X_TARGET: vectors must only live in
+        /// functions compiled for their instruction set, whatever the optimization level.
+    #define X_UTF8_BLOCK_KERNEL(L)                                                                                     \
+        using Vec = L::Vec;                                                                                            \
+        using T   = Utf8ErrorTables;                                                                                   \
+                                                                                                                       \
+        const Vec byte1High  = L::Table(T::kByte1High);                                                                \
+        const Vec byte1Low   = L::Table(T::kByte1Low);                                                                 \
+        const Vec byte2High  = L::Table(T::kByte2High);                                                                \
+        const Vec incomplete = L::Load(T::kIncomplete + 32 - L::kWidth);                                               \
+        const Vec highBit    = L::Splat(0x80);                                                                         \
+                                                                                                                       \
+        Vec previous           = L::Splat(0);                                                                          \
+        Vec previousIncomplete = L::Splat(0);                                                                          \
+                                                                                                                       \
+        /* Zero padding turns a sequence cut off by the end of input into an ordinary too-short error */               \
+        alignas(32) u8 tail[L::kWidth] = {};                                                                           \
+        for (size_t i = 0;; i += L::kWidth) {                                                                          \
+            const bool last = i + L::kWidth > size;                                                                    \
+            if (last) { std::memcpy(tail, data + i, size - i); }                                                       \
+            const Vec input = L::Load(last ? tail : data + i);                                                         \
+                                                                                                                       \
+            Vec error = previousIncomplete;                                                                            \
+            if (!L::IsAscii(input)) {                                                                                  \
+                const Vec prev1   = L::template Prev<1>(input, previous);                                              \
+                const Vec high1   = L::Lookup(byte1High, L::HighNibble(prev1));                                        \
+                const Vec low1    = L::Lookup(byte1Low, L::LowNibble(prev1));                                          \
+                const Vec special = L::And(L::And(high1, low1), L::Lookup(byte2High, L::HighNibble(input)));           \
+                /* Only 111xxxxx two back or 1111xxxx three back stay >= 0x80; those need a continuation here */       \
+                const Vec third  = L::SubSat(L::template Prev<2>(input, previous), L::Splat(0xE0 - 0x80));             \
+                const Vec fourth = L::SubSat(L::template Prev<3>(input, previous), L::Splat(0xF0 - 0x80));             \
+                error            = L::Xor(L::And(L::Or(third, fourth), highBit), special);                             \
+            }                                                                                                          \
+            if (L::Any(error)) { return i; }                                                                           \
+            if (last) { return str::npos; }                                                                            \
+            previousIncomplete = L::SubSat(input, incomplete);                                                         \
+            previous           = input;                                                                                \
+        }
+
+    #if defined(X_ARCH_X86)
+        X_TARGET("ssse3") inline size_t FindInvalidUtf8BlockSsse3(const u8* data, size_t size) {
+            X_UTF8_BLOCK_KERNEL(Utf8LanesSsse3)
+        }
+
+        X_TARGET("avx2") inline size_t FindInvalidUtf8BlockAvx2(const u8* data, size_t size) {
+            X_UTF8_BLOCK_KERNEL(Utf8LanesAvx2)
+        }
+    #else
+        inline size_t FindInvalidUtf8BlockNeon(const u8* data, size_t size) {
+            X_UTF8_BLOCK_KERNEL(Utf8LanesNeon)
+        }
+    #endif
+    #undef X_UTF8_BLOCK_KERNEL
+#endif
+
+        using FindInvalidUtf8BlockFn = size_t (*)(const u8*, size_t);
+
+        /// Without a vector kernel the first block is always reported, which sends the whole input to the scalar
+        /// check
+        inline CpuDispatch<FindInvalidUtf8BlockFn> gFindInvalidUtf8Block {+[]() -> FindInvalidUtf8BlockFn {
+#if defined(X_ARCH_X86)
+            return CpuSelect<FindInvalidUtf8BlockFn>(
+              {
+                {CpuMask({CpuFeature::Avx2}), FindInvalidUtf8BlockAvx2},
+                {CpuMask({CpuFeature::Ssse3}), FindInvalidUtf8BlockSsse3},
+              },
+              [](const u8*, size_t) { return size_t(0); });
+#elif defined(X_SIMD_NEON)
+            return FindInvalidUtf8BlockNeon;
+#else
+            return [](const u8*, size_t) { return size_t(0); };
+#endif
+        }};
+    }  // namespace detail
+
+    /// @brief Returns the offset of the first byte that does not begin a valid UTF-8 sequence (truncated, overlong,
+    /// surrogate or above U+10FFFF), or npos if all of `input` is valid.
+    inline size_t FindInvalidUtf8(strview input) {
+        const u8* data     = RCAST<const u8*>(input.data());
+        const size_t size  = input.size();
+        const size_t block = detail::gFindInvalidUtf8Block(data, size);
+        if (block == str::npos) { return str::npos; }
+
+        // Everything before the block checked out, so any continuation bytes at the block's edge belong to a
+        // sequence that started (and ended) earlier; pin the exact offset from the first boundary after them
+        size_t start = block > 3 ? block - 3 : 0;
+        while (start < block && detail::IsContinuation(data[start])) { ++start; }
+        return detail::FindInvalidUtf8Scalar(data, size, start);
+    }
+
+    inline bool IsValidUtf8(strview input) {
+        return FindInvalidUtf8(input) == str::npos;
+    }
+
+    enum class ParseError : u8 {
+        None,
+        NoDigits,          // A number was expected but none was found
+        InvalidCharacter,  // Something other than the number's own characters
+        OutOfRange,        // Well-formed, but does not fit the target type
+        ColumnCount,       // ParseColumns: a row has more or fewer fields than asked for
+    };
+
+    /// @brief Outcome of a parse. On success `position` is how many characters were consumed; on failure it is the
+    /// offset of the offending character (or of the number's first character, for OutOfRange).
+    struct ParseResult {
+        ParseError error = ParseError::None;
+        size_t position  = 0;
+
+        explicit operator bool() const {
+            return error == ParseError::None;
+        }
+    };
+
+    namespace detail {
+        inline u64 LoadEightBytes(const char* text) {
+            u64 value = 0;
+            if constexpr (std::endian::native == std::endian::little) {
+                std::memcpy(&value, text, sizeof(value));
+            } else {
+                for (u32 i = 0; i < 8; ++i) {
+                    value |= CAST<u64>(CAST<u8>(text[i])) << (i * 8);
+                }
+            }
+            return value;
+        }
+
+        // SWAR digit test: '0'..'9' are 0x30..0x39, so the high nibble must be 3 and adding 6 must not carry into it
+        inline bool IsEightDigits(u64 chunk) {
+            const u64 highNibbles = chunk & 0xF0F0F0F0F0F0F0F0ULL;
+            const u64 carries     = ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4;
+            return (highNibbles | carries) == 0x3333333333333333ULL;
+        }
+
+        // Eight ASCII digits (first digit in the low byte) to their value in three multiplies instead of eight:
+        // adjacent digits combine into pairs, pairs into groups of four, then the two halves
+        inline u32 ParseEightDigits(u64 chunk) {
+            constexpr u64 kMask = 0x000000FF000000FFULL;
+            constexpr u64 kMul1 = 100 + (1000000ULL << 32);
+            constexpr u64 kMul2 = 1 + (10000ULL << 32);
+            chunk -= 0x3030303030303030ULL;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+            return CAST<u32>(chunk);
+        }
+
+        inline bool IsDigit(char c) {
+            return CAST<u8>(c - '0') <= 9;
+        }
+
+        /// Accumulates the digits at `pos` into `mantissa`, eight at a time where possible. Digits beyond the 19 that
+        /// always fit in a u64 are consumed but only flagged in `overflow`.
+        inline void TakeDigits(strview text, size_t& pos, u64& mantissa, u32& digits, bool& overflow) {
+            while (pos + 8 <= text.size()) {
+                const u64 chunk = LoadEightBytes(text.data() + pos);
+                if (!IsEightDigits(chunk)) { break; }
+                if (digits + 8 <= 19) {
+                    mantissa = mantissa * 100000000 + ParseEightDigits(chunk);
+                    digits += 8;
+                } else {
+                    overflow = true;
+                }
+                pos += 8;
+            }
+            for (; pos < text.size() && IsDigit(text[pos]); ++pos) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + CAST<u64>(text[pos] - '0');
+                    ++digits;
+                } else {
+                    overflow = true;
+                }
+            }
+        }
+
+        // Powers of ten a float/double represents exactly, for the exact-arithmetic fast path
+        template<typename T>
+        struct ExactFloat;
+
+        template<>
+        struct ExactFloat<double> {
+            static constexpr u64 kMaxMantissa = 1ULL << 53;
+            static constexpr double kPowers[] =
+              {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+               1e18, 1e19, 1e20, 1e21, 1e22};
+        };
+
+        template<>
+        struct ExactFloat<float> {
+            static constexpr u64 kMaxMantissa = 1ULL << 24;
+            static constexpr float kPowers[]  = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        };
+    }  // namespace detail
+
+    /// @brief Parses all of `text` as a decimal integer with an optional sign, e.g. for fields of a line read with
+    /// StreamReader::ReadLine. Unlike std::stoi it never throws, ignores the locale and rejects trailing characters.
+    template<typename T>
+        requires(std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(u64))
+    ParseResult ParseInteger(strview text, T& value) {
+        size_t pos    = 0;
+        bool negative = false;
+        if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+            negative = text[0] == '-';
+            if (negative && !std::is_signed_v<T>) { return {ParseError::InvalidCharacter, 0}; }
+            pos = 1;
+        }
+
+        const size_t digitsStart = pos;
+        while (pos < text.size() && text[pos] == '0') { ++pos; }  // Leading zeros never overflow
+        const size_t significantStart = pos;
+
+        u64 magnitude = 0;
+        u32 digits    = 0;
+        bool overflow = false;
+        detail::TakeDigits(text, pos, magnitude, digits, overflow);
+        if (pos == digitsStart) { return {ParseError::NoDigits, pos}; }
+        if (pos != text.size()) { return {ParseError::InvalidCharacter, pos}; }
+
+        // A 20th digit still fits a u64 if it does not carry past 2^64 - 1
+        if (overflow && pos - significantStart == 20) {
+            const u64 last = CAST<u64>(text[pos - 1] - '0');
+            if (magnitude <= (UINT64_MAX - last) / 10) {
+                magnitude = magnitude * 10 + last;
+                overflow  = false;
+            }
+        }
+
+        constexpr u64 kMax = CAST<u64>(std::numeric_limits<T>::max());
+        if (overflow || magnitude > kMax + (negative ? 1 : 0)) { return {ParseError::OutOfRange, 0}; }
+        value = negative ? CAST<T>(0 - magnitude) : CAST<T>(magnitude);
+        return {ParseError::None, pos};
     }
-}
\ No newline at end of file
+
+    /// @brief Parses all of `text` as a decimal floating-point number: an optional sign, digits with an optional
+    /// fraction, and an optional exponent, or inf/nan. Results are correctly rounded.
+    ///
+    /// Mantissas of up to 2^53 (2^24 for float) with exponents within the range where powers of ten are exact take
+    /// a single multiply or divide, which IEEE arithmetic rounds correctly (Clinger's fast path). That covers most
+    /// real-world data; everything else goes to std::from_chars, which is correctly rounded on every standard
+    /// library we build with.
+    template<typename T>
+        requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+    ParseResult ParseFloat(strview text, T& value) {
+        size_t pos    = 0;
+        bool negative = false;
+        if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+            negative = text[0] == '-';
+            pos      = 1;
+        }
+        const size_t numberStart = pos;
+
+        u64 mantissa  = 0;
+        u32 digits    = 0;
+        bool overflow = false;
+        detail::TakeDigits(text, pos, mantissa, digits, overflow);
+        size_t digitCount = pos - numberStart;
+        i64 exponent      = 0;
+        if (pos < text.size() && text[pos] == '.') {
+            const size_t fractionStart = ++pos;
+            detail::TakeDigits(text, pos, mantissa, digits, overflow);
+            digitCount += pos - fractionStart;
+            exponent -= CAST<i64>(pos - fractionStart);
+        }
+
+        if (digitCount == 0) {
+            // inf, infinity and nan in any case
+            const auto result = std::from_chars(text.data() + (negative ? 0 : numberStart), text.data() + text.size(),
+                                                value);
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+                return {ParseError::NoDigits, numberStart};
+            }
+            return {ParseError::None, text.size()};
+        }
+
+        if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+            ++pos;
+            bool negativeExponent = false;
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) { negativeExponent = text[pos++] == '-'; }
+            if (pos == text.size() || !detail::IsDigit(text[pos])) { return {ParseError::NoDigits, pos}; }
+            i64 written = 0;
+            for (; pos < text.size() && detail::IsDigit(text[pos]); ++pos) {
+                if (written < 100000) { written = written * 10 + (text[pos] - '0'); }  // Far beyond any double
+            }
+            exponent += negativeExponent ? -written : written;
+        }
+        if (pos != text.size()) { return {ParseError::InvalidCharacter, pos}; }
+
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0  // x87 extended precision would round twice
+        using Exact                = detail::ExactFloat<T>;
+        constexpr i64 kMaxExponent = CAST<i64>(X_ARRAY_SIZE(Exact::kPowers)) - 1;
+        if (!overflow && mantissa <= Exact::kMaxMantissa && exponent >= -kMaxExponent && exponent <= kMaxExponent) {
+            T result = CAST<T>(mantissa);
+            result   = exponent < 0 ? result / Exact::kPowers[-exponent] : result * Exact::kPowers[exponent];
+            value    = negative ? -result : result;
+            return {ParseError::None, pos};
+        }
+#endif
+
+        // std::from_chars takes a leading minus but not a plus
+        const char* first = text.data() + (negative ? 0 : numberStart);
+        T result {};
+        const auto parsed = std::from_chars(first, text.data() + text.size(), result);
+        if (parsed.ec == std::errc::result_out_of_range) { return {ParseError::OutOfRange, 0}; }
+        if (parsed.ec != std::errc() || parsed.ptr != text.data() + text.size()) {
+            return {ParseError::InvalidCharacter, CAST<size_t>(parsed.ptr - text.data())};
+        }
+        value = result;
+        return {ParseError::None, pos};
+    }
+
+    /// @brief Rows parsed by ParseColumns and how the batch ended
+    struct ColumnParseResult {
+        size_t rows = 0;
+        ParseResult status;
+    };
+
+    /// @brief Parses lines of `columns` numbers separated by `delimiter` straight out of `buffer` into `out`, row
+    /// after row, with no per-field strings.
+    ///
+    /// Lines end in "\n" or "\r\n"; blank lines are skipped and the last line needs no terminator. Parsing stops at
+    /// the end of `buffer`, at the first error, or once `out` has no room for another row; `status.position` is
+    /// then the buffer offset to resume from (on success) or of the problem (on failure), so a file can be fed
+    /// through a fixed-size `out` in batches.
+    template<typename T, size_t Extent>
+    ColumnParseResult ParseColumns(std::span<const char> buffer,
+                                   char delimiter,
+                                   size_t columns,
+                                   std::span<T, Extent> out) {
+        ColumnParseResult result;
+        if (columns == 0) { return result; }
+
+        const strview text(buffer.data(), buffer.size());
+        size_t pos = 0;
+        while (pos < text.size() && (result.rows + 1) * columns <= out.size()) {
+            if (text[pos] == '\n' || text[pos] == '\r') {  // Blank line
+                ++pos;
+                continue;
+            }
+
+            T* row = out.data() + result.rows * columns;
+            for (size_t column = 0; column < columns; ++column) {
+                size_t end = pos;
+                while (end < text.size() && text[end] != delimiter && text[end] != '\n' && text[end] != '\r') {
+                    ++end;
+                }
+
+                const strview field = text.substr(pos, end - pos);
+                ParseResult parsed;
+                if constexpr (std::is_floating_point_v<T>) {
+                    parsed = ParseFloat(field, row[column]);
+                } else {
+                    parsed = ParseInteger(field, row[column]);
+                }
+                if (!parsed) {
+                    result.status = {parsed.error, pos + parsed.position};
+                    return result;
+                }
+
+                // Every field but the last must be followed by a delimiter, and the last by the end of the line
+                pos                    = end;
+                const bool atDelimiter = pos < text.size() && text[pos] == delimiter;
+                if (atDelimiter == (column + 1 == columns)) {
+                    result.status = {ParseError::ColumnCount, pos};
+                    return result;
+                }
+                if (atDelimiter) { ++pos; }
+            }
+
+            if (pos < text.size() && text[pos] == '\r') { ++pos; }
+            if (pos < text.size() && text[pos] == '\n') { ++pos; }
+            ++result.rows;
+        }
+
+        result.status = {ParseError::None, pos};
+        return result;
+    }
+
+    namespace detail {
+        /// A set of bytes to search for. Sets of up to kVectorChars bytes (a delimiter plus quote and escape, or the
+        /// ASCII whitespace) are matched a vector at a time, one compare per member; larger sets use a bitmap.
+        class ByteSet {
+        public:
+            static constexpr u32 kVectorChars = 8;
+
+            constexpr ByteSet() = default;
+
+            constexpr explicit ByteSet(strview chars) {
+                for (const char c : chars) {
+                    Add(c);
+                }
+            }
+
+            constexpr void Add(char c) {
+                if (Contains(c)) { return; }
+                const u8 byte = CAST<u8>(c);
+                mBits[byte >> 6] |= X_BIT(byte & 63);
+                if (mCount < kVectorChars) { mChars[mCount] = c; }
+                ++mCount;
+            }
+
+            X_NODISCARD constexpr bool Contains(char c) const {
+                const u8 byte = CAST<u8>(c);
+                return (mBits[byte >> 6] & X_BIT(byte & 63)) != 0;
+            }
+
+            X_NODISCARD constexpr bool Empty() const {
+                return mCount == 0;
+            }
+
+            X_NODISCARD constexpr u32 Count() const {
+                return mCount;
+            }
+
+            /// Offset of the first byte at or after `pos` that is in the set, or npos
+            X_NODISCARD size_t FindFirst(strview text, size_t pos) const {
+                const char* data  = text.data();
+                const size_t size = text.size();
+                if (mCount == 0 || pos >= size) { return strview::npos; }
+                if (mCount == 1) {
+                    const void* found = std::memchr(data + pos, mChars[0], size - pos);
+                    return found ? CAST<size_t>(CAST<const char*>(found) - data) : strview::npos;
+                }
+
+                size_t i = pos;
+                if (mCount <= kVectorChars) {
+                    // Unused compare slots repeat the first member, so every iteration does the same work
+                    char chars[kVectorChars];
+                    for (u32 k = 0; k < kVectorChars; ++k) {
+                        chars[k] = mChars[k < mCount ? k : 0];
+                    }
+#if defined(X_SIMD_SSE2)
+                    __m128i splats[kVectorChars];
+                    for (u32 k = 0; k < kVectorChars; ++k) {
+                        splats[k] = _mm_set1_epi8(chars[k]);
+                    }
+                    for (; i + 16 <= size; i += 16) {
+                        const __m128i v = _mm_loadu_si128(RCAST<const __m128i*>(data + i));
+                        __m128i hits    = _mm_cmpeq_epi8(v, splats[0]);
+                        for (u32 k = 1; k < kVectorChars; ++k) {
+                            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, splats[k]));
+                        }
+                        const u32 mask = CAST<u32>(_mm_movemask_epi8(hits));
+                        if (mask) { return i + CAST<size_t>(std::countr_zero(mask)); }
+                    }
+#elif defined(X_SIMD_NEON)
+                    uint8x16_t splats[kVectorChars];
+                    for (u32 k = 0; k < kVectorChars; ++k) {
+                        splats[k] = vdupq_n_u8(CAST<u8>(chars[k]));
+                    }
+                    for (; i + 16 <= size; i += 16) {
+                        const uint8x16_t v = vld1q_u8(RCAST<const u8*>(data + i));
+                        uint8x16_t hits    = vceqq_u8(v, splats[0]);
+                        for (u32 k = 1; k < kVectorChars; ++k) {
+                            hits = vorrq_u8(hits, vceqq_u8(v, splats[k]));
+                        }
+                        const u64 mask = NeonMask(hits);
+                        if (mask) { return i + CAST<size_t>(std::countr_zero(mask)) / 4; }
+                    }
+#endif
+                }
+                for (; i < size; ++i) {
+                    if (Contains(data[i])) { return i; }
+                }
+                return strview::npos;
+            }
+
+        private:
+            u64 mBits[4] {};
+            char mChars[kVectorChars] {};
+            u32 mCount = 0;
+        };
+
+        struct SplitOnChar {
+            char delimiter;
+
+            X_NODISCARD bool MatchAt(strview text, size_t pos) const {
+                return text[pos] == delimiter;
+            }
+
+            X_NODISCARD size_t Length() const {
+                return 1;
+            }
+
+            void AddStarts(ByteSet& set) const {
+                set.Add(delimiter);
+            }
+        };
+
+        struct SplitOnAny {
+            ByteSet delimiters;
+
+            X_NODISCARD bool MatchAt(strview text, size_t pos) const {
+                return delimiters.Contains(text[pos]);
+            }
+
+            X_NODISCARD size_t Length() const {
+                return 1;
+            }
+
+            void AddStarts(ByteSet& set) const {
+                for (u32 c = 0; c < 256; ++c) {
+                    if (delimiters.Contains(CAST<char>(c))) { set.Add(CAST<char>(c)); }
+                }
+            }
+        };
+
+        struct SplitOnString {
+            strview delimiter;
+
+            X_NODISCARD bool MatchAt(strview text, size_t pos) const {
+                return text.substr(pos, delimiter.size()) == delimiter;
+            }
+
+            X_NODISCARD size_t Length() const {
+                return delimiter.size();
+            }
+
+            void AddStarts(ByteSet& set) const {
+                if (!delimiter.empty()) { set.Add(delimiter[0]); }
+            }
+        };
+    }  // namespace detail
+
+    /// @brief How Split treats quotes and escapes. Both are off by default.
+    struct SplitOptions {
+        /// Delimiters between a pair of these are part of the field, and a field wrapped in them is yielded without
+        /// them. A doubled quote inside a quoted field (the CSV escape) stays in the view as-is.
+        char quote = '\0';
+
+        /// The character after this one never counts as a delimiter or quote. The escape stays in the view.
+        char escape = '\0';
+
+        /// Leave out empty fields, e.g. to split on runs of whitespace
+        bool skipEmpty = false;
+    };
+
+    /// @brief Lazy range of the fields of a string, as views into it; see Split and SplitAny.
+    ///
+    /// Nothing is allocated or copied: each step searches for the next delimiter (together with any quote and
+    /// escape characters) a vector at a time and yields the span before it. N delimiters give N + 1 fields, so
+    /// "a,,b" yields "a", "" and "b", while an empty string yields nothing. The views point into the original text,
+    /// which must outlive them.
+    template<typename Delimiter>
+    class SplitRange {
+    public:
+        class Iterator {
+        public:
+            using value_type        = strview;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            Iterator() = default;
+
+            explicit Iterator(const SplitRange* range) : mRange(range) {
+                Advance();
+            }
+
+            strview operator*() const {
+                return mField;
+            }
+
+            Iterator& operator++() {
+                Advance();
+                return *this;
+            }
+
+            void operator++(int) {
+                Advance();
+            }
+
+            friend bool operator==(const Iterator& it, std::default_sentinel_t) {
+                return it.mDone;
+            }
+
+        private:
+            const SplitRange* mRange = nullptr;
+            size_t mNext             = 0;  // Start of the next field; past the end once the last one is out
+            strview mField;
+            bool mDone = true;
+
+            void Advance() {
+                const strview text = mRange->mText;
+                do {
+                    if (mNext > text.size() || text.empty()) {
+                        mDone = true;
+                        return;
+                    }
+                    const size_t start = mNext;
+                    const size_t end   = mRange->FindDelimiter(start);
+                    mField             = mRange->Unquote(text.substr(start, end - start));
+                    mNext              = end == text.size() ? end + 1 : end + mRange->mDelimiter.Length();
+                    mDone              = false;
+                } while (mField.empty() && mRange->mOptions.skipEmpty);
+            }
+        };
+
+        SplitRange(strview text, Delimiter delimiter, SplitOptions options)
+            : mText(text), mDelimiter(delimiter), mOptions(options) {
+            mDelimiter.AddStarts(mSpecial);
+            if (options.quote != '\0') { mSpecial.Add(options.quote); }
+            if (options.escape != '\0') { mSpecial.Add(options.escape); }
+        }
+
+        Iterator begin() const {
+            return Iterator(this);
+        }
+
+        std::default_sentinel_t end() const {
+            return {};
+        }
+
+    private:
+        strview mText;
+        Delimiter mDelimiter;
+        SplitOptions mOptions;
+        detail::ByteSet mSpecial;  // Bytes that can start a delimiter, plus the quote and escape
+
+        // Offset of the next delimiter outside quotes, or the end of the text
+        size_t FindDelimiter(size_t pos) const {
+            if (mDelimiter.Length() == 0) { return mText.size(); }
+            bool quoted = false;
+            for (;;) {
+                pos = mSpecial.FindFirst(mText, pos);
+                if (pos == strview::npos) { return mText.size(); }
+
+                const char c = mText[pos];
+                if (c == mOptions.escape && mOptions.escape != '\0') {
+                    pos += 2;
+                } else if (c == mOptions.quote && mOptions.quote != '\0') {
+                    quoted = !quoted;
+                    ++pos;
+                } else if (!quoted && mDelimiter.MatchAt(mText, pos)) {
+                    return pos;
+                } else {
+                    ++pos;
+                }
+            }
+        }
+
+        strview Unquote(strview field) const {
+            const char quote = mOptions.quote;
+            if (quote != '\0' && field.size() >= 2 && field.front() == quote && field.back() == quote) {
+                return field.substr(1, field.size() - 2);
+            }
+            return field;
+        }
+    };
+
+    /// @brief Splits `text` on every occurrence of `delimiter`, lazily:
+    ///
+    ///     for (strview field : Split(line, ',', {.quote = '"'})) { ... }
+    inline SplitRange<detail::SplitOnChar> Split(strview text, char delimiter, SplitOptions options = {}) {
+        return {text, {delimiter}, options};
+    }
+
+    /// @brief Splits `text` on every occurrence of the string `delimiter`. An empty delimiter never matches.
+    inline SplitRange<detail::SplitOnString> Split(strview text, strview delimiter, SplitOptions options = {}) {
+        return {text, {delimiter}, options};
+    }
+
+    /// @brief Splits `text` wherever any one of the characters in `delimiters` occurs, e.g. SplitAny(text, " \t",
+    /// {.skipEmpty = true}) for whitespace-separated words.
+    inline SplitRange<detail::SplitOnAny> SplitAny(strview text, strview delimiters, SplitOptions options = {}) {
+        return {text, {detail::ByteSet(delimiters)}, options};
+    }
+
+    namespace detail {
+        // Substring kernels take a needle of at least two bytes and return the offset of the first match, or npos.
+        // The vector loops compare the needle's first and last bytes against a whole register of candidate starts
+        // at once and only memcmp the middle of starts where both agree, which on real text is almost never a
+        // false positive; the loops stop while a full register of candidates plus the needle still fits, and the
+        // scalar search finishes the tail.
+        inline size_t FindSubstringScalar(const char* data, size_t size, const char* needle, size_t length,
+                                          size_t from = 0) {
+            const char* last = data + size - length;  // Last possible start
+            for (const char* p = data + from; p <= last;) {
+                p = CAST<const char*>(std::memchr(p, needle[0], CAST<size_t>(last - p) + 1));
+                if (!p) { break; }
+                if (p[length - 1] == needle[length - 1] && std::memcmp(p + 1, needle + 1, length - 2) == 0) {
+                    return CAST<size_t>(p - data);
+                }
+                ++p;
+            }
+            return strview::npos;
+        }
+
+#if defined(X_SIMD_SSE2)
+        inline size_t FindSubstringSse2(const char* data, size_t size, const char* needle, size_t length) {
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i last  = _mm_set1_epi8(needle[length - 1]);
+            size_t i            = 0;
+            for (; i + length - 1 + 16 <= size; i += 16) {
+                const __m128i starts = _mm_loadu_si128(RCAST<const __m128i*>(data + i));
+                const __m128i ends   = _mm_loadu_si128(RCAST<const __m128i*>(data + i + length - 1));
+                u32 mask             = CAST<u32>(
+                  _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(starts, first), _mm_cmpeq_epi8(ends, last))));
+                while (mask) {
+                    const size_t at = i + CAST<size_t>(std::countr_zero(mask));
+                    if (std::memcmp(data + at + 1, needle + 1, length - 2) == 0) { return at; }
+                    mask &= mask - 1;
+                }
+            }
+            return FindSubstringScalar(data, size, needle, length, i);
+        }
+#elif defined(X_SIMD_NEON)
+        inline size_t FindSubstringNeon(const char* data, size_t size, const char* needle, size_t length) {
+            const uint8x16_t first = vdupq_n_u8(CAST<u8>(needle[0]));
+            const uint8x16_t last  = vdupq_n_u8(CAST<u8>(needle[length - 1]));
+            size_t i               = 0;
+            for (; i + length - 1 + 16 <= size; i += 16) {
+                const uint8x16_t starts = vld1q_u8(RCAST<const u8*>(data + i));
+                const uint8x16_t ends   = vld1q_u8(RCAST<const u8*>(data + i + length - 1));
+                u64 mask                = NeonMask(vandq_u8(vceqq_u8(starts, first), vceqq_u8(ends, last)));
+                while (mask) {
+                    const u32 bit   = CAST<u32>(std::countr_zero(mask));
+                    const size_t at = i + bit / 4;
+                    if (std::memcmp(data + at + 1, needle + 1, length - 2) == 0) { return at; }
+                    mask &= ~(CAST<u64>(0xF) << (bit & ~3u));
+                }
+            }
+            return FindSubstringScalar(data, size, needle, length, i);
+        }
+#endif
+
+#if defined(X_ARCH_X86)
+        X_TARGET("avx2")
+        inline size_t FindSubstringAvx2(const char* data, size_t size, const char* needle, size_t length) {
+            const __m256i first = _mm256_set1_epi8(needle[0]);
+            const __m256i last  = _mm256_set1_epi8(needle[length - 1]);
+            size_t i            = 0;
+            for (; i + length - 1 + 32 <= size; i += 32) {
+                const __m256i starts = _mm256_loadu_si256(RCAST<const __m256i*>(data + i));
+                const __m256i ends   = _mm256_loadu_si256(RCAST<const __m256i*>(data + i + length - 1));
+                u32 mask             = CAST<u32>(_mm256_movemask_epi8(
+                  _mm256_and_si256(_mm256_cmpeq_epi8(starts, first), _mm256_cmpeq_epi8(ends, last))));
+                while (mask) {
+                    const size_t at = i + CAST<size_t>(std::countr_zero(mask));
+                    if (std::memcmp(data + at + 1, needle + 1, length - 2) == 0) { return at; }
+                    mask &= mask - 1;
+                }
+            }
+            return FindSubstringScalar(data, size, needle, length, i);
+        }
+#endif
+
+        using FindSubstringFn = size_t (*)(const char*, size_t, const char*, size_t);
+
+        inline CpuDispatch<FindSubstringFn> gFindSubstring {+[]() -> FindSubstringFn {
+#if defined(X_SIMD_SSE2)
+            constexpr FindSubstringFn baseline = FindSubstringSse2;
+#elif defined(X_SIMD_NEON)
+            constexpr FindSubstringFn baseline = FindSubstringNeon;
+#else
+            constexpr FindSubstringFn baseline = [](const char* data, size_t size, const char* needle, size_t length) {
+                return FindSubstringScalar(data, size, needle, length);
+            };
+#endif
+#if defined(X_ARCH_X86)
+            return CpuSelect<FindSubstringFn>({{CpuMask({CpuFeature::Avx2}), FindSubstringAvx2}}, baseline);
+#else
+            return baseline;
+#endif
+        }};
+    }  // namespace detail
+
+    /// @brief Offset of the first occurrence of `needle` in `haystack` at or after `pos`, or npos. An empty needle
+    /// matches at `pos`. Tests 16 or 32 candidate starts per step, so long haystacks search several times faster
+    /// than with std::string::find.
+    inline size_t FindSubstring(std::span<const char> haystack, strview needle, size_t pos = 0) {
+        const size_t size = haystack.size();
+        if (pos > size || needle.size() > size - pos) { return strview::npos; }
+        if (needle.empty()) { return pos; }
+
+        const char* data = haystack.data() + pos;
+        size_t found;
+        if (needle.size() == 1) {
+            const void* hit = std::memchr(data, needle[0], size - pos);
+            found           = hit ? CAST<size_t>(CAST<const char*>(hit) - data) : strview::npos;
+        } else {
+            found = detail::gFindSubstring(data, size - pos, needle.data(), needle.size());
+        }
+        return found == strview::npos ? found : pos + found;
+    }
+
+    /// @brief Offsets of every occurrence of `needle` in `haystack`, in order and including overlapping ones ("aa"
+    /// occurs in "aaa" at 0 and 1). An empty needle never matches.
+    inline std::vector<size_t> FindAllSubstrings(std::span<const char> haystack, strview needle) {
+        std::vector<size_t> offsets;
+        if (needle.empty()) { return offsets; }
+        size_t at = FindSubstring(haystack, needle);
+        while (at != strview::npos) {
+            offsets.push_back(at);
+            at = FindSubstring(haystack, needle, at + 1);
+        }
+        return offsets;
+    }
+
+    /// @brief One occurrence found by a PatternMatcher
+    struct PatternMatch {
+        size_t offset;  // Where the match starts in the scanned text
+        u32 pattern;    // Index of the pattern in the list the matcher was built from
+    };
+
+    /// @brief Finds every occurrence of any of a set of patterns in one pass over the text (Aho-Corasick).
+    ///
+    /// The patterns are compiled once into a DFA over byte classes: every byte that appears in some pattern gets a
+    /// class of its own and all other bytes share one, so the transition table is states x classes rather than
+    /// states x 256. Scanning is then one table lookup per byte, whatever the number of patterns. While the
+    /// automaton is at its root, which is most of the time on real text, it skips ahead with a vector search for
+    /// the bytes that can start a pattern. A single pattern uses FindSubstring instead.
+    ///
+    /// Matches are reported in the order they end; among matches ending at the same byte, longer patterns come
+    /// first. Overlapping matches and matches of duplicate patterns are all reported. Empty patterns never match.
+    class PatternMatcher {
+    public:
+        explicit PatternMatcher(std::span<const strview> patterns) {
+            mLengths.reserve(patterns.size());
+            for (const strview pattern : patterns) {
+                mLengths.push_back(CAST<u32>(pattern.size()));
+            }
+            if (patterns.size() == 1) {
+                mSingle = patterns[0];
+                return;
+            }
+            Build(patterns);
+        }
+
+        PatternMatcher(std::initializer_list<strview> patterns)
+            : PatternMatcher(std::span<const strview>(patterns.begin(), patterns.size())) {}
+
+        X_NODISCARD size_t PatternCount() const {
+            return mLengths.size();
+        }
+
+        X_NODISCARD size_t PatternLength(u32 pattern) const {
+            return mLengths[pattern];
+        }
+
+        /// @brief Calls `onMatch(PatternMatch)` for every match in `text`; scanning stops when it returns false.
+        template<typename OnMatch>
+        void Scan(std::span<const char> text, OnMatch&& onMatch) const {
+            if (mLengths.size() == 1) {
+                if (mSingle.empty()) { return; }
+                size_t at = FindSubstring(text, mSingle);
+                while (at != strview::npos && onMatch(PatternMatch {at, 0})) {
+                    at = FindSubstring(text, mSingle, at + 1);
+                }
+                return;
+            }
+
+            const strview view(text.data(), text.size());
+            const size_t resume = mSkipToStarts ? Run<true>(view, 0, onMatch) : 0;
+            if (resume < view.size()) { Run<false>(view, resume, onMatch); }
+        }
+
+        /// @brief Every match in `text`, in the order Scan reports them
+        X_NODISCARD std::vector<PatternMatch> FindAll(std::span<const char> text) const {
+            std::vector<PatternMatch> matches;
+            Scan(text, [&](const PatternMatch& match) {
+                matches.push_back(match);
+                return true;
+            });
+            return matches;
+        }
+
+    private:
+        // Set in a transition whose target state has outputs, so the scan loop only looks them up on a match
+        static constexpr u32 kHasOutputs = 1u << 31;
+
+        std::vector<u32> mLengths;
+        std::vector<u32> mNext;         // Transitions by [row + class]; each is the target's row plus kHasOutputs
+        std::vector<u32> mOutputStart;  // Per state, its first entry in mOutputs; one extra entry ends the last
+        std::vector<u32> mOutputs;      // Patterns ending at each state, its own before those of its suffixes
+        u16 mClasses[256] {};           // Byte class of every byte; 0 for bytes in no pattern
+        u32 mClassCount = 1;
+        detail::ByteSet mStartBytes;
+        bool mSkipToStarts = false;
+        str mSingle;
+
+        /// The automaton loop from `from`, entered at the root. Returns the size of `text` once done (or told to stop
+        /// by `onMatch`). With kSkipToStarts it may instead return early, at the root, where skipping stopped paying
+        /// off: on text dense with pattern bytes each skip moves only a few bytes for the price of a vector search.
+        /// Skipping is a template parameter so the plain loop has no per-byte test of the state, a branch that
+        /// mispredicts constantly.
+        template<bool kSkipToStarts, typename OnMatch>
+        size_t Run(strview text, size_t from, OnMatch& onMatch) const {
+            // Locals, so the callback cannot make the compiler reload them every byte
+            const u32* next    = mNext.data();
+            const u16* classes = mClasses;
+            u32 row            = 0;
+            i32 credit         = 64;  // Short skips spend it, long ones earn it back
+            for (size_t i = from; i < text.size(); ++i) {
+                if constexpr (kSkipToStarts) {
+                    if (row == 0) {
+                        const size_t start = mStartBytes.FindFirst(text, i);
+                        if (start == strview::npos) { return text.size(); }
+                        credit += start - i >= 16 ? 1 : -1;
+                        if (credit < 0) { return start; }
+                        i = start;
+                    }
+                }
+                const u32 entry = next[row + classes[CAST<u8>(text[i])]];
+                row             = entry & ~kHasOutputs;
+                if (!(entry & kHasOutputs)) { continue; }
+
+                const u32 state = row / mClassCount;
+                for (u32 out = mOutputStart[state]; out < mOutputStart[state + 1]; ++out) {
+                    const u32 pattern = mOutputs[out];
+                    if (!onMatch(PatternMatch {i + 1 - mLengths[pattern], pattern})) { return text.size(); }
+                }
+            }
+            return text.size();
+        }
+
+        void Build(std::span<const strview> patterns) {
+            for (const strview pattern : patterns) {
+                for (const char c : pattern) {
+                    u16& cls = mClasses[CAST<u8>(c)];
+                    if (cls == 0) { cls = CAST<u16>(mClassCount++); }
+                }
+            }
+
+            // Trie, indexed by state until the end. During construction 0 means "no edge": nothing leads back to the
+            // root
+            std::vector<std::vector<u32>> outputs(1);
+            mNext.assign(mClassCount, 0);
+            for (u32 index = 0; index < patterns.size(); ++index) {
+                if (patterns[index].empty()) { continue; }
+                u32 state = 0;
+                for (const char c : patterns[index]) {
+                    u32& edge = mNext[state * mClassCount + mClasses[CAST<u8>(c)]];
+                    if (edge == 0) {
+                        edge = CAST<u32>(outputs.size());
+                        outputs.emplace_back();
+                        mNext.resize(mNext.size() + mClassCount, 0);  // Invalidates `edge`, which is done with
+                    }
+                    state = mNext[state * mClassCount + mClasses[CAST<u8>(c)]];
+                }
+                outputs[state].push_back(index);
+            }
+
+            // Breadth-first, every state's failure state (its longest proper suffix in the trie) is already
+            // complete when it is visited, so missing edges copy the failure state's and outputs inherit its list
+            const u32 stateCount = CAST<u32>(outputs.size());
+            std::vector<u32> fail(stateCount, 0);
+            std::vector<u32> queue;
+            queue.reserve(stateCount);
+            for (u32 cls = 0; cls < mClassCount; ++cls) {
+                if (const u32 child = mNext[cls]; child != 0) {
+                    queue.push_back(child);
+                    u32 first = 0;
+                    for (; first < 256 && mClasses[first] != cls; ++first) {}
+                    mStartBytes.Add(CAST<char>(first));
+                }
+            }
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const u32 state = queue[head];
+                for (u32 cls = 0; cls < mClassCount; ++cls) {
+                    u32& edge      = mNext[state * mClassCount + cls];
+                    const u32 next = mNext[fail[state] * mClassCount + cls];
+                    if (edge == 0) {
+                        edge = next;
+                        continue;
+                    }
+                    fail[edge] = next;
+                    outputs[edge].insert(outputs[edge].end(), outputs[next].begin(), outputs[next].end());
+                    queue.push_back(edge);
+                }
+            }
+
+            mOutputStart.reserve(stateCount + 1);
+            for (const auto& list : outputs) {
+                mOutputStart.push_back(CAST<u32>(mOutputs.size()));
+                mOutputs.insert(mOutputs.end(), list.begin(), list.end());
+            }
+            mOutputStart.push_back(CAST<u32>(mOutputs.size()));
+
+            // Store each target as the offset of its row, saving the scan a multiply per byte
+            for (u32& target : mNext) {
+                target = (target * mClassCount) | (outputs[target].empty() ? 0 : kHasOutputs);
+            }
+
+            // With many distinct start bytes the skip is a scalar bitmap scan, no faster than the automaton itself
+            mSkipToStarts = !mStartBytes.Empty() && mStartBytes.Count() <= detail::ByteSet::kVectorChars;
+        }
+    };
+
+    namespace detail {
+        // Case kernels work on ASCII letters only; every other byte, including all of UTF-8 above 0x7F, passes
+        // through unchanged. Converting flips bit 0x20 of the bytes in [first, first + 25]: 'A' for lower case, 'a'
+        // for upper. Folding for comparison always maps to lower case.
+        inline void ConvertCaseScalar(char* data, size_t size, char first) {
+            for (size_t i = 0; i < size; ++i) {
+                if (CAST<u8>(data[i] - first) < 26) { data[i] = CAST<char>(data[i] ^ 0x20); }
+            }
+        }
+
+        inline char FoldCase(char c) {
+            return CAST<u8>(c - 'A') < 26 ? CAST<char>(c | 0x20) : c;
+        }
+
+        /// Lower-cases the letters of eight bytes at once. Each byte's low seven bits are biased so that the high
+        /// bit says ">= 'A'" in one sum and "> 'Z'" in the other; the bytes where those differ, and whose own high
+        /// bit is clear, are the upper-case letters, and their mask bit shifted down by two is 0x20.
+        inline u64 FoldCaseWord(u64 word) {
+            constexpr u64 kOnes  = 0x0101010101010101ULL;
+            constexpr u64 kHigh  = 0x8080808080808080ULL;
+            const u64 low7       = word & ~kHigh;
+            const u64 atLeastA   = low7 + (0x80 - 'A') * kOnes;
+            const u64 aboveZ     = low7 + (0x80 - 'Z' - 1) * kOnes;
+            const u64 upperCases = (atLeastA ^ aboveZ) & ~word & kHigh;
+            return word | (upperCases >> 2);
+        }
+
+        // Eight bytes per step too, so short strings such as header names avoid a per-byte loop. The last step
+        // rereads a few bytes rather than finishing one byte at a time.
+        inline size_t FindCaseMismatchScalar(const char* a, const char* b, size_t size) {
+            if (size < 8) {
+                for (size_t i = 0; i < size; ++i) {
+                    if (FoldCase(a[i]) != FoldCase(b[i])) { return i; }
+                }
+                return size;
+            }
+            for (size_t i = 0;; i += 8) {
+                i                 = X_MIN(i, size - 8);
+                const u64 differs = FoldCaseWord(LoadEightBytes(a + i)) ^ FoldCaseWord(LoadEightBytes(b + i));
+                if (differs) { return i + CAST<size_t>(std::countr_zero(differs)) / 8; }
+                if (i + 8 == size) { return size; }
+            }
+        }
+
+#if defined(X_SIMD_SSE2)
+        // Signed compares suffice for the letter range: bytes above 0x7F are negative and never in it
+        inline __m128i LetterMaskSse2(__m128i bytes, char first) {
+            return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(CAST<char>(first - 1))),
+                                 _mm_cmplt_epi8(bytes, _mm_set1_epi8(CAST<char>(first + 26))));
+        }
+
+        inline void ConvertCaseSse2(char* data, size_t size, char first) {
+            const __m128i flip = _mm_set1_epi8(0x20);
+            size_t i           = 0;
+            for (; i + 16 <= size; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(RCAST<const __m128i*>(data + i));
+                const __m128i mask  = LetterMaskSse2(bytes, first);
+                _mm_storeu_si128(RCAST<__m128i*>(data + i), _mm_xor_si128(bytes, _mm_and_si128(mask, flip)));
+            }
+            ConvertCaseScalar(data + i, size - i, first);
+        }
+
+        inline size_t FindCaseMismatchSse2(const char* a, const char* b, size_t size) {
+            const __m128i lower = _mm_set1_epi8(0x20);
+            size_t i            = 0;
+            for (; i + 16 <= size; i += 16) {
+                __m128i x = _mm_loadu_si128(RCAST<const __m128i*>(a + i));
+                __m128i y = _mm_loadu_si128(RCAST<const __m128i*>(b + i));
+                x         = _mm_or_si128(x, _mm_and_si128(LetterMaskSse2(x, 'A'), lower));
+                y         = _mm_or_si128(y, _mm_and_si128(LetterMaskSse2(y, 'A'), lower));
+                const u32 equal = CAST<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+                if (equal != 0xFFFF) { return i + CAST<size_t>(std::countr_zero(~equal)); }
+            }
+            return i + FindCaseMismatchScalar(a + i, b + i, size - i);
+        }
+#elif defined(X_SIMD_NEON)
+        inline uint8x16_t LetterMaskNeon(uint8x16_t bytes, char first) {
+            return vcltq_u8(vsubq_u8(bytes, vdupq_n_u8(CAST<u8>(first))), vdupq_n_u8(26));
+        }
+
+        inline void ConvertCaseNeon(char* data, size_t size, char first) {
+            const uint8x16_t flip = vdupq_n_u8(0x20);
+            size_t i              = 0;
+            for (; i + 16 <= size; i += 16) {
+                const uint8x16_t bytes = vld1q_u8(RCAST<const u8*>(data + i));
+                vst1q_u8(RCAST<u8*>(data + i), veorq_u8(bytes, vandq_u8(LetterMaskNeon(bytes, first), flip)));
+            }
+            ConvertCaseScalar(data + i, size - i, first);
+        }
+
+        inline size_t FindCaseMismatchNeon(const char* a, const char* b, size_t size) {
+            const uint8x16_t lower = vdupq_n_u8(0x20);
+            size_t i               = 0;
+            for (; i + 16 <= size; i += 16) {
+                uint8x16_t x      = vld1q_u8(RCAST<const u8*>(a + i));
+                uint8x16_t y      = vld1q_u8(RCAST<const u8*>(b + i));
+                x                 = vorrq_u8(x, vandq_u8(LetterMaskNeon(x, 'A'), lower));
+                y                 = vorrq_u8(y, vandq_u8(LetterMaskNeon(y, 'A'), lower));
+                const u64 differs = NeonMask(vmvnq_u8(vceqq_u8(x, y)));
+                if (differs) { return i + CAST<size_t>(std::countr_zero(differs)) / 4; }
+            }
+            return i + FindCaseMismatchScalar(a + i, b + i, size - i);
+        }
+#endif
+
+#if defined(X_ARCH_X86)
+        X_TARGET("avx2")
+        inline __m256i LetterMaskAvx2(__m256i bytes, char first) {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(CAST<char>(first - 1))),
+                                    _mm256_cmpgt_epi8(_mm256_set1_epi8(CAST<char>(first + 26)), bytes));
+        }
+
+        X_TARGET("avx2")
+        inline void ConvertCaseAvx2(char* data, size_t size, char first) {
+            const __m256i flip = _mm256_set1_epi8(0x20);
+            size_t i           = 0;
+            for (; i + 32 <= size; i += 32) {
+                const __m256i bytes = _mm256_loadu_si256(RCAST<const __m256i*>(data + i));
+                const __m256i mask  = LetterMaskAvx2(bytes, first);
+                _mm256_storeu_si256(RCAST<__m256i*>(data + i), _mm256_xor_si256(bytes, _mm256_and_si256(mask, flip)));
+            }
+            ConvertCaseScalar(data + i, size - i, first);
+        }
+
+        X_TARGET("avx2")
+        inline size_t FindCaseMismatchAvx2(const char* a, const char* b, size_t size) {
+            const __m256i lower = _mm256_set1_epi8(0x20);
+            size_t i            = 0;
+            for (; i + 32 <= size; i += 32) {
+                __m256i x = _mm256_loadu_si256(RCAST<const __m256i*>(a + i));
+                __m256i y = _mm256_loadu_si256(RCAST<const __m256i*>(b + i));
+                x         = _mm256_or_si256(x, _mm256_and_si256(LetterMaskAvx2(x, 'A'), lower));
+                y         = _mm256_or_si256(y, _mm256_and_si256(LetterMaskAvx2(y, 'A'), lower));
+                const u32 equal = CAST<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+                if (equal != 0xFFFFFFFFu) { return i + CAST<size_t>(std::countr_zero(~equal)); }
+            }
+            return i + FindCaseMismatchScalar(a + i, b + i, size - i);
+        }
+#endif
+
+        struct CaseKernels {
+            void (*convert)(char*, size_t, char)                     = ConvertCaseScalar;
+            size_t (*findMismatch)(const char*, const char*, size_t) = FindCaseMismatchScalar;
+        };
+
+#if defined(X_SIMD_SSE2)
+        inline constexpr CaseKernels kBaselineCaseKernels {ConvertCaseSse2, FindCaseMismatchSse2};
+#elif defined(X_SIMD_NEON)
+        inline constexpr CaseKernels kBaselineCaseKernels {ConvertCaseNeon, FindCaseMismatchNeon};
+#else
+        inline constexpr CaseKernels kBaselineCaseKernels {};
+#endif
+
+#if defined(X_ARCH_X86)
+        inline constexpr CaseKernels kAvx2CaseKernels {ConvertCaseAvx2, FindCaseMismatchAvx2};
+#endif
+
+        inline CpuDispatch<const CaseKernels*> gCaseKernels {+[] {
+#if defined(X_ARCH_X86)
+            return CpuSelect<const CaseKernels*>({{CpuMask({CpuFeature::Avx2}), &kAvx2CaseKernels}},
+                                                 &kBaselineCaseKernels);
+#else
+            return &kBaselineCaseKernels;
+#endif
+        }};
+
+        // Below one AVX2 register the eight-byte scalar loop is as fast as any kernel and skips the dispatch
+        inline constexpr size_t kCaseScalarLimit = 32;
+    }  // namespace detail
+
+    /// @brief Lower-cases the ASCII letters of `text` in place, 16 or 32 bytes per step. Non-ASCII bytes are left
+    /// alone, so UTF-8 text stays valid; unlike std::tolower, the result does not depend on the locale.
+    inline void ToLowerAscii(std::span<char> text) {
+        if (text.size() < detail::kCaseScalarLimit) {
+            detail::ConvertCaseScalar(text.data(), text.size(), 'A');
+        } else {
+            detail::gCaseKernels.Get()->convert(text.data(), text.size(), 'A');
+        }
+    }
+
+    /// @brief Upper-cases the ASCII letters of `text` in place; see ToLowerAscii
+    inline void ToUpperAscii(std::span<char> text) {
+        if (text.size() < detail::kCaseScalarLimit) {
+            detail::ConvertCaseScalar(text.data(), text.size(), 'a');
+        } else {
+            detail::gCaseKernels.Get()->convert(text.data(), text.size(), 'a');
+        }
+    }
+
+    /// @brief Offset of the first byte where `a` and `b` differ other than in ASCII case, or the shorter length
+    /// if one is a case-insensitive prefix of the other
+    inline size_t FindMismatchIgnoreCase(strview a, strview b) {
+        const size_t size = X_MIN(a.size(), b.size());
+        if (size < detail::kCaseScalarLimit) { return detail::FindCaseMismatchScalar(a.data(), b.data(), size); }
+        return detail::gCaseKernels.Get()->findMismatch(a.data(), b.data(), size);
+    }
+
+    /// @brief Whether `a` and `b` are equal ignoring ASCII case, e.g. "Content-Type" and "content-type"
+    inline bool EqualsIgnoreCase(strview a, strview b) {
+        return a.size() == b.size() && FindMismatchIgnoreCase(a, b) == a.size();
+    }
+
+    /// @brief Three-way comparison ignoring ASCII case, like strcasecmp: negative, zero or positive as `a` sorts
+    /// before, with or after `b`. Letters compare as their lower-case forms and other bytes as unsigned values.
+    inline int CompareIgnoreCase(strview a, strview b) {
+        const size_t at = FindMismatchIgnoreCase(a, b);
+        if (at < a.size() && at < b.size()) {
+            return CAST<int>(CAST<u8>(detail::FoldCase(a[at]))) - CAST<int>(CAST<u8>(detail::FoldCase(b[at])));
+        }
+        return a.size() < b.size() ? -1 : a.size() > b.size() ? 1 : 0;
+    }
+
+    /// @brief Hash of `text` that ignores ASCII case, so strings equal under EqualsIgnoreCase hash alike. Folds
+    /// and mixes eight bytes per step without copying the text.
+    inline u64 HashIgnoreCase(strview text) {
+        constexpr u64 kMultiplier = 0x9E3779B97F4A7C15ULL;
+        const char* data          = text.data();
+        size_t size               = text.size();
+        u64 hash                  = size * kMultiplier;
+        for (; size >= 8; data += 8, size -= 8) {
+            u64 word;
+            std::memcpy(&word, data, sizeof(word));
+            hash = std::rotl((hash ^ detail::FoldCaseWord(word)) * kMultiplier, 31);
+        }
+        if (size > 0) {
+            u64 word = 0;
+            std::memcpy(&word, data, size);
+            hash = std::rotl((hash ^ detail::FoldCaseWord(word)) * kMultiplier, 31);
+        }
+        // Final avalanche from MurmurHash3, so every input bit reaches the low bits buckets are picked from
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ULL;
+        return hash ^ (hash >> 33);
+    }
+
+    /// @brief Transparent hasher for case-insensitive keys: pair with CaseInsensitiveEqual, or use
+    /// CaseInsensitiveMap, and look keys up by strview or const char* without building a str.
+    struct CaseInsensitiveHash {
+        using is_transparent = void;
+
+        size_t operator()(strview text) const {
+            return CAST<size_t>(HashIgnoreCase(text));
+        }
+    };
+
+    struct CaseInsensitiveEqual {
+        using is_transparent = void;
+
+        bool operator()(strview a, strview b) const {
+            return EqualsIgnoreCase(a, b);
+        }
+    };
+
+    /// @brief Ordering for std::map and std::set keys compared case-insensitively
+    struct CaseInsensitiveLess {
+        using is_transparent = void;
+
+        bool operator()(strview a, strview b) const {
+            return CompareIgnoreCase(a, b) < 0;
+        }
+    };
+
+    /// @brief unordered_map whose str keys ignore ASCII case, e.g. for HTTP header names
+    template<typename Value>
+    using CaseInsensitiveMap = unordered_map<str, Value, CaseInsensitiveHash, CaseInsensitiveEqual>;
+}
@@ -0,0 +1,264 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include "NumberFormat.hpp"
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace x {
+    /// @brief Accumulates text in one buffer and hands it out once at the end, in place of ostringstream or chains
+    /// of operator+ that allocate a temporary per piece.
+    ///
+    /// Three kinds of storage:
+    /// - By default the first kInlineCapacity characters live inside the builder, and anything longer spills to the
+    ///   heap.
+    /// - Given a std::pmr::memory_resource, spills come from it instead, so a builder can grow inside an arena.
+    /// - Given a caller buffer, the builder never allocates. Writes that do not fit are dropped, Overflowed() turns
+    ///   true, and the text is still terminated. Strings are cut at the buffer's end; numbers are written whole or
+    ///   not at all.
+    ///
+    /// Numbers are formatted by NumberFormat.hpp and std::to_chars: locale-independent, no allocation, and floats
+    /// come out in the shortest form that parses back to the same value. The text is always NUL-terminated. View()
+    /// and CStr() stay valid until the next append or until the builder is destroyed.
+    class StringBuilder {
+    public:
+        static constexpr size_t kInlineCapacity = 256;
+
+        StringBuilder() : mResource(std::pmr::get_default_resource()) {}
+
+        /// @brief Grows into `resource`, e.g. a std::pmr::monotonic_buffer_resource, once the inline buffer is full
+        explicit StringBuilder(std::pmr::memory_resource* resource) : mResource(resource) {}
+
+        /// @brief Writes into `buffer` only. One byte is kept for the terminator.
+        explicit StringBuilder(std::span<char> buffer) : mFixed(true) {
+            if (buffer.empty()) {
+                mCapacity = 0;  // Nothing fits; the inline buffer still provides a terminator
+                return;
+            }
+            mData     = buffer.data();
+            mCapacity = buffer.size() - 1;
+            mData[0]  = '\0';
+        }
+
+        StringBuilder(const StringBuilder&)            = delete;
+        StringBuilder& operator=(const StringBuilder&) = delete;
+
+        ~StringBuilder() {
+            Release();
+        }
+
+        /// @brief Makes room for at least `count` more characters, so a known-size build grows only once. A no-op for
+        /// caller buffers.
+        StringBuilder& Reserve(size_t count) {
+            if (mSize + count > mCapacity && !mFixed) { Grow(mSize + count); }
+            return *this;
+        }
+
+        StringBuilder& Append(strview text) {
+            size_t count = text.size();
+            if (!Ensure(count)) {
+                count       = mCapacity - mSize;
+                mOverflowed = true;
+            }
+            std::memcpy(mData + mSize, text.data(), count);
+            SetSize(mSize + count);
+            return *this;
+        }
+
+        StringBuilder& Append(const char* text) {
+            return text ? Append(strview(text)) : *this;
+        }
+
+        StringBuilder& Append(char c) {
+            if (!Ensure(1)) {
+                mOverflowed = true;
+                return *this;
+            }
+            mData[mSize] = c;
+            SetSize(mSize + 1);
+            return *this;
+        }
+
+        /// @brief Appends `c` `count` times
+        StringBuilder& Append(char c, size_t count) {
+            if (!Ensure(count)) {
+                count       = mCapacity - mSize;
+                mOverflowed = true;
+            }
+            std::memset(mData + mSize, c, count);
+            SetSize(mSize + count);
+            return *this;
+        }
+
+        StringBuilder& Append(bool value) {
+            return Append(value ? strview("true") : strview("false"));
+        }
+
+        template<std::integral T>
+            requires(!std::same_as<T, bool> && !std::same_as<T, char>)
+        StringBuilder& Append(T value) {
+            if constexpr (detail::FormattableInteger<T>) {
+                if (Ensure(kMaxIntegerChars)) {
+                    SetSize(mSize + FormatInteger(mData + mSize, value));
+                    return *this;
+                }
+                char digits[kMaxIntegerChars];
+                return AppendWhole(strview(digits, FormatInteger(digits, value)));
+            } else {
+                return AppendChars([value](char* first, char* last) { return std::to_chars(first, last, value); });
+            }
+        }
+
+        /// @brief Shortest representation that round-trips to the same value
+        template<std::floating_point T>
+        StringBuilder& Append(T value) {
+            return AppendChars([value](char* first, char* last) { return std::to_chars(first, last, value); });
+        }
+
+        /// @brief Fixed-point with exactly `precision` digits after the decimal point
+        template<std::floating_point T>
+        StringBuilder& AppendFixed(T value, int precision) {
+            return AppendChars([value, precision](char* first, char* last) {
+                return std::to_chars(first, last, value, std::chars_format::fixed, precision);
+            });
+        }
+
+        /// @brief Left-pads `value` with `fill` to at least `width` characters, e.g. AppendPadded(7, 2) gives "07".
+        /// With the default '0' fill a minus sign goes before the padding.
+        template<detail::FormattableInteger T>
+        StringBuilder& AppendPadded(T value, size_t width, char fill = '0') {
+            char digits[kMaxIntegerChars];
+            const size_t count = FormatInteger(digits, value);
+            if (!Ensure(X_MAX(width, count))) {
+                mOverflowed = true;
+                return *this;
+            }
+            SetSize(mSize + FormatPadded(mData + mSize, value, width, fill));
+            return *this;
+        }
+
+        template<typename T>
+        StringBuilder& operator<<(const T& value) {
+            return Append(value);
+        }
+
+        void Clear() {
+            SetSize(0);
+            mOverflowed = false;
+        }
+
+        /// @brief Shortens the text to `size` characters; does nothing if it is already that short
+        void Truncate(size_t size) {
+            if (size < mSize) { SetSize(size); }
+        }
+
+        X_NODISCARD size_t Size() const {
+            return mSize;
+        }
+
+        X_NODISCARD bool Empty() const {
+            return mSize == 0;
+        }
+
+        X_NODISCARD size_t Capacity() const {
+            return mCapacity;
+        }
+
+        /// @brief True if a caller-buffer builder dropped any text since construction or the last Clear()
+        X_NODISCARD bool Overflowed() const {
+            return mOverflowed;
+        }
+
+        X_NODISCARD strview View() const {
+            return {mData, mSize};
+        }
+
+        X_NODISCARD const char* CStr() const {
+            return mData;
+        }
+
+        X_NODISCARD str Str() const {
+            return str(mData, mSize);
+        }
+
+        operator strview() const {
+            return View();
+        }
+
+    private:
+        char* mData      = mInline;
+        size_t mSize     = 0;
+        size_t mCapacity = kInlineCapacity;  // Excluding the terminator
+        bool mFixed      = false;            // Storage is the caller's buffer
+        bool mOverflowed = false;
+
+        std::pmr::memory_resource* mResource = nullptr;
+        char mInline[kInlineCapacity + 1] {};
+
+        void SetSize(size_t size) {
+            mSize        = size;
+            mData[mSize] = '\0';
+        }
+
+        // Whether `count` more characters fit, growing first unless the buffer is the caller's
+        bool Ensure(size_t count) {
+            if (mSize + count <= mCapacity) { return true; }
+            if (mFixed) { return false; }
+            Grow(X_MAX(mSize + count, mCapacity * 2));
+            return true;
+        }
+
+        void Grow(size_t capacity) {
+            char* buffer = CAST<char*>(mResource->allocate(capacity + 1, 1));
+            std::memcpy(buffer, mData, mSize + 1);
+            Release();
+            mData     = buffer;
+            mCapacity = capacity;
+        }
+
+        void Release() {
+            if (mData != mInline && !mFixed) { mResource->deallocate(mData, mCapacity + 1, 1); }
+        }
+
+        // Appends all of `text` or, when a caller buffer lacks room, none of it
+        StringBuilder& AppendWhole(strview text) {
+            if (!Ensure(text.size())) {
+                mOverflowed = true;
+                return *this;
+            }
+            std::memcpy(mData + mSize, text.data(), text.size());
+            SetSize(mSize + text.size());
+            return *this;
+        }
+
+        /// Runs a std::to_chars call straight into the free space, growing and retrying while it reports the space is
+        /// too small. to_chars never writes a partial number, so a full caller buffer just keeps what it had.
+        template<typename ToChars>
+        StringBuilder& AppendChars(ToChars toChars) {
+            Ensure(32);  // Any integer and any shortest-form double; only long fixed-point output needs more
+            for (;;) {
+                const auto result = toChars(mData + mSize, mData + mCapacity);
+                if (result.ec == std::errc()) {
+                    SetSize(CAST<size_t>(result.ptr - mData));
+                    return *this;
+                }
+                mData[mSize] = '\0';  // to_chars may have scribbled over the terminator
+                if (mFixed) {
+                    mOverflowed = true;
+                    return *this;
+                }
+                Grow(mCapacity * 2);
+            }
+        }
+    };
+}  // namespace x
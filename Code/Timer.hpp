@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Trace.hpp"
 #include <chrono>
 #include <iostream>
 
@@ -24,9 +25,20 @@ namespace x {
     class ScopedTimer {
         Timer mTimer;
         std::string mName;
+#ifdef X_ENABLE_TRACE
+        TraceScope mTrace;
+#endif
 
     public:
+#ifdef X_ENABLE_TRACE
+        // Timed scopes also show up on the trace timeline. Like TraceScope, a C string name (normally a literal) is
+        // traced by pointer and must outlive the trace; other names are interned, which takes a lock.
+        ScopedTimer(cstr name) : mName(name), mTrace(name) {}
+        ScopedTimer(std::string_view name) : mName(name), mTrace(Trace::Intern(name)) {}
+#else
+        ScopedTimer(cstr name) : mName(name) {}
         ScopedTimer(std::string_view name) : mName(name) {}
+#endif
 
         ~ScopedTimer() {
             f32 time = mTimer.ElapsedMillis();
@@ -0,0 +1,345 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Low-overhead timeline tracing. Define X_ENABLE_TRACE to compile the X_TRACE_* hooks in; without it they expand
+// to nothing. Events are written to a per-thread ring buffer with raw CPU timestamps (TSC on x86, the virtual
+// counter on ARM64) and converted to microseconds only when the trace is dumped in the Chrome trace event JSON
+// format, which chrome://tracing and ui.perfetto.dev both load.
+//
+// Event names are stored by pointer, so they must outlive the trace: string literals, IoOpName() or
+// Trace::Intern().
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+namespace x {
+    enum class TracePhase : char {
+        Begin   = 'B',
+        End     = 'E',
+        Instant = 'i',
+    };
+
+    class Trace {
+    public:
+        /// Events kept per thread; older events are overwritten once a thread exceeds this
+        static constexpr size_t kBufferCapacity = 1 << 16;
+
+#ifdef X_ENABLE_TRACE
+        static constexpr bool kEnabled = true;
+#else
+        static constexpr bool kEnabled = false;
+#endif
+
+        /// Raw timestamp in CPU counter ticks
+        static u64 Now() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            u64 value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return CAST<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count());
+#endif
+        }
+
+        /// @brief Recording is on by default; Stop() makes every hook a single relaxed load.
+        static void Start() {
+            State().recording.store(true, std::memory_order_relaxed);
+        }
+
+        static void Stop() {
+            State().recording.store(false, std::memory_order_relaxed);
+        }
+
+        X_NODISCARD static bool IsRecording() {
+            return State().recording.load(std::memory_order_relaxed);
+        }
+
+        static void Record(TracePhase phase, cstr name, cstr category = "app") {
+            if (!IsRecording()) { return; }
+            LocalBuffer().Push(phase, name, category, Now());
+        }
+
+        /// @brief Returns a pointer to a copy of `name` that lives until the process exits. Use it for names
+        /// that are built at runtime.
+        static cstr Intern(strview name) {
+            auto& state = State();
+            std::lock_guard lock(state.mutex);
+            return state.names.emplace(name).first->c_str();
+        }
+
+        /// @brief Labels the calling thread in the dumped trace.
+        static void SetThreadName(strview name) {
+            LocalBuffer().threadName.store(Intern(name), std::memory_order_relaxed);
+        }
+
+        /// @brief Drops every recorded event.
+        static void Clear() {
+            auto& state = State();
+            std::lock_guard lock(state.mutex);
+            for (auto* buffer : state.buffers) {
+                buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+            state.retired.clear();
+        }
+
+        /// @brief Serializes all recorded events to Chrome trace event JSON.
+        ///
+        /// Safe to call while other threads are recording; events that are overwritten while being copied are
+        /// dropped rather than emitted torn.
+        X_NODISCARD static str ToJson() {
+            auto& state = State();
+            std::lock_guard lock(state.mutex);
+
+            const f64 ticksPerUs = TicksPerMicrosecond(state);
+
+            vector<ThreadEvents> threads = state.retired;
+            for (const auto* buffer : state.buffers) {
+                threads.push_back(buffer->Collect());
+            }
+
+            str out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool first = true;
+            char line[128];
+            for (const auto& thread : threads) {
+                if (thread.name) {
+                    out += first ? "\n" : ",\n";
+                    first = false;
+                    std::snprintf(line,
+                                  sizeof(line),
+                                  "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                                  thread.tid);
+                    out += line;
+                    AppendEscaped(out, thread.name);
+                    out += "\"}}";
+                }
+
+                // Ends whose begin was overwritten by the ring buffer would unbalance the timeline
+                u32 depth = 0;
+                for (const auto& event : thread.events) {
+                    if (event.phase == TracePhase::Begin) {
+                        ++depth;
+                    } else if (event.phase == TracePhase::End) {
+                        if (depth == 0) { continue; }
+                        --depth;
+                    }
+
+                    const f64 ts = CAST<f64>(event.timestamp - state.epochTicks) / ticksPerUs;
+                    out += first ? "\n" : ",\n";
+                    first = false;
+                    out += "{\"name\":\"";
+                    AppendEscaped(out, event.name);
+                    out += "\",\"cat\":\"";
+                    AppendEscaped(out, event.category);
+                    std::snprintf(line,
+                                  sizeof(line),
+                                  "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u%s}",
+                                  CAST<char>(event.phase),
+                                  ts,
+                                  thread.tid,
+                                  event.phase == TracePhase::Instant ? ",\"s\":\"t\"" : "");
+                    out += line;
+                }
+            }
+            out += "\n]}\n";
+            return out;
+        }
+
+        /// @brief Writes ToJson() to `filename`.
+        static bool Dump(const str& filename) {
+            std::ofstream file(filename, std::ios::out | std::ios::trunc);
+            if (!file) { return false; }
+            file << ToJson();
+            return file.good();
+        }
+
+    private:
+        struct Event {
+            u64 timestamp;
+            cstr name;
+            cstr category;
+            TracePhase phase;
+        };
+
+        struct ThreadEvents {
+            u32 tid   = 0;
+            cstr name = nullptr;
+            vector<Event> events;
+        };
+
+        struct Slot {
+            // Relaxed atomics so a concurrent dump reads whole values; on x86/ARM64 these are plain moves
+            std::atomic<u64> timestamp {0};
+            std::atomic<cstr> name {nullptr};
+            std::atomic<cstr> category {nullptr};
+            std::atomic<TracePhase> phase {TracePhase::Instant};
+        };
+
+        struct Buffer;
+
+        struct TraceState {
+            std::mutex mutex;
+            vector<Buffer*> buffers;
+            vector<ThreadEvents> retired;
+            std::unordered_set<str> names;
+            std::atomic<bool> recording {true};
+            std::atomic<u32> nextTid {1};
+            u64 epochTicks = Now();
+            std::chrono::steady_clock::time_point epochTime = std::chrono::steady_clock::now();
+        };
+
+        struct Buffer {
+            std::unique_ptr<Slot[]> slots {new Slot[kBufferCapacity]};
+            std::atomic<u64> head {0};  // Next slot to write, only advanced by the owning thread
+            std::atomic<u64> tail {0};  // Oldest slot still wanted, moved forward by Clear()
+            std::atomic<cstr> threadName {nullptr};
+            u32 tid;
+
+            Buffer() {
+                auto& state = State();
+                tid         = state.nextTid.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard lock(state.mutex);
+                state.buffers.push_back(this);
+            }
+
+            ~Buffer() {
+                auto& state = State();
+                std::lock_guard lock(state.mutex);
+                state.retired.push_back(Collect());
+                std::erase(state.buffers, this);
+            }
+
+            Buffer(const Buffer&)            = delete;
+            Buffer& operator=(const Buffer&) = delete;
+
+            void Push(TracePhase phase, cstr name, cstr category, u64 timestamp) {
+                const u64 index = head.load(std::memory_order_relaxed);
+                Slot& slot      = slots[index & (kBufferCapacity - 1)];
+                slot.timestamp.store(timestamp, std::memory_order_relaxed);
+                slot.name.store(name, std::memory_order_relaxed);
+                slot.category.store(category, std::memory_order_relaxed);
+                slot.phase.store(phase, std::memory_order_relaxed);
+                head.store(index + 1, std::memory_order_release);
+            }
+
+            X_NODISCARD ThreadEvents Collect() const {
+                ThreadEvents result;
+                result.tid  = tid;
+                result.name = threadName.load(std::memory_order_relaxed);
+
+                const u64 end = head.load(std::memory_order_acquire);
+                u64 begin     = X_MAX(tail.load(std::memory_order_relaxed),
+                                  end > kBufferCapacity ? end - kBufferCapacity : u64(0));
+                result.events.reserve(end - begin);
+                for (u64 i = begin; i < end; ++i) {
+                    const Slot& slot = slots[i & (kBufferCapacity - 1)];
+                    result.events.push_back({slot.timestamp.load(std::memory_order_relaxed),
+                                             slot.name.load(std::memory_order_relaxed),
+                                             slot.category.load(std::memory_order_relaxed),
+                                             slot.phase.load(std::memory_order_relaxed)});
+                }
+
+                // Anything the owner wrapped over while we were copying may be torn. Push writes slot `after`
+                // before publishing it, and that slot aliases index after - kBufferCapacity, so the overlap
+                // includes it.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const u64 after = head.load(std::memory_order_relaxed);
+                if (after >= kBufferCapacity && after - kBufferCapacity >= begin) {
+                    const u64 lost = X_MIN(after - kBufferCapacity - begin + 1, CAST<u64>(result.events.size()));
+                    result.events.erase(result.events.begin(), result.events.begin() + CAST<std::ptrdiff_t>(lost));
+                }
+                return result;
+            }
+        };
+
+        static TraceState& State() {
+            // Leaked on purpose so thread buffers can still retire into it during static destruction
+            static auto* state = new TraceState();
+            return *state;
+        }
+
+        static Buffer& LocalBuffer() {
+            thread_local Buffer buffer;
+            return buffer;
+        }
+
+        /// Calibrates the CPU counter against steady_clock over the lifetime of the trace
+        static f64 TicksPerMicrosecond(const TraceState& state) {
+            using namespace std::chrono;
+            auto elapsed = steady_clock::now() - state.epochTime;
+            // Too short a window gives a noisy ratio, so wait out at least 10ms
+            while (elapsed < milliseconds(10)) {
+                std::this_thread::yield();
+                elapsed = steady_clock::now() - state.epochTime;
+            }
+            const u64 ticks = Now() - state.epochTicks;
+            const f64 us    = CAST<f64>(duration_cast<nanoseconds>(elapsed).count()) / 1000.0;
+            return X_MAX(CAST<f64>(ticks) / us, 1e-9);
+        }
+
+        static void AppendEscaped(str& out, cstr text) {
+            if (!text) { return; }
+            for (; *text; ++text) {
+                const char c = *text;
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (CAST<u8>(c) < 0x20) {
+                    out += ' ';
+                } else {
+                    out += c;
+                }
+            }
+        }
+    };
+
+    /// @brief Records a begin event on construction and the matching end event on destruction.
+    class TraceScope {
+    public:
+        explicit TraceScope(cstr name, cstr category = "app") : mName(name), mCategory(category) {
+            Trace::Record(TracePhase::Begin, mName, mCategory);
+        }
+
+        ~TraceScope() {
+            Trace::Record(TracePhase::End, mName, mCategory);
+        }
+
+        TraceScope(const TraceScope&)            = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        cstr mName;
+        cstr mCategory;
+    };
+}  // namespace x
+
+#ifdef X_ENABLE_TRACE
+    #define X_TRACE_SCOPE(name) ::x::TraceScope X_CONCAT_EXPAND(xTraceScope, __LINE__)(name)
+    #define X_TRACE_SCOPE_CAT(name, category)                                                                          \
+        ::x::TraceScope X_CONCAT_EXPAND(xTraceScope, __LINE__)(name, category)
+    #define X_TRACE_INSTANT(name) ::x::Trace::Record(::x::TracePhase::Instant, name)
+#else
+    #define X_TRACE_SCOPE(name)
+    #define X_TRACE_SCOPE_CAT(name, category)
+    #define X_TRACE_INSTANT(name) ((void)0)
+#endif
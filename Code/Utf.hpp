@@ -0,0 +1,413 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// UTF-8 <-> UTF-16/UTF-32 transcoding. Every conversion validates its input; the into-buffer variants write to
+// caller storage sized with the matching *Length* function and never allocate. Runs of ASCII, which dominate most
+// real text, are converted 16 or 32 bytes at a time with SSE2/AVX2 (NEON on ARM64); everything else goes through
+// the scalar decoder.
+
+#pragma once
+
+#include "Typedefs.hpp"
+#include "Macros.hpp"
+#include <bit>
+#include <string>
+#include <string_view>
+
+#if defined(X_SIMD_SSE2) || defined(X_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(X_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace x {
+    /// @brief Outcome of a transcoding call. On failure `written` counts the units produced before the first invalid
+    /// sequence and `error` is that sequence's offset in input code units.
+    struct UtfResult {
+        static constexpr size_t kNoError = ~size_t(0);
+
+        size_t written = 0;
+        size_t error   = kNoError;
+
+        X_NODISCARD bool Ok() const {
+            return error == kNoError;
+        }
+    };
+
+    namespace detail {
+        inline bool IsContinuation(u8 byte) {
+            return (byte & 0xC0) == 0x80;
+        }
+
+        /// Decodes one UTF-8 sequence starting at `p`. Returns its length, or 0 if it is truncated, overlong, a
+        /// surrogate or above U+10FFFF.
+        inline size_t DecodeUtf8(const u8* p, size_t available, char32_t& codePoint) {
+            const u8 lead = p[0];
+            if (lead < 0x80) {
+                codePoint = lead;
+                return 1;
+            }
+            if (lead < 0xC2) { return 0; }  // Continuation byte or overlong 2-byte form
+            if (lead < 0xE0) {
+                if (available < 2 || !IsContinuation(p[1])) { return 0; }
+                codePoint = (char32_t(lead & 0x1F) << 6) | (p[1] & 0x3F);
+                return 2;
+            }
+            if (lead < 0xF0) {
+                if (available < 3 || !IsContinuation(p[1]) || !IsContinuation(p[2])) { return 0; }
+                if (lead == 0xE0 && p[1] < 0xA0) { return 0; }  // Overlong
+                if (lead == 0xED && p[1] > 0x9F) { return 0; }  // Surrogate
+                codePoint = (char32_t(lead & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+                return 3;
+            }
+            if (lead < 0xF5) {
+                if (available < 4 || !IsContinuation(p[1]) || !IsContinuation(p[2]) || !IsContinuation(p[3])) {
+                    return 0;
+                }
+                if (lead == 0xF0 && p[1] < 0x90) { return 0; }  // Overlong
+                if (lead == 0xF4 && p[1] > 0x8F) { return 0; }  // Above U+10FFFF
+                codePoint = (char32_t(lead & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12) |
+                            (char32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+                return 4;
+            }
+            return 0;
+        }
+
+        /// Encodes a valid scalar value; returns the bytes written
+        inline size_t EncodeUtf8(char32_t codePoint, char* out) {
+            if (codePoint < 0x80) {
+                out[0] = CAST<char>(codePoint);
+                return 1;
+            }
+            if (codePoint < 0x800) {
+                out[0] = CAST<char>(0xC0 | (codePoint >> 6));
+                out[1] = CAST<char>(0x80 | (codePoint & 0x3F));
+                return 2;
+            }
+            if (codePoint < 0x10000) {
+                out[0] = CAST<char>(0xE0 | (codePoint >> 12));
+                out[1] = CAST<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out[2] = CAST<char>(0x80 | (codePoint & 0x3F));
+                return 3;
+            }
+            out[0] = CAST<char>(0xF0 | (codePoint >> 18));
+            out[1] = CAST<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out[2] = CAST<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out[3] = CAST<char>(0x80 | (codePoint & 0x3F));
+            return 4;
+        }
+
+        /// Copies the leading ASCII bytes of `in` into the wider `out`; returns how many were converted
+        template<typename Unit>
+        inline size_t WidenAscii(const u8* in, size_t size, Unit* out) {
+            size_t i = 0;
+#if defined(X_SIMD_AVX2)
+            for (; i + 32 <= size; i += 32) {
+                const __m256i bytes = _mm256_loadu_si256(RCAST<const __m256i*>(in + i));
+                if (_mm256_movemask_epi8(bytes) != 0) { break; }
+                const __m128i lo = _mm256_castsi256_si128(bytes);
+                const __m128i hi = _mm256_extracti128_si256(bytes, 1);
+                if constexpr (sizeof(Unit) == 2) {
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i), _mm256_cvtepu8_epi16(lo));
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i + 16), _mm256_cvtepu8_epi16(hi));
+                } else {
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i), _mm256_cvtepu8_epi32(lo));
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i + 16), _mm256_cvtepu8_epi32(hi));
+                    _mm256_storeu_si256(RCAST<__m256i*>(out + i + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+                }
+            }
+#elif defined(X_SIMD_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= size; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(RCAST<const __m128i*>(in + i));
+                if (_mm_movemask_epi8(bytes) != 0) { break; }
+                const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+                const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+                if constexpr (sizeof(Unit) == 2) {
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i), lo);
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i + 8), hi);
+                } else {
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+                }
+            }
+#elif defined(X_SIMD_NEON)
+            for (; i + 16 <= size; i += 16) {
+                const uint8x16_t bytes = vld1q_u8(in + i);
+                if (vmaxvq_u8(bytes) >= 0x80) { break; }
+                const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+                const uint16x8_t hi = vmovl_high_u8(bytes);
+                if constexpr (sizeof(Unit) == 2) {
+                    vst1q_u16(RCAST<u16*>(out + i), lo);
+                    vst1q_u16(RCAST<u16*>(out + i + 8), hi);
+                } else {
+                    vst1q_u32(RCAST<u32*>(out + i), vmovl_u16(vget_low_u16(lo)));
+                    vst1q_u32(RCAST<u32*>(out + i + 4), vmovl_high_u16(lo));
+                    vst1q_u32(RCAST<u32*>(out + i + 8), vmovl_u16(vget_low_u16(hi)));
+                    vst1q_u32(RCAST<u32*>(out + i + 12), vmovl_high_u16(hi));
+                }
+            }
+#endif
+            for (; i < size && in[i] < 0x80; ++i) {
+                out[i] = CAST<Unit>(in[i]);
+            }
+            return i;
+        }
+
+        /// Copies the leading ASCII units of `in` into `out` as bytes; returns how many were converted
+        template<typename Unit>
+        inline size_t NarrowAscii(const Unit* in, size_t size, char* out) {
+            size_t i = 0;
+#if defined(X_SIMD_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            if constexpr (sizeof(Unit) == 2) {
+                const __m128i mask = _mm_set1_epi16(CAST<i16>(0xFF80));
+                for (; i + 16 <= size; i += 16) {
+                    const __m128i a = _mm_loadu_si128(RCAST<const __m128i*>(in + i));
+                    const __m128i b = _mm_loadu_si128(RCAST<const __m128i*>(in + i + 8));
+                    const __m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) { break; }
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i), _mm_packus_epi16(a, b));
+                }
+            } else {
+                const __m128i mask = _mm_set1_epi32(CAST<i32>(0xFFFFFF80));
+                for (; i + 16 <= size; i += 16) {
+                    const __m128i a = _mm_loadu_si128(RCAST<const __m128i*>(in + i));
+                    const __m128i b = _mm_loadu_si128(RCAST<const __m128i*>(in + i + 4));
+                    const __m128i c = _mm_loadu_si128(RCAST<const __m128i*>(in + i + 8));
+                    const __m128i d = _mm_loadu_si128(RCAST<const __m128i*>(in + i + 12));
+                    const __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), mask);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF) { break; }
+                    const __m128i ab = _mm_packs_epi32(a, b);
+                    const __m128i cd = _mm_packs_epi32(c, d);
+                    _mm_storeu_si128(RCAST<__m128i*>(out + i), _mm_packus_epi16(ab, cd));
+                }
+            }
+#elif defined(X_SIMD_NEON)
+            if constexpr (sizeof(Unit) == 2) {
+                for (; i + 16 <= size; i += 16) {
+                    const uint16x8_t a = vld1q_u16(RCAST<const u16*>(in + i));
+                    const uint16x8_t b = vld1q_u16(RCAST<const u16*>(in + i + 8));
+                    if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) { break; }
+                    vst1q_u8(RCAST<u8*>(out + i), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+                }
+            }
+#endif
+            for (; i < size && CAST<u32>(in[i]) < 0x80; ++i) {
+                out[i] = CAST<char>(in[i]);
+            }
+            return i;
+        }
+
+        /// Counts bytes that are not UTF-8 continuation bytes (`leads`) and 4-byte sequence leaders (`quads`)
+        inline void CountUtf8Leads(const u8* in, size_t size, size_t& leads, size_t& quads) {
+            size_t i = 0;
+            leads = quads = 0;
+#if defined(X_SIMD_AVX2)
+            // As signed bytes, continuations are [-128, -65] and 4-byte leaders [-16, -1]
+            const __m256i contMax = _mm256_set1_epi8(-65);
+            const __m256i quadMin = _mm256_set1_epi8(-17);
+            const __m256i zero    = _mm256_setzero_si256();
+            for (; i + 32 <= size; i += 32) {
+                const __m256i bytes = _mm256_loadu_si256(RCAST<const __m256i*>(in + i));
+                const __m256i lead  = _mm256_cmpgt_epi8(bytes, contMax);
+                const __m256i quad =
+                  _mm256_and_si256(_mm256_cmpgt_epi8(bytes, quadMin), _mm256_cmpgt_epi8(zero, bytes));
+                leads += std::popcount(CAST<u32>(_mm256_movemask_epi8(lead)));
+                quads += std::popcount(CAST<u32>(_mm256_movemask_epi8(quad)));
+            }
+#elif defined(X_SIMD_SSE2)
+            const __m128i contMax = _mm_set1_epi8(-65);
+            const __m128i quadMin = _mm_set1_epi8(-17);
+            const __m128i zero    = _mm_setzero_si128();
+            for (; i + 16 <= size; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(RCAST<const __m128i*>(in + i));
+                const __m128i lead  = _mm_cmpgt_epi8(bytes, contMax);
+                const __m128i quad  = _mm_and_si128(_mm_cmpgt_epi8(bytes, quadMin), _mm_cmplt_epi8(bytes, zero));
+                leads += std::popcount(CAST<u32>(_mm_movemask_epi8(lead)));
+                quads += std::popcount(CAST<u32>(_mm_movemask_epi8(quad)));
+            }
+#endif
+            for (; i < size; ++i) {
+                leads += !IsContinuation(in[i]);
+                quads += in[i] >= 0xF0;
+            }
+        }
+
+        template<typename Unit>
+        inline UtfResult Utf8ToWide(strview input, Unit* output) {
+            const auto* in    = RCAST<const u8*>(input.data());
+            const size_t size = input.size();
+            size_t i          = 0;
+            Unit* out         = output;
+            while (i < size) {
+                const size_t ascii = WidenAscii(in + i, size - i, out);
+                i += ascii;
+                out += ascii;
+
+                // Decode scalar until the next ASCII byte, then go back to the vector loop
+                while (i < size && in[i] >= 0x80) {
+                    char32_t codePoint = 0;
+                    const size_t length = DecodeUtf8(in + i, size - i, codePoint);
+                    if (length == 0) { return {CAST<size_t>(out - output), i}; }
+                    if constexpr (sizeof(Unit) == 2) {
+                        if (codePoint >= 0x10000) {
+                            codePoint -= 0x10000;
+                            *out++ = CAST<Unit>(0xD800 + (codePoint >> 10));
+                            *out++ = CAST<Unit>(0xDC00 + (codePoint & 0x3FF));
+                        } else {
+                            *out++ = CAST<Unit>(codePoint);
+                        }
+                    } else {
+                        *out++ = CAST<Unit>(codePoint);
+                    }
+                    i += length;
+                }
+            }
+            return {CAST<size_t>(out - output)};
+        }
+
+        template<typename Unit>
+        inline UtfResult WideToUtf8(const Unit* in, size_t size, char* output) {
+            size_t i  = 0;
+            char* out = output;
+            while (i < size) {
+                const size_t ascii = NarrowAscii(in + i, size - i, out);
+                i += ascii;
+                out += ascii;
+
+                while (i < size && CAST<u32>(in[i]) >= 0x80) {
+                    char32_t codePoint = CAST<char32_t>(in[i]);
+                    size_t consumed    = 1;
+                    if constexpr (sizeof(Unit) == 2) {
+                        if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+                            const bool paired = codePoint <= 0xDBFF && i + 1 < size && in[i + 1] >= 0xDC00 &&
+                                                in[i + 1] <= 0xDFFF;
+                            if (!paired) { return {CAST<size_t>(out - output), i}; }
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (in[i + 1] - 0xDC00);
+                            consumed  = 2;
+                        }
+                    } else if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+                        return {CAST<size_t>(out - output), i};
+                    }
+                    out += EncodeUtf8(codePoint, out);
+                    i += consumed;
+                }
+            }
+            return {CAST<size_t>(out - output)};
+        }
+    }  // namespace detail
+
+    /// @brief UTF-16 code units needed for `input`, assuming it is valid UTF-8. Never undercounts invalid input.
+    inline size_t Utf16LengthFromUtf8(strview input) {
+        size_t leads, quads;
+        detail::CountUtf8Leads(RCAST<const u8*>(input.data()), input.size(), leads, quads);
+        return leads + quads;
+    }
+
+    /// @brief Code points in `input`, assuming it is valid UTF-8. Never undercounts invalid input.
+    inline size_t Utf32LengthFromUtf8(strview input) {
+        size_t leads, quads;
+        detail::CountUtf8Leads(RCAST<const u8*>(input.data()), input.size(), leads, quads);
+        return leads;
+    }
+
+    /// @brief UTF-8 bytes needed for `input`. Never undercounts invalid input.
+    inline size_t Utf8LengthFromUtf16(std::u16string_view input) {
+        size_t length = 0;
+        for (const char16_t unit : input) {
+            // Each half of a surrogate pair contributes 2 of the pair's 4 bytes
+            const bool surrogate = unit >= 0xD800 && unit <= 0xDFFF;
+            length += 1 + (unit >= 0x80) + (unit >= 0x800 && !surrogate);
+        }
+        return length;
+    }
+
+    inline size_t Utf8LengthFromUtf32(std::u32string_view input) {
+        size_t length = 0;
+        for (const char32_t unit : input) {
+            length += 1 + (unit >= 0x80) + (unit >= 0x800) + (unit >= 0x10000);
+        }
+        return length;
+    }
+
+    /// @brief Converts into `output`, which must hold Utf16LengthFromUtf8(input) units.
+    inline UtfResult Utf8ToUtf16(strview input, char16_t* output) {
+        return detail::Utf8ToWide(input, output);
+    }
+
+    /// @brief Converts into `output`, which must hold Utf32LengthFromUtf8(input) units.
+    inline UtfResult Utf8ToUtf32(strview input, char32_t* output) {
+        return detail::Utf8ToWide(input, output);
+    }
+
+    /// @brief Converts into `output`, which must hold Utf8LengthFromUtf16(input) bytes. Unpaired surrogates are
+    /// errors.
+    inline UtfResult Utf16ToUtf8(std::u16string_view input, char* output) {
+        return detail::WideToUtf8(input.data(), input.size(), output);
+    }
+
+    /// @brief Converts into `output`, which must hold Utf8LengthFromUtf32(input) bytes.
+    inline UtfResult Utf32ToUtf8(std::u32string_view input, char* output) {
+        return detail::WideToUtf8(input.data(), input.size(), output);
+    }
+
+    /// @brief Allocating conversions. Invalid input yields an empty string.
+    inline std::u16string Utf8ToUtf16(strview input) {
+        std::u16string result(Utf16LengthFromUtf8(input), u'\0');
+        const auto status = Utf8ToUtf16(input, result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+
+    inline std::u32string Utf8ToUtf32(strview input) {
+        std::u32string result(Utf32LengthFromUtf8(input), U'\0');
+        const auto status = Utf8ToUtf32(input, result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+
+    inline str Utf16ToUtf8(std::u16string_view input) {
+        str result(Utf8LengthFromUtf16(input), '\0');
+        const auto status = Utf16ToUtf8(input, result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+
+    inline str Utf32ToUtf8(std::u32string_view input) {
+        str result(Utf8LengthFromUtf32(input), '\0');
+        const auto status = Utf32ToUtf8(input, result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+
+    /// @brief wchar_t is UTF-16 on Windows and UTF-32 elsewhere; these pick the matching conversion.
+    inline wstr Utf8ToWide(strview input) {
+        wstr result(sizeof(wchar_t) == 2 ? Utf16LengthFromUtf8(input) : Utf32LengthFromUtf8(input), L'\0');
+        const auto status = detail::Utf8ToWide(input, result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+
+    inline str WideToUtf8(std::wstring_view input) {
+        size_t length = 0;
+        if constexpr (sizeof(wchar_t) == 2) {
+            length = Utf8LengthFromUtf16({RCAST<const char16_t*>(input.data()), input.size()});
+        } else {
+            length = Utf8LengthFromUtf32({RCAST<const char32_t*>(input.data()), input.size()});
+        }
+        str result(length, '\0');
+        const auto status = detail::WideToUtf8(input.data(), input.size(), result.data());
+        if (!status.Ok()) { return {}; }
+        result.resize(status.written);
+        return result;
+    }
+}  // namespace x
@@ -0,0 +1,9 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.BulkLoader
+    ${TESTS_DIR}/BulkLoader/Test.BulkLoader.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Test.BulkLoader PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.BulkLoader)
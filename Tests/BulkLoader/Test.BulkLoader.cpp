@@ -0,0 +1,161 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    /// A directory of `count` small files with distinct contents; file i holds i + 1 copies of its name
+    struct LoadFixture {
+        ScratchDir dir;
+        vector<Path> paths;
+        vector<str> contents;
+
+        LoadFixture(const str& name, size_t count) : dir("bulkload_" + name) {
+            for (size_t i = 0; i < count; ++i) {
+                const str file = "file" + X_TOSTR(i) + ".bin";
+                str text;
+                for (size_t copy = 0; copy <= i; ++copy) {
+                    text += file;
+                }
+                dir.Write(file, text);
+                paths.push_back(dir / file);
+                contents.push_back(text);
+            }
+        }
+    };
+
+    str AsText(std::span<const u8> bytes) {
+        return {RCAST<const char*>(bytes.data()), bytes.size()};
+    }
+
+    /// Indices of `result` sorted by where their contents sit in the arena
+    vector<size_t> ArenaOrder(const BulkLoadResult& result) {
+        vector<size_t> order(result.Count());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::ranges::sort(order, {}, [&](size_t i) { return result[i].data(); });
+        return order;
+    }
+}  // namespace
+
+TEST_CASE("BulkLoader reads every file", "[BulkLoader]") {
+    const LoadFixture fixture("all", 24);
+
+    for (const auto order : {BulkLoadOrder::Input, BulkLoadOrder::Inode, BulkLoadOrder::PhysicalOffset}) {
+        BulkLoadOptions options;
+        options.order      = order;
+        options.queueDepth = 4;
+        const BulkLoadResult result = BulkLoader::Load(fixture.paths, options);
+
+        REQUIRE(result.Count() == fixture.paths.size());
+        REQUIRE(result.FailedCount() == 0);
+        u64 total = 0;
+        for (size_t i = 0; i < result.Count(); ++i) {
+            REQUIRE(result.Loaded(i));
+            REQUIRE(AsText(result[i]) == fixture.contents[i]);
+            total += fixture.contents[i].size();
+        }
+        REQUIRE(result.TotalBytes() == total);
+
+        // The arena is one packed allocation, filled in read order
+        const vector<size_t> arena = ArenaOrder(result);
+        for (size_t k = 1; k < arena.size(); ++k) {
+            REQUIRE(result[arena[k - 1]].data() + result[arena[k - 1]].size() == result[arena[k]].data());
+        }
+    }
+}
+
+TEST_CASE("BulkLoader lays the arena out in read order", "[BulkLoader]") {
+    const LoadFixture fixture("order", 16);
+
+    SECTION("Input order") {
+        BulkLoadOptions options;
+        options.order               = BulkLoadOrder::Input;
+        const BulkLoadResult result = BulkLoader::Load(fixture.paths, options);
+        const vector<size_t> arena  = ArenaOrder(result);
+        for (size_t k = 0; k < arena.size(); ++k) {
+            REQUIRE(arena[k] == k);
+        }
+    }
+
+#ifndef _WIN32
+    SECTION("Inode order") {
+        // Reversed so input order and inode order disagree
+        vector<Path> paths(fixture.paths.rbegin(), fixture.paths.rend());
+        vector<u64> inodes;
+        for (const Path& path : paths) {
+            struct stat st {};
+            REQUIRE(::stat(path.CStr(), &st) == 0);
+            inodes.push_back(CAST<u64>(st.st_ino));
+        }
+
+        BulkLoadOptions options;
+        options.order               = BulkLoadOrder::Inode;
+        const BulkLoadResult result = BulkLoader::Load(paths, options);
+        const vector<size_t> arena  = ArenaOrder(result);
+        for (size_t k = 1; k < arena.size(); ++k) {
+            REQUIRE(inodes[arena[k - 1]] < inodes[arena[k]]);
+        }
+    }
+#endif
+}
+
+TEST_CASE("BulkLoader failures", "[BulkLoader]") {
+    const LoadFixture fixture("failures", 6);
+
+    SECTION("Missing files are reported and take no space") {
+        vector<Path> paths = fixture.paths;
+        paths.insert(paths.begin() + 2, fixture.dir / "missing.bin");
+        paths.push_back(fixture.dir / "also_missing.bin");
+
+        const BulkLoadResult result = BulkLoader::Load(paths);
+        REQUIRE(result.Count() == paths.size());
+        REQUIRE(result.FailedCount() == 2);
+        REQUIRE_FALSE(result.Loaded(2));
+        REQUIRE_FALSE(result.Loaded(paths.size() - 1));
+        REQUIRE(result[2].empty());
+
+        u64 total = 0;
+        for (const str& text : fixture.contents) {
+            total += text.size();
+        }
+        REQUIRE(result.TotalBytes() == total);
+        REQUIRE(AsText(result[3]) == fixture.contents[2]);
+    }
+
+    SECTION("A cancelled token loads nothing") {
+        CancellationSource source;
+        source.Cancel();
+        BulkLoadOptions options;
+        options.token               = source.Token();
+        const BulkLoadResult result = BulkLoader::Load(fixture.paths, options);
+        REQUIRE(result.Count() == fixture.paths.size());
+        REQUIRE(result.FailedCount() == fixture.paths.size());
+        REQUIRE(result.TotalBytes() == 0);
+    }
+
+    SECTION("No paths") {
+        const BulkLoadResult result = BulkLoader::Load({});
+        REQUIRE(result.Count() == 0);
+        REQUIRE(result.TotalBytes() == 0);
+    }
+}
+
+TEST_CASE("BulkLoader::LoadAsync", "[BulkLoader]") {
+    const LoadFixture fixture("async", 8);
+    BulkLoadResult result = BulkLoader::LoadAsync(fixture.paths).Get();
+    REQUIRE(result.FailedCount() == 0);
+    REQUIRE(AsText(result[7]) == fixture.contents[7]);
+}
@@ -0,0 +1,9 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.BulkWriter
+    ${TESTS_DIR}/BulkWriter/Test.BulkWriter.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Test.BulkWriter PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.BulkWriter)
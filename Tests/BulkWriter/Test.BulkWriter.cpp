@@ -0,0 +1,114 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+#include <filesystem>
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    /// Items writing `contents[i]` to `names[i]` under `dir`; the spans point into `contents`
+    vector<BulkWriteItem> Items(const ScratchDir& dir, const vector<str>& names, const vector<vector<u8>>& contents) {
+        vector<BulkWriteItem> items;
+        for (size_t i = 0; i < names.size(); ++i) {
+            items.push_back({dir / names[i], contents[i]});
+        }
+        return items;
+    }
+
+    vector<vector<u8>> Contents(size_t count) {
+        vector<vector<u8>> contents;
+        for (size_t i = 0; i < count; ++i) {
+            const str text = "contents of item " + X_TOSTR(i) + str(i * 100, '.');
+            contents.emplace_back(text.begin(), text.end());
+        }
+        return contents;
+    }
+}  // namespace
+
+TEST_CASE("BulkWriter writes every item", "[BulkWriter]") {
+    const ScratchDir dir("bulkwrite_all");
+    const vector<str> names = {"a.txt", "nested/b.txt", "nested/c.txt", "nested/deeper/d.txt", "other/e.txt"};
+    const auto contents     = Contents(names.size());
+    const auto items        = Items(dir, names, contents);
+
+    for (const bool sync : {false, true}) {
+        BulkWriteOptions options;
+        options.concurrency          = 3;
+        options.sync                 = sync;  // One syncfs per filesystem on Linux
+        const BulkWriteResult result = BulkWriter::Write(items, options);
+
+        REQUIRE(result.Count() == items.size());
+        REQUIRE(result.FailedCount() == 0);
+        REQUIRE(result.Succeeded());
+        u64 total = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            REQUIRE(result.Written(i));
+            REQUIRE(FileReader::ReadBytes(items[i].path) == contents[i]);
+            total += contents[i].size();
+        }
+        REQUIRE(result.TotalBytes() == total);
+    }
+}
+
+TEST_CASE("BulkWriter failures", "[BulkWriter]") {
+    const ScratchDir dir("bulkwrite_failures");
+
+    SECTION("A parent that cannot be created fails only its own items") {
+        // A regular file where a directory is needed
+        dir.Write("blocker", "not a directory");
+        const vector<str> names = {"ok/a.txt", "blocker/sub/b.txt", "blocker/sub/c.txt", "ok/d.txt"};
+        const auto contents     = Contents(names.size());
+        const auto items        = Items(dir, names, contents);
+
+        const BulkWriteResult result = BulkWriter::Write(items);
+        REQUIRE(result.FailedCount() == 2);
+        REQUIRE_FALSE(result.Succeeded());
+        REQUIRE(result.Written(0));
+        REQUIRE_FALSE(result.Written(1));
+        REQUIRE_FALSE(result.Written(2));
+        REQUIRE(result.Written(3));
+        REQUIRE(result.TotalBytes() == contents[0].size() + contents[3].size());
+        REQUIRE(FileReader::ReadBytes(items[3].path) == contents[3]);
+    }
+
+    SECTION("A cancelled token writes nothing") {
+        const vector<str> names = {"x/a.txt", "x/b.txt", "y/c.txt"};
+        const auto contents     = Contents(names.size());
+        const auto items        = Items(dir, names, contents);
+
+        CancellationSource source;
+        source.Cancel();
+        BulkWriteOptions options;
+        options.token                = source.Token();
+        const BulkWriteResult result = BulkWriter::Write(items, options);
+        REQUIRE(result.FailedCount() == items.size());
+        REQUIRE_FALSE(result.Succeeded());
+        REQUIRE(result.TotalBytes() == 0);
+        for (const auto& item : items) {
+            REQUIRE_FALSE(std::filesystem::exists(item.path.Str()));
+        }
+    }
+
+    SECTION("No items") {
+        const BulkWriteResult result = BulkWriter::Write({});
+        REQUIRE(result.Count() == 0);
+        REQUIRE(result.Succeeded());
+    }
+}
+
+TEST_CASE("BulkWriter::WriteAsync", "[BulkWriter]") {
+    const ScratchDir dir("bulkwrite_async");
+    const vector<str> names = {"one.txt", "sub/two.txt"};
+    const auto contents     = Contents(names.size());
+
+    BulkWriteOptions options;
+    options.sync                 = true;
+    const BulkWriteResult result = BulkWriter::WriteAsync(Items(dir, names, contents), options).Get();
+    REQUIRE(result.Succeeded());
+    REQUIRE(FileReader::ReadBytes(dir / "sub/two.txt") == contents[1]);
+}
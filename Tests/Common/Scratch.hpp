@@ -0,0 +1,71 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+// Temporary files and directories for the tests that touch the filesystem. Names are placed under the system
+// temp directory with an "xcommon_" prefix; each suite prefixes its own names too, so suites run in parallel by
+// ctest never share a file.
+
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include <filesystem>
+
+namespace x::test {
+    inline Path ScratchPath(const str& name) {
+        return Path((std::filesystem::temp_directory_path() / ("xcommon_" + name)).string());
+    }
+
+    /// @brief A file holding the given contents, removed when the fixture goes out of scope.
+    struct ScratchFile {
+        Path path;
+
+        ScratchFile(const str& name, const vector<u8>& bytes) : path(ScratchPath(name)) {
+            REQUIRE(FileWriter::WriteBytes(path, bytes));
+        }
+
+        ScratchFile(const str& name, strview contents)
+            : ScratchFile(name, vector<u8>(contents.begin(), contents.end())) {}
+
+        ~ScratchFile() {
+            std::error_code error;
+            std::filesystem::remove(path.Str(), error);
+        }
+
+        ScratchFile(const ScratchFile&)            = delete;
+        ScratchFile& operator=(const ScratchFile&) = delete;
+    };
+
+    /// @brief An empty directory tree, removed with everything in it when the fixture goes out of scope.
+    struct ScratchDir {
+        std::filesystem::path root;
+
+        explicit ScratchDir(const str& name) : root(ScratchPath(name).Str()) {
+            std::filesystem::remove_all(root);
+            std::filesystem::create_directories(root);
+        }
+
+        ~ScratchDir() {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+
+        ScratchDir(const ScratchDir&)            = delete;
+        ScratchDir& operator=(const ScratchDir&) = delete;
+
+        /// Writes `contents` to `relative`, creating its parent directories
+        void Write(const str& relative, strview contents) const {
+            const std::filesystem::path file = root / relative;
+            std::filesystem::create_directories(file.parent_path());
+            REQUIRE(FileWriter::WriteBytes(Path(file.string()), vector<u8>(contents.begin(), contents.end())));
+        }
+
+        X_NODISCARD Path Root() const {
+            return Path(root.string());
+        }
+
+        X_NODISCARD Path operator/(const str& relative) const {
+            return Path((root / relative).string());
+        }
+    };
+}  // namespace x::test
@@ -0,0 +1,6 @@
+add_executable(Test.Cpu
+    ${TESTS_DIR}/Cpu/Test.Cpu.cpp
+)
+
+target_link_libraries(Test.Cpu PRIVATE Catch2::Catch2WithMain)
+catch_discover_tests(Test.Cpu)
\ No newline at end of file
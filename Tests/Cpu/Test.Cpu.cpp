@@ -0,0 +1,49 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Cpu.hpp"
+
+using namespace x;
+
+namespace {
+    int Fallback() {
+        return 1;
+    }
+
+    int Accelerated() {
+        return 2;
+    }
+}  // namespace
+
+TEST_CASE("CPU feature detection", "[Cpu]") {
+    SECTION("Detected features are self-consistent") {
+        if (Cpu::Has(CpuFeature::Avx2)) { REQUIRE(Cpu::Has(CpuFeature::Avx)); }
+        if (Cpu::Has(CpuFeature::Avx512Bw)) { REQUIRE(Cpu::Has(CpuFeature::Avx512F)); }
+#if defined(X_SIMD_SSE2)
+        REQUIRE(Cpu::Has(CpuFeature::Sse2));
+#endif
+#if defined(X_SIMD_NEON)
+        REQUIRE(Cpu::Has(CpuFeature::Neon));
+#endif
+        REQUIRE(Cpu::HasAll(0));
+        REQUIRE(Cpu::Features() == Cpu::Features());
+    }
+
+    SECTION("Feature names") {
+        REQUIRE(str(Cpu::FeatureName(CpuFeature::Sse42)) == "SSE4.2");
+        REQUIRE(str(Cpu::FeatureName(CpuFeature::Count)) == "Unknown");
+    }
+
+    SECTION("Dispatch picks the first supported candidate") {
+        // No CPU has every feature on both architectures at once
+        const CpuFeatureMask impossible = CpuMask({CpuFeature::Neon, CpuFeature::Sse2});
+        REQUIRE(CpuSelect<int (*)()>({{impossible, Accelerated}}, Fallback) == Fallback);
+        REQUIRE(CpuSelect<int (*)()>({{impossible, Fallback}, {0, Accelerated}}, Fallback) == Accelerated);
+
+        static CpuDispatch<int (*)()> dispatch {+[] { return CpuSelect<int (*)()>({{0, Accelerated}}, Fallback); }};
+        REQUIRE(dispatch() == 2);
+        REQUIRE(dispatch.Get() == Accelerated);
+    }
+}
@@ -0,0 +1,180 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    using Rows = vector<vector<str>>;
+
+    /// Fields of every row with doubled quotes collapsed
+    Rows ReadAll(CsvReader& reader) {
+        Rows rows;
+        CsvRow row;
+        str scratch;
+        while (reader.Next(row)) {
+            auto& fields = rows.emplace_back();
+            for (size_t i = 0; i < row.Size(); ++i) {
+                fields.emplace_back(row.Unescaped(i, scratch));
+            }
+        }
+        return rows;
+    }
+
+    Rows Parse(strview text, const CsvOptions& options = {}) {
+        CsvReader reader(text, options);
+        return ReadAll(reader);
+    }
+}  // namespace
+
+TEST_CASE("CsvReader in memory", "[Csv]") {
+    SECTION("Plain rows, empty fields and a missing final newline") {
+        REQUIRE(Parse("a,b,c\n1,,3\n,,\nx") ==
+                Rows {{"a", "b", "c"}, {"1", "", "3"}, {"", "", ""}, {"x"}});
+    }
+
+    SECTION("CRLF line endings and blank lines") {
+        REQUIRE(Parse("a,b\r\n\r\n1,2\r\n\n3,4\r\n") == Rows {{"a", "b"}, {"1", "2"}, {"3", "4"}});
+    }
+
+    SECTION("Quoted fields keep delimiters and newlines") {
+        REQUIRE(Parse("\"a,b\",\"line 1\nline 2\",\"crlf\r\ninside\"\nnext,row\n") ==
+                Rows {{"a,b", "line 1\nline 2", "crlf\r\ninside"}, {"next", "row"}});
+    }
+
+    SECTION("Doubled quotes") {
+        CsvReader reader(strview("\"say \"\"hi\"\"\",\"\"\"\",\"\"\n"));
+        CsvRow row;
+        REQUIRE(reader.Next(row));
+        REQUIRE(row.Size() == 3);
+        // Views keep the doubled quotes; Unescaped collapses them
+        REQUIRE(row[0] == "say \"\"hi\"\"");
+        str scratch;
+        REQUIRE(row.Unescaped(0, scratch) == "say \"hi\"");
+        REQUIRE(row.Unescaped(1, scratch) == "\"");
+        REQUIRE(row.Unescaped(2, scratch).empty());
+        REQUIRE_FALSE(reader.Next(row));
+    }
+
+    SECTION("Row offsets") {
+        CsvReader reader(strview("a,b\n\"x\ny\",z\nlast"));
+        CsvRow row;
+        vector<u64> offsets;
+        while (reader.Next(row)) {
+            offsets.push_back(row.Offset());
+        }
+        REQUIRE(offsets == vector<u64> {0, 4, 12});
+    }
+
+    SECTION("TSV with a custom quote") {
+        CsvOptions options;
+        options.delimiter = '\t';
+        options.quote     = '\'';
+        REQUIRE(Parse("a\tb,c\t'd\te'\n'it''s'\t\n", options) == Rows {{"a", "b,c", "d\te"}, {"it's", ""}});
+    }
+
+    SECTION("Separators in every lane of a 64-byte block") {
+        // Shift a quoted field with an embedded delimiter and newline across each block offset
+        for (size_t prefix = 1; prefix < 130; ++prefix) {
+            const str text = str(prefix, 'p') + ",\"q,\nq\"\"\",tail\n" + str(prefix, 'r') + "\n";
+            REQUIRE(Parse(text) == Rows {{str(prefix, 'p'), "q,\nq\"", "tail"}, {str(prefix, 'r')}});
+        }
+    }
+}
+
+TEST_CASE("CsvReader from a file", "[Csv]") {
+    // Long quoted fields with embedded newlines, CRLFs and doubled quotes, so fields, quote pairs and line
+    // endings all straddle refills of a small buffer
+    str text;
+    for (i32 i = 0; i < 200; ++i) {
+        text += X_TOSTR(i) + ",\"" + str(CAST<size_t>(i % 97), 'x') + "\"\"\n,\"\"" + str(CAST<size_t>(i % 13), 'y') +
+                "\"," + str(CAST<size_t>(i % 71), 'z') + (i % 2 ? "\r\n" : "\n");
+    }
+    ScratchFile file("csv_refills.csv", text);
+    const Rows expected = Parse(text);
+    REQUIRE(expected.size() == 200);
+    REQUIRE(expected[5] == vector<str> {"5", "xxxxx\"\n,\"yyyyy", "zzzzz"});
+
+    for (const size_t bufferSize : {size_t(64), size_t(100), size_t(4096)}) {
+        CsvReader reader(file.path, {}, bufferSize);
+        REQUIRE(reader.IsOpen());
+        REQUIRE(ReadAll(reader) == expected);
+        REQUIRE(reader.Position() == text.size());
+    }
+}
+
+TEST_CASE("CsvReader::ParseParallel", "[Csv]") {
+    // Each row carries a quoted field of more than a megabyte full of delimiters, newlines and doubled quotes, so
+    // the chunk boundaries land inside quotes
+    str body;
+    while (body.size() < 1_MEGABYTES + 300_KILOBYTES) {
+        body += "text, \"\"quoted\"\"\nand more\r\n";
+    }
+    str text;
+    for (i32 i = 0; i < 4; ++i) {
+        text += "row" + X_TOSTR(i) + ",\"" + body + "\",end\n";
+        text += "small" + X_TOSTR(i) + ",1,2\n";
+    }
+    const Rows expected = Parse(text);
+    REQUIRE(expected.size() == 8);
+
+    for (const u32 threads : {1u, 4u}) {
+        std::mutex mutex;
+        std::map<std::pair<size_t, u64>, vector<str>> byPosition;  // Chunk, then row offset
+        const u64 count = CsvReader::ParseParallel(
+          text,
+          [&](size_t chunk, const CsvRow& row) {
+              vector<str> fields;
+              str scratch;
+              for (size_t i = 0; i < row.Size(); ++i) {
+                  fields.emplace_back(row.Unescaped(i, scratch));
+              }
+              std::lock_guard lock(mutex);
+              byPosition.emplace(std::pair {chunk, row.Offset()}, std::move(fields));
+          },
+          {},
+          threads);
+
+        REQUIRE(count == expected.size());
+        Rows rows;
+        for (auto& [position, fields] : byPosition) {
+            rows.push_back(std::move(fields));
+        }
+        REQUIRE(rows == expected);
+    }
+}
+
+TEST_CASE("CsvReader::ParseParallel with a throwing callback", "[Csv]") {
+    str text;
+    while (text.size() < 4_MEGABYTES) {
+        text += "a,b,c\n";
+    }
+
+    // The first chunk is parsed on the caller, later ones mostly on helpers; every other call throws too
+    for (const u32 threads : {1u, 4u}) {
+        for (const size_t failing : {size_t(0), size_t(3), SIZE_MAX}) {
+            std::atomic<u64> calls {0};
+            REQUIRE_THROWS_AS(CsvReader::ParseParallel(
+                                text,
+                                [&](size_t chunk, const CsvRow&) {
+                                    calls.fetch_add(1, std::memory_order_relaxed);
+                                    if (failing == SIZE_MAX || chunk == failing) {
+                                        throw std::runtime_error("row");
+                                    }
+                                },
+                                {},
+                                threads),
+                              std::runtime_error);
+            REQUIRE(calls.load() < 4_MEGABYTES / 6);
+        }
+    }
+}
@@ -0,0 +1,255 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    namespace fs = std::filesystem;
+
+    /// File name, line, offset and pattern of a match, which sort into a stable order
+    using Hit = std::tuple<str, u64, u64, u32>;
+
+    vector<Hit> Collect(const Path& root,
+                        std::span<const strview> patterns,
+                        const SearchOptions& options = {},
+                        SearchStats* stats           = nullptr) {
+        vector<Hit> hits;
+        const SearchStats result = FileSearcher::Search(
+          root,
+          patterns,
+          [&](const SearchMatch& match) {
+              const str name = fs::path(match.path->Str()).filename().string();
+              hits.emplace_back(name, match.line, match.offset, match.pattern);
+              return true;
+          },
+          options);
+        if (stats) { *stats = result; }
+        std::ranges::sort(hits);
+        return hits;
+    }
+
+    vector<Hit> Collect(const Path& root,
+                        strview pattern,
+                        const SearchOptions& options = {},
+                        SearchStats* stats           = nullptr) {
+        return Collect(root, std::span<const strview>(&pattern, 1), options, stats);
+    }
+}  // namespace
+
+TEST_CASE("FileSearcher reports lines and offsets", "[FileSearcher]") {
+    const ScratchDir dir("search_lines");
+    dir.Write("a.txt", "needle\nhay\nhay needle needle\n\nneedle");
+
+    SECTION("One pattern") {
+        REQUIRE(Collect(dir.Root(), "needle") ==
+                vector<Hit> {{"a.txt", 1, 0, 0}, {"a.txt", 3, 15, 0}, {"a.txt", 3, 22, 0}, {"a.txt", 5, 30, 0}});
+    }
+
+    SECTION("Several patterns, overlapping") {
+        const strview patterns[] = {"needle", "dle\nhay", "hay"};
+        REQUIRE(Collect(dir.Root(), patterns) == vector<Hit> {{"a.txt", 1, 0, 0},
+                                                              {"a.txt", 1, 3, 1},
+                                                              {"a.txt", 2, 7, 2},
+                                                              {"a.txt", 3, 11, 2},
+                                                              {"a.txt", 3, 15, 0},
+                                                              {"a.txt", 3, 22, 0},
+                                                              {"a.txt", 5, 30, 0}});
+    }
+
+    SECTION("A single file as the root") {
+        REQUIRE(Collect(dir / "a.txt", "hay") ==
+                vector<Hit> {{"a.txt", 2, 7, 0}, {"a.txt", 3, 11, 0}});
+    }
+}
+
+TEST_CASE("FileSearcher stops early", "[FileSearcher]") {
+    const ScratchDir dir("search_stop");
+    for (int i = 0; i < 8; ++i) {
+        dir.Write("f" + std::to_string(i) + ".txt", "x x x x x\n");
+    }
+
+    SECTION("maxResults caps the matches delivered") {
+        for (const u32 threads : {1u, 4u}) {
+            SearchOptions options;
+            options.maxResults = 7;
+            options.threads    = threads;
+            SearchStats stats;
+            REQUIRE(Collect(dir.Root(), "x", options, &stats).size() == 7);
+            REQUIRE(stats.matches == 7);
+            REQUIRE(stats.stoppedEarly);
+        }
+    }
+
+    SECTION("The callback returning false") {
+        u64 calls                = 0;
+        const SearchStats result =
+          FileSearcher::Search(dir.Root(), "x", [&](const SearchMatch&) { return ++calls < 3; });
+        REQUIRE(calls == 3);
+        REQUIRE(result.matches == 3);
+        REQUIRE(result.stoppedEarly);
+    }
+
+    SECTION("A cancelled token") {
+        CancellationSource source;
+        source.Cancel();
+        SearchOptions options;
+        options.token = source.Token();
+        u64 calls     = 0;
+        const SearchStats result =
+          FileSearcher::Search(dir.Root(), "x", [&](const SearchMatch&) { return ++calls, true; }, options);
+        REQUIRE(calls == 0);
+        REQUIRE(result.stoppedEarly);
+    }
+
+    SECTION("Async I/O still runs while the search holds its threads") {
+        // More search threads than executor workers; were they pool workers, this read would never be scheduled
+        SearchOptions options;
+        options.threads = IoExecutor::Default().ThreadCount() * 2;
+        u64 reads       = 0;
+        FileSearcher::Search(
+          dir.Root(),
+          "x",
+          [&](const SearchMatch& match) {
+              if (reads == 0) { reads += AsyncFileReader::ReadText(*match.path).Get().size() > 0; }
+              return true;
+          },
+          options);
+        REQUIRE(reads == 1);
+    }
+
+    SECTION("An exception from the callback reaches the caller") {
+        for (const u32 threads : {1u, 4u}) {
+            SearchOptions options;
+            options.threads = threads;
+            REQUIRE_THROWS_AS(FileSearcher::Search(
+                                dir.Root(),
+                                "x",
+                                [](const SearchMatch&) -> bool { throw std::runtime_error("callback"); },
+                                options),
+                              std::runtime_error);
+        }
+    }
+}
+
+TEST_CASE("FileSearcher walks the tree", "[FileSearcher]") {
+    const ScratchDir dir("search_walk");
+    dir.Write("top.txt", "match");
+    dir.Write("top.log", "match");
+    dir.Write("sub/deep/inner.txt", "match");
+    dir.Write("empty.txt", "");
+    dir.Write("binary.txt", str("match\0match", 11));
+
+    SECTION("Recursive by default, binary files skipped") {
+        SearchStats stats;
+        REQUIRE(Collect(dir.Root(), "match", {}, &stats) ==
+                vector<Hit> {{"inner.txt", 1, 0, 0}, {"top.log", 1, 0, 0}, {"top.txt", 1, 0, 0}});
+        REQUIRE(stats.binaryFiles == 1);
+        REQUIRE(stats.filesSearched == 4);  // Including the empty file
+        REQUIRE(stats.failedFiles == 0);
+    }
+
+    SECTION("Binary files searched when asked") {
+        SearchOptions options;
+        options.skipBinary = false;
+        REQUIRE(std::ranges::count(Collect(dir.Root(), "match", options), str("binary.txt"), [](const Hit& hit) {
+                    return std::get<0>(hit);
+                }) == 2);
+    }
+
+    SECTION("Non-recursive") {
+        SearchOptions options;
+        options.recursive = false;
+        REQUIRE(Collect(dir.Root(), "match", options) == vector<Hit> {{"top.log", 1, 0, 0}, {"top.txt", 1, 0, 0}});
+    }
+
+    SECTION("Extensions") {
+        SearchOptions options;
+        options.extensions = {"LOG"};
+        REQUIRE(Collect(dir.Root(), "match", options) == vector<Hit> {{"top.log", 1, 0, 0}});
+    }
+
+#ifndef _WIN32
+    SECTION("Symbolic links are not followed") {
+        const ScratchDir outside("search_walk_outside");
+        outside.Write("linked.txt", "match");
+        fs::create_directory_symlink(outside.root, dir.root / "link_dir");
+        fs::create_symlink(outside.root / "linked.txt", dir.root / "link_file.txt");
+        fs::create_directory_symlink(dir.root, dir.root / "sub" / "cycle");
+
+        REQUIRE(Collect(dir.Root(), "match") ==
+                vector<Hit> {{"inner.txt", 1, 0, 0}, {"top.log", 1, 0, 0}, {"top.txt", 1, 0, 0}});
+    }
+#endif
+}
+
+TEST_CASE("FileSearcher on large files", "[FileSearcher]") {
+    // Larger than the read threshold, so the file is mapped, and spanning several scan chunks
+    constexpr size_t kSize = 3 * 1024 * 1024 + 123;
+    str text(kSize, 'a');
+    for (size_t i = 1000; i < kSize; i += 1000) {
+        text[i] = '\n';
+    }
+
+    // Matches straddling a 1 MiB chunk boundary, ending exactly on one, starting exactly on one and ending the file
+    const strview pattern = "needle";
+    vector<u64> offsets   = {(1u << 20) - 206, (1u << 20) - 3, (2u << 20) - 6, (5u << 19) + 1, 3u << 20, kSize - 6};
+    std::ranges::sort(offsets);
+    for (const u64 offset : offsets) {
+        text.replace(offset, pattern.size(), pattern);
+    }
+
+    const ScratchDir dir("search_large");
+    dir.Write("big.txt", text);
+
+    vector<Hit> expected;
+    for (const u64 offset : offsets) {
+        const u64 line = 1 + CAST<u64>(std::count(text.begin(), text.begin() + CAST<std::ptrdiff_t>(offset), '\n'));
+        expected.emplace_back("big.txt", line, offset, 0);
+    }
+
+    SECTION("Every match found once, with its line") {
+        REQUIRE(Collect(dir.Root(), pattern) == expected);
+    }
+
+    SECTION("Matches stream out while the file is still being scanned") {
+        const str dense(kSize, 'x');
+        const ScratchDir denseDir("search_dense");
+        denseDir.Write("dense.txt", dense);
+
+        // Cancelling from the first callback must leave most of the file unscanned and undelivered
+        CancellationSource source;
+        SearchOptions options;
+        options.token = source.Token();
+        std::set<const Path*> paths;
+        const SearchStats stats = FileSearcher::Search(
+          denseDir.Root(),
+          "x",
+          [&](const SearchMatch& match) {
+              paths.insert(match.path.get());
+              source.Cancel();
+              return true;
+          },
+          options);
+        REQUIRE(stats.matches >= 1);
+        REQUIRE(stats.matches < kSize / 2);
+        REQUIRE(stats.stoppedEarly);
+        REQUIRE(paths.size() == 1);  // One path shared by every match of the file
+    }
+
+    SECTION("With a longer pattern setting the overlap") {
+        const str longer         = str(64, 'b');
+        const strview patterns[] = {"needle", longer};
+        REQUIRE(Collect(dir.Root(), patterns) == expected);
+    }
+}
@@ -0,0 +1,8 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.Future
+    ${TESTS_DIR}/Future/Test.Future.cpp
+)
+
+target_link_libraries(Test.Future PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.Future)
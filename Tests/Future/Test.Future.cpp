@@ -0,0 +1,158 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Future.hpp"
+#include <stdexcept>
+
+using namespace x;
+
+TEST_CASE("Future basics", "[Future]") {
+    IoExecutor executor(2);
+
+    SECTION("Async returns the function's result") {
+        auto future = Async(executor, IoPriority::Normal, [] { return 42; });
+        REQUIRE(future.Valid());
+        REQUIRE(future.Get() == 42);
+        REQUIRE_FALSE(future.Valid());
+    }
+
+    SECTION("Async propagates exceptions to Get") {
+        auto future = Async(executor, IoPriority::Normal, []() -> int { throw std::runtime_error("boom"); });
+        REQUIRE_THROWS_AS(future.Get(), std::runtime_error);
+    }
+
+    SECTION("Promise delivers a value set later") {
+        Promise<str> promise;
+        auto future = promise.GetFuture();
+        REQUIRE_FALSE(future.IsReady());
+        promise.SetValue("done");
+        REQUIRE(future.IsReady());
+        REQUIRE(future.Get() == "done");
+    }
+
+    SECTION("A dropped Promise breaks its Future") {
+        Future<int> future;
+        {
+            Promise<int> promise;
+            future = promise.GetFuture();
+        }
+        REQUIRE_THROWS_AS(future.Get(), std::future_error);
+    }
+}
+
+TEST_CASE("Future continuations", "[Future]") {
+    IoExecutor executor(2);
+
+    SECTION("Then chains values in order") {
+        auto future = Async(executor, IoPriority::Normal, [] { return 2; })
+                        .Then(executor, IoPriority::Normal, [](int value) { return value * 10; })
+                        .Then(executor, IoPriority::Normal, [](int value) { return X_TOSTR(value + 1); });
+        REQUIRE(future.Get() == "21");
+    }
+
+    SECTION("Then on a future that is already ready") {
+        auto ready = MakeReadyFuture(5);
+        REQUIRE(ready.IsReady());
+        REQUIRE(ready.Then(executor, IoPriority::Normal, [](int value) { return value + 1; }).Get() == 6);
+    }
+
+    SECTION("Void futures chain") {
+        std::atomic<int> calls {0};
+        auto future = Async(executor, IoPriority::Normal, [&] { ++calls; }).Then(executor, IoPriority::Normal, [&] {
+            ++calls;
+            return calls.load();
+        });
+        REQUIRE(future.Get() == 2);
+    }
+
+    SECTION("An upstream exception skips the continuation") {
+        std::atomic<bool> ran {false};
+        auto future = Async(executor, IoPriority::Normal, []() -> int { throw std::runtime_error("upstream"); })
+                        .Then(executor, IoPriority::Normal, [&](int value) {
+                            ran = true;
+                            return value;
+                        });
+        REQUIRE_THROWS_AS(future.Get(), std::runtime_error);
+        REQUIRE_FALSE(ran.load());
+    }
+
+    SECTION("A throwing continuation fails its own future") {
+        auto future = MakeReadyFuture(1).Then(executor, IoPriority::Normal, [](int) -> int {
+            throw std::logic_error("continuation");
+        });
+        REQUIRE_THROWS_AS(future.Get(), std::logic_error);
+    }
+}
+
+TEST_CASE("Future combinators", "[Future]") {
+    SECTION("WhenAll keeps input order regardless of completion order") {
+        vector<Promise<int>> promises(3);
+        vector<Future<int>> futures;
+        for (auto& promise : promises) {
+            futures.push_back(promise.GetFuture());
+        }
+        auto all = WhenAll(std::move(futures));
+
+        promises[2].SetValue(30);
+        promises[0].SetValue(10);
+        REQUIRE_FALSE(all.IsReady());
+        promises[1].SetValue(20);
+
+        REQUIRE(all.IsReady());
+        REQUIRE(all.Get() == vector<int> {10, 20, 30});
+    }
+
+    SECTION("WhenAll of nothing is ready immediately") {
+        auto all = WhenAll(vector<Future<int>> {});
+        REQUIRE(all.IsReady());
+        REQUIRE(all.Get().empty());
+    }
+
+    SECTION("WhenAll fails with the first error") {
+        vector<Promise<int>> promises(3);
+        vector<Future<int>> futures;
+        for (auto& promise : promises) {
+            futures.push_back(promise.GetFuture());
+        }
+        auto all = WhenAll(std::move(futures));
+
+        promises[1].SetException(std::make_exception_ptr(std::runtime_error("first")));
+        REQUIRE(all.IsReady());
+        promises[0].SetException(std::make_exception_ptr(std::logic_error("second")));
+        promises[2].SetValue(3);
+        REQUIRE_THROWS_AS(all.Get(), std::runtime_error);
+    }
+
+    SECTION("WhenAny resolves with the first input to finish") {
+        vector<Promise<int>> promises(3);
+        vector<Future<int>> futures;
+        for (auto& promise : promises) {
+            futures.push_back(promise.GetFuture());
+        }
+        auto any = WhenAny(std::move(futures));
+        REQUIRE_FALSE(any.IsReady());
+
+        promises[2].SetValue(7);
+        promises[0].SetValue(1);
+        promises[1].SetValue(2);
+
+        const auto result = any.Get();
+        REQUIRE(result.index == 2);
+        REQUIRE(result.value == 7);
+    }
+
+    SECTION("WhenAny forwards the winner's error") {
+        vector<Promise<int>> promises(2);
+        vector<Future<int>> futures;
+        for (auto& promise : promises) {
+            futures.push_back(promise.GetFuture());
+        }
+        auto any = WhenAny(std::move(futures));
+
+        promises[1].SetException(std::make_exception_ptr(std::runtime_error("winner")));
+        promises[0].SetValue(1);
+        REQUIRE_THROWS_AS(any.Get(), std::runtime_error);
+    }
+}
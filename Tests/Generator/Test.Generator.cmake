@@ -0,0 +1,9 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.Generator
+    ${TESTS_DIR}/Generator/Test.Generator.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Test.Generator PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.Generator)
@@ -0,0 +1,170 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Generator.hpp"
+#include "Common/Scratch.hpp"
+#include <stdexcept>
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    struct Counter {
+        i32 produced  = 0;
+        i32 destroyed = 0;
+    };
+
+    struct DestroyGuard {
+        Counter& counter;
+        ~DestroyGuard() {
+            ++counter.destroyed;
+        }
+    };
+
+    Generator<i32> Count(Counter& counter, i32 limit) {
+        DestroyGuard guard {counter};
+        for (i32 i = 0; i < limit; ++i) {
+            ++counter.produced;
+            co_yield i;
+        }
+    }
+
+    Generator<i32> ThrowAfter(i32 count) {
+        for (i32 i = 0; i < count; ++i) {
+            co_yield i;
+        }
+        throw std::runtime_error("generator failed");
+    }
+
+    vector<str> CollectLines(const Path& path, size_t bufferSize) {
+        vector<str> lines;
+        for (auto line : FileReader::StreamLines(path, bufferSize)) {
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+}  // namespace
+
+TEST_CASE("Generator", "[Generator]") {
+    SECTION("Nothing runs before begin") {
+        Counter counter;
+        {
+            auto values = Count(counter, 3);
+            REQUIRE(counter.produced == 0);
+
+            auto it = values.begin();
+            REQUIRE(*it == 0);
+            REQUIRE(counter.produced == 1);
+            ++it;
+            REQUIRE(*it == 1);
+            REQUIRE(counter.produced == 2);
+        }
+        // Destroying it part way unwinds the coroutine frame without producing the rest
+        REQUIRE(counter.produced == 2);
+        REQUIRE(counter.destroyed == 1);
+    }
+
+    SECTION("A generator that never started does not run its body") {
+        Counter counter;
+        { auto values = Count(counter, 3); }
+        // The body, guard included, never ran; the frame itself is still freed
+        REQUIRE(counter.produced == 0);
+        REQUIRE(counter.destroyed == 0);
+    }
+
+    SECTION("Breaking out of a range-for destroys the frame") {
+        Counter counter;
+        {
+            for (auto value : Count(counter, 100)) {
+                if (value == 4) { break; }
+            }
+            REQUIRE(counter.destroyed == 1);
+        }
+        REQUIRE(counter.produced == 5);
+    }
+
+    SECTION("Runs to completion") {
+        Counter counter;
+        vector<i32> values;
+        for (auto value : Count(counter, 4)) {
+            values.push_back(value);
+        }
+        REQUIRE(values == vector<i32> {0, 1, 2, 3});
+        REQUIRE(counter.destroyed == 1);
+    }
+
+    SECTION("Composes with range adaptors") {
+        Counter counter;
+        vector<i32> values;
+        for (auto value : Count(counter, 10) | std::views::filter([](i32 v) { return v % 3 == 0; }) |
+                            std::views::take(2)) {
+            values.push_back(value);
+        }
+        REQUIRE(values == vector<i32> {0, 3});
+        REQUIRE(counter.produced < 10);
+    }
+
+    SECTION("Moving transfers the frame") {
+        Counter counter;
+        auto first  = Count(counter, 2);
+        auto it     = first.begin();
+        auto second = std::move(first);
+        REQUIRE(counter.destroyed == 0);
+        ++it;
+        REQUIRE(*it == 1);
+
+        // Assigning over a generator destroys the frame it held
+        second = Count(counter, 1);
+        REQUIRE(counter.destroyed == 1);
+    }
+
+    SECTION("Exceptions surface from the step that threw") {
+        auto values = ThrowAfter(2);
+        auto it     = values.begin();
+        REQUIRE(*it == 0);
+        ++it;
+        REQUIRE(*it == 1);
+        REQUIRE_THROWS_AS(++it, std::runtime_error);
+    }
+}
+
+TEST_CASE("FileReader::StreamLines", "[Generator]") {
+    SECTION("Splits LF and CRLF lines and keeps an unterminated last line") {
+        ScratchFile file("generator_mixed.txt", "alpha\r\nbeta\n\ngamma");
+        REQUIRE(CollectLines(file.path, 64) == vector<str> {"alpha", "beta", "", "gamma"});
+    }
+
+    SECTION("A trailing newline does not add an empty line") {
+        ScratchFile file("generator_trailing.txt", "one\ntwo\n");
+        REQUIRE(CollectLines(file.path, 64) == vector<str> {"one", "two"});
+    }
+
+    SECTION("Lines longer than the buffer are kept whole") {
+        const str longLine(100, 'x');
+        ScratchFile file("generator_long.txt", "a\n" + longLine + "\nb\r\n" + longLine);
+        REQUIRE(CollectLines(file.path, 8) == vector<str> {"a", longLine, "b", longLine});
+    }
+
+    SECTION("A CRLF split across refills is still trimmed") {
+        ScratchFile file("generator_split.txt", "abc\r\ndef\r\n");
+        REQUIRE(CollectLines(file.path, 4) == vector<str> {"abc", "def"});
+    }
+
+    SECTION("A missing file yields nothing") {
+        REQUIRE(CollectLines(ScratchPath("generator_missing.txt"), 64).empty());
+    }
+
+    SECTION("The file is not opened until iteration starts") {
+        auto lines = FileReader::StreamLines(ScratchPath("generator_late.txt"), 16);
+        ScratchFile file("generator_late.txt", "created after the call\n");
+
+        vector<str> collected;
+        for (auto line : lines) {
+            collected.emplace_back(line);
+        }
+        REQUIRE(collected == vector<str> {"created after the call"});
+    }
+}
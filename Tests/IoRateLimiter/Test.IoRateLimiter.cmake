@@ -0,0 +1,9 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.IoRateLimiter
+    ${TESTS_DIR}/IoRateLimiter/Test.IoRateLimiter.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Test.IoRateLimiter PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.IoRateLimiter)
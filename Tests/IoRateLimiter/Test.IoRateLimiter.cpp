@@ -0,0 +1,165 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "IoRateLimiter.hpp"
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+
+using namespace x;
+using namespace x::test;
+using namespace std::chrono_literals;
+
+namespace {
+    IoRateLimiter::Clock::time_point gFakeNow {};
+
+    IoRateLimiter::Clock::time_point FakeNow() {
+        return gFakeNow;
+    }
+
+    void Advance(IoRateLimiter::Clock::duration by) {
+        gFakeNow += by;
+    }
+}  // namespace
+
+TEST_CASE("IoRateLimiter token bucket", "[IoRateLimiter]") {
+    IoRateLimiter limiter;
+    limiter.SetClock(&FakeNow);
+
+    SECTION("Unlimited by default") {
+        REQUIRE(limiter.IsUnlimited());
+        REQUIRE(limiter.TryAcquire(1_GIGABYTES, 1000000));
+        REQUIRE(limiter.Reserve(1_GIGABYTES, 1000000) == IoRateLimiter::Clock::duration::zero());
+    }
+
+    SECTION("Burst defaults to one second of bandwidth and starts full") {
+        limiter.SetRates(1000);
+        REQUIRE_FALSE(limiter.IsUnlimited());
+        REQUIRE(limiter.TryAcquire(1000));
+        REQUIRE_FALSE(limiter.TryAcquire(1));
+    }
+
+    SECTION("Explicit burst caps the bucket") {
+        limiter.SetRates(1000, 0, 200);
+        REQUIRE(limiter.TryAcquire(200));
+        REQUIRE_FALSE(limiter.TryAcquire(1));
+
+        // Idle time refills only up to the burst size
+        Advance(10s);
+        REQUIRE_FALSE(limiter.TryAcquire(201));
+        REQUIRE(limiter.TryAcquire(200));
+    }
+
+    SECTION("Tokens refill at the configured rate") {
+        limiter.SetRates(1000, 0, 1000);
+        REQUIRE(limiter.TryAcquire(1000));
+
+        Advance(250ms);
+        REQUIRE_FALSE(limiter.TryAcquire(251));
+        REQUIRE(limiter.TryAcquire(250));
+        REQUIRE_FALSE(limiter.TryAcquire(1));
+
+        Advance(500ms);
+        REQUIRE(limiter.TryAcquire(500));
+    }
+
+    SECTION("Oversized requests go into debt and later callers wait it out") {
+        limiter.SetRates(1000, 0, 100);
+        REQUIRE(limiter.Reserve(100) == IoRateLimiter::Clock::duration::zero());
+
+        // 500 bytes of debt at 1000 B/s
+        const auto wait = limiter.Reserve(500);
+        REQUIRE(wait > 499ms);
+        REQUIRE(wait < 501ms);
+
+        Advance(250ms);
+        REQUIRE_FALSE(limiter.TryAcquire(1));
+        Advance(250ms);
+        REQUIRE(limiter.Reserve(0, 0) == IoRateLimiter::Clock::duration::zero());
+        Advance(100ms);
+        REQUIRE(limiter.TryAcquire(100));
+    }
+
+    SECTION("Op rate limits independently of bandwidth") {
+        limiter.SetRates(0, 10, 0, 2);
+        REQUIRE(limiter.TryAcquire(1_GIGABYTES));
+        REQUIRE(limiter.TryAcquire(1_GIGABYTES));
+        REQUIRE_FALSE(limiter.TryAcquire(0));
+
+        Advance(100ms);
+        REQUIRE(limiter.TryAcquire(0));
+        REQUIRE_FALSE(limiter.TryAcquire(0));
+
+        const auto wait = limiter.Reserve(0, 3);
+        REQUIRE(wait > 299ms);
+        REQUIRE(wait < 301ms);
+    }
+
+    SECTION("The slower of both dimensions sets the wait") {
+        limiter.SetRates(1000, 10, 1, 1);
+        const auto wait = limiter.Reserve(101, 3);  // 100ms of bytes, 200ms of ops
+        REQUIRE(wait > 199ms);
+        REQUIRE(wait < 201ms);
+    }
+
+    SECTION("Released tokens pay back the debt they ran up") {
+        limiter.SetRates(1000, 10, 1000, 10);
+        REQUIRE(limiter.Reserve(3000, 1) > 1999ms);
+        limiter.Release(3000, 1);
+        REQUIRE(limiter.TryAcquire(1000, 10));
+        REQUIRE_FALSE(limiter.TryAcquire(1, 0));
+
+        // Time served during the wait refills on its own, so a late release still cannot overfill the bucket
+        REQUIRE(limiter.Reserve(500, 0) > 499ms);
+        Advance(300ms);
+        limiter.Release(500, 0);
+        REQUIRE(limiter.TryAcquire(300, 0));
+        REQUIRE_FALSE(limiter.TryAcquire(1, 0));
+
+        Advance(10s);
+        limiter.Release(5000, 0);
+        REQUIRE_FALSE(limiter.TryAcquire(1001, 0));
+        REQUIRE(limiter.TryAcquire(1000, 0));
+    }
+
+    SECTION("Chunk size follows the burst within bounds") {
+        limiter.SetRates(64_KILOBYTES);
+        REQUIRE(limiter.ChunkSize() == 64_KILOBYTES);
+        limiter.SetRates(1000);
+        REQUIRE(limiter.ChunkSize() == 4_KILOBYTES);
+        limiter.SetRates(1_GIGABYTES);
+        REQUIRE(limiter.ChunkSize() == 1_MEGABYTES);
+        limiter.SetRates(0, 100);
+        REQUIRE(limiter.ChunkSize() == 1_MEGABYTES);
+    }
+
+    SECTION("Shared returns one limiter per traffic class") {
+        auto a = IoRateLimiter::Shared("test.a");
+        REQUIRE(a == IoRateLimiter::Shared("test.a"));
+        REQUIRE(a != IoRateLimiter::Shared("test.b"));
+        REQUIRE(a->IsUnlimited());
+    }
+}
+
+TEST_CASE("Cancelled transfers hand their tokens back", "[IoRateLimiter]") {
+    const auto limiter = make_shared<IoRateLimiter>(1000);
+    limiter->SetClock(&FakeNow);  // Frozen, so the bucket only changes through Reserve and Release
+    AsyncFileWriter::SetRateLimiter(limiter);
+
+    // 3000 bytes against a full 1000-byte bucket: the write reserves them all and then waits out 2s of debt
+    const ScratchFile file("ratelimiter_cancelled.bin", "");
+    CancellationSource source;
+    AsyncOptions options;
+    options.token = source.Token();
+    auto write    = AsyncFileWriter::WriteBytes(file.path, vector<u8>(3000, 'x'), options);
+
+    while (limiter->TryAcquire(0, 0)) {  // Succeeds until the write has put the bucket in debt
+        std::this_thread::yield();
+    }
+    source.Cancel();
+    REQUIRE_FALSE(write.Get());
+    AsyncFileWriter::SetRateLimiter(nullptr);
+
+    REQUIRE(limiter->TryAcquire(1000, 0));
+}
@@ -0,0 +1,8 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.IoStats
+    ${TESTS_DIR}/IoStats/Test.IoStats.cpp
+)
+
+target_link_libraries(Test.IoStats PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.IoStats)
@@ -0,0 +1,117 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "IoStats.hpp"
+#include <thread>
+
+using namespace x;
+
+TEST_CASE("Latency histogram", "[IoStats]") {
+    SECTION("Small values get exact buckets") {
+        for (u64 value = 0; value < IoHistogram::kSubBucketCount; ++value) {
+            REQUIRE(IoHistogram::BucketIndex(value) == value);
+            REQUIRE(IoHistogram::BucketUpperBound(CAST<u32>(value)) == value);
+        }
+    }
+
+    SECTION("Every value lands in the bucket whose range holds it, within 12.5%") {
+        for (u64 value = 1; value < (u64(1) << 38); value = value * 3 / 2 + 1) {
+            for (const u64 probe : {value - 1, value, value + 1}) {
+                const u32 index = IoHistogram::BucketIndex(probe);
+                REQUIRE(index < IoHistogram::kBucketCount);
+                REQUIRE(IoHistogram::BucketUpperBound(index) >= probe);
+                if (index > 0) { REQUIRE(IoHistogram::BucketUpperBound(index - 1) < probe); }
+                REQUIRE(CAST<f64>(IoHistogram::BucketUpperBound(index) - probe) <= CAST<f64>(probe) * 0.125);
+            }
+        }
+    }
+
+    SECTION("Huge values clamp into the last bucket") {
+        const u32 last = IoHistogram::kBucketCount - 1;
+        REQUIRE(IoHistogram::BucketIndex(u64(1) << 40) == last);
+        REQUIRE(IoHistogram::BucketIndex(UINT64_MAX) == last);
+        REQUIRE(IoHistogram::BucketUpperBound(last) == (u64(1) << 40) - 1);
+    }
+
+    SECTION("Percentiles round up to bucket bounds") {
+        IoHistogram histogram;
+        REQUIRE(histogram.Percentile(50) == 0);
+
+        for (u64 value = 1; value <= 100; ++value) {
+            histogram.Record(value);
+        }
+        REQUIRE(histogram.Count() == 100);
+        REQUIRE(histogram.Percentile(0) == 1);
+        REQUIRE(histogram.Percentile(50) == IoHistogram::BucketUpperBound(IoHistogram::BucketIndex(50)));
+        REQUIRE(histogram.Percentile(100) == IoHistogram::BucketUpperBound(IoHistogram::BucketIndex(100)));
+        REQUIRE(histogram.Percentile(250) == histogram.Percentile(100));
+
+        IoHistogram other;
+        other.Record(1000, 300);
+        histogram.Merge(other);
+        REQUIRE(histogram.Count() == 400);
+        REQUIRE(histogram.Percentile(50) == IoHistogram::BucketUpperBound(IoHistogram::BucketIndex(1000)));
+    }
+}
+
+TEST_CASE("Per-operation and per-prefix statistics", "[IoStats]") {
+    const i32 logs   = IoStats::AddPathPrefix("/data/logs");
+    const i32 data   = IoStats::AddPathPrefix("/data");
+    const i32 nested = IoStats::AddPathPrefix("/data/logs/archive");
+    REQUIRE(logs >= 0);
+    REQUIRE(data >= 0);
+    REQUIRE(nested >= 0);
+    REQUIRE(IoStats::AddPathPrefix("/data/logs") == logs);
+
+    SECTION("Paths go to the longest matching prefix") {
+        REQUIRE(IoStats::MatchPrefix("/data/logs/archive/2026.log") == nested);
+        REQUIRE(IoStats::MatchPrefix("/data/logs/today.log") == logs);
+        REQUIRE(IoStats::MatchPrefix("/data/cache.bin") == data);
+        REQUIRE(IoStats::MatchPrefix("/tmp/other") == -1);
+    }
+
+    SECTION("Records from live and exited threads are merged, and Reset keeps the prefixes") {
+        IoStats::Reset();
+        IoStats::Record(IoOp::ReadBytes, logs, 100, 10, true);
+        std::thread([&] {
+            IoStats::Record(IoOp::ReadBytes, logs, 50, 1000, false);
+            IoStats::Record(IoOp::WriteBytes, -1, 7, 5, true);
+        }).join();
+
+        const auto snapshot = IoStats::Snapshot();
+        const auto& reads   = snapshot.ops[CAST<size_t>(IoOp::ReadBytes)];
+        REQUIRE(reads.count == 2);
+        REQUIRE(reads.errors == 1);
+        REQUIRE(reads.bytes == 150);
+        REQUIRE(reads.maxNs == 1000);
+        REQUIRE(reads.MeanNs() == 505.0);
+        REQUIRE(snapshot.ops[CAST<size_t>(IoOp::WriteBytes)].bytes == 7);
+
+        REQUIRE(snapshot.prefixes.size() > CAST<size_t>(logs));
+        REQUIRE(snapshot.prefixes[logs].prefix == "/data/logs");
+        REQUIRE(snapshot.prefixes[logs].ops[CAST<size_t>(IoOp::ReadBytes)].count == 2);
+        REQUIRE(snapshot.prefixes[data].ops[CAST<size_t>(IoOp::ReadBytes)].count == 0);
+        REQUIRE(snapshot.ToString().find("FileReader::ReadBytes") != str::npos);
+
+        IoStats::Reset();
+        const auto cleared = IoStats::Snapshot();
+        REQUIRE(cleared.ops[CAST<size_t>(IoOp::ReadBytes)].count == 0);
+        REQUIRE(cleared.prefixes[logs].prefix == "/data/logs");
+    }
+
+    SECTION("A scope that never calls Done counts as an error") {
+        IoStats::Reset();
+        { IoOpScope scope(IoOp::StreamFlush, "/data/x"); }
+        {
+            IoOpScope scope(IoOp::StreamFlush, "/data/x");
+            scope.Done(3);
+        }
+        const auto snapshot = IoStats::Snapshot();
+        const auto& flushes = snapshot.ops[CAST<size_t>(IoOp::StreamFlush)];
+        REQUIRE(flushes.count == 2);
+        REQUIRE(flushes.errors == 1);
+        REQUIRE(flushes.bytes == 3);
+    }
+}
@@ -0,0 +1,9 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.Path
+    ${TESTS_DIR}/Path/Test.Path.cpp
+    ${CMAKE_SOURCE_DIR}/Code/Filesystem.cpp
+)
+
+target_link_libraries(Test.Path PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.Path)
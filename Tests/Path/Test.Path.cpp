@@ -0,0 +1,79 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include <algorithm>
+
+using namespace x;
+
+namespace {
+    /// Spells a '/'-separated path with the platform separator; Windows paths drop the leading separator
+    str Native(strview path) {
+        str out(path);
+        std::replace(out.begin(), out.end(), '/', PATH_SEPARATOR);
+#ifdef _WIN32
+        if (out.size() > 1 && out[0] == PATH_SEPARATOR) { out.erase(0, 1); }
+#endif
+        return out;
+    }
+
+    str Normalized(strview path) {
+        return Path(Native(path)).Str();
+    }
+}  // namespace
+
+TEST_CASE("Path normalization", "[Path]") {
+    SECTION("Parent segments remove the component before them") {
+        REQUIRE(Normalized("/a/b/../c") == Native("/a/c"));
+        REQUIRE(Normalized("/a/b/c/../../d") == Native("/a/d"));
+        REQUIRE(Normalized("/a/..") == Native("/"));
+    }
+
+    SECTION("Parent segments past the root are kept") {
+        REQUIRE(Normalized("/..") == Native("/.."));
+        REQUIRE(Normalized("/../a") == Native("/../a"));
+        REQUIRE(Normalized("/a/../../b") == Native("/../b"));
+        REQUIRE(Normalized("../../a/..") == Native("/../.."));
+    }
+
+    SECTION("Repeated separators collapse") {
+        REQUIRE(Normalized("a//b///c") == Native("/a/b/c"));
+        REQUIRE(Normalized("//a") == Native("/a"));
+    }
+
+    SECTION("Current directory segments are dropped") {
+        REQUIRE(Normalized("/./a/./b/.") == Native("/a/b"));
+        REQUIRE(Normalized("./a") == Native("/a"));
+        REQUIRE(Normalized(".") == Native("/"));
+    }
+
+    SECTION("Trailing separators are dropped") {
+        REQUIRE(Normalized("/a/b/") == Native("/a/b"));
+        REQUIRE(Normalized("/a/b//") == Native("/a/b"));
+        REQUIRE(Normalized("/a/b/./") == Native("/a/b"));
+    }
+
+    SECTION("Empty and root paths") {
+        REQUIRE(Normalized("") == Native("/"));
+        REQUIRE(Normalized("/") == Native("/"));
+        REQUIRE(Normalized("//") == Native("/"));
+    }
+
+    SECTION("Dots inside names are ordinary characters") {
+        REQUIRE(Normalized("/a/.../b") == Native("/a/.../b"));
+        REQUIRE(Normalized("/a/..b/.c") == Native("/a/..b/.c"));
+        REQUIRE(Normalized("/a/b../..") == Native("/a"));
+    }
+
+    SECTION("Long paths that spill out of the inline buffer") {
+        str raw;
+        str expected;
+        for (i32 i = 0; i < 40; ++i) {
+            raw += "/dir" + X_TOSTR(i) + "/./skip/..";
+            expected += "/dir" + X_TOSTR(i);
+        }
+        REQUIRE(Normalized(raw) == Native(expected));
+    }
+}
@@ -0,0 +1,176 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Filesystem.hpp"
+#include "Common/Scratch.hpp"
+
+using namespace x;
+using namespace x::test;
+
+namespace {
+    vector<u8> Bytes(strview text) {
+        return {text.begin(), text.end()};
+    }
+
+    vector<u8> Concat(std::initializer_list<vector<u8>> parts) {
+        vector<u8> out;
+        for (const auto& part : parts) {
+            out.insert(out.end(), part.begin(), part.end());
+        }
+        return out;
+    }
+
+    str AsString(std::span<const u8> record) {
+        return {RCAST<const char*>(record.data()), record.size()};
+    }
+}  // namespace
+
+TEST_CASE("RecordReader fixed-width prefixes", "[RecordReader]") {
+    struct Case {
+        LengthPrefix prefix;
+        vector<u8> header;
+    };
+    // Each header encodes a length of 3
+    const vector<Case> cases {
+      {LengthPrefix::U8, {3}},
+      {LengthPrefix::U16LE, {3, 0}},
+      {LengthPrefix::U16BE, {0, 3}},
+      {LengthPrefix::U32LE, {3, 0, 0, 0}},
+      {LengthPrefix::U32BE, {0, 0, 0, 3}},
+      {LengthPrefix::U64LE, {3, 0, 0, 0, 0, 0, 0, 0}},
+      {LengthPrefix::U64BE, {0, 0, 0, 0, 0, 0, 0, 3}},
+    };
+
+    for (const auto& [prefix, header] : cases) {
+        ScratchFile file("records_fixed.bin", Concat({header, Bytes("abc"), header, Bytes("xyz")}));
+        RecordReader reader(file.path, 4);
+        REQUIRE(reader.IsOpen());
+
+        std::span<const u8> record;
+        REQUIRE(reader.ReadLengthPrefixed(prefix, record));
+        REQUIRE(AsString(record) == "abc");
+        REQUIRE(reader.ReadLengthPrefixed(prefix, record));
+        REQUIRE(AsString(record) == "xyz");
+        REQUIRE(reader.Position() == 2 * (header.size() + 3));
+
+        // A clean end of file is not an error
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(prefix, record));
+        REQUIRE_FALSE(reader.HasError());
+    }
+}
+
+TEST_CASE("RecordReader varint prefixes", "[RecordReader]") {
+    std::span<const u8> record;
+
+    SECTION("Single and multi-byte lengths") {
+        const vector<u8> body(300, 'v');
+        ScratchFile file("records_varint.bin", Concat({{0}, {2}, Bytes("hi"), {0xAC, 0x02}, body}));
+        RecordReader reader(file.path, 16);
+
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(record.empty());
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(AsString(record) == "hi");
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(record.size() == 300);
+        REQUIRE(std::equal(record.begin(), record.end(), body.begin()));
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE_FALSE(reader.HasError());
+    }
+
+    SECTION("Redundant continuation bytes still decode") {
+        ScratchFile file("records_padded.bin", Concat({{0x81, 0x80, 0x80, 0x00}, Bytes("x")}));
+        RecordReader reader(file.path);
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(AsString(record) == "x");
+    }
+
+    SECTION("A 10th byte above 1 overflows 64 bits") {
+        // Nine empty groups put the 10th byte at bit 63; 0x02 would be shifted out entirely and read as 0
+        ScratchFile file("records_overflow.bin", {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02});
+        RecordReader reader(file.path);
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(reader.HasError());
+    }
+
+    SECTION("More than 10 bytes is malformed") {
+        ScratchFile file("records_long.bin", vector<u8>(11, 0x80));
+        RecordReader reader(file.path);
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(reader.HasError());
+    }
+}
+
+TEST_CASE("RecordReader truncated and oversized records", "[RecordReader]") {
+    std::span<const u8> record;
+
+    SECTION("Body cut short") {
+        ScratchFile file("records_short_body.bin", Concat({{2}, Bytes("ok"), {5}, Bytes("abc")}));
+        RecordReader reader(file.path, 4);
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::U8, record));
+        REQUIRE(AsString(record) == "ok");
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::U8, record));
+        REQUIRE(reader.HasError());
+        // Reads keep failing once the reader is in error
+        REQUIRE_FALSE(reader.ReadExact(1, record));
+    }
+
+    SECTION("Header cut short") {
+        ScratchFile file("records_short_header.bin", Concat({{1, 0}, Bytes("a"), {7}}));
+        RecordReader reader(file.path);
+        REQUIRE(reader.ReadLengthPrefixed(LengthPrefix::U16LE, record));
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::U16LE, record));
+        REQUIRE(reader.HasError());
+    }
+
+    SECTION("Varint cut short") {
+        ScratchFile file("records_short_varint.bin", {0x80, 0x80});
+        RecordReader reader(file.path);
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::Varint, record));
+        REQUIRE(reader.HasError());
+    }
+
+    SECTION("Records over the size limit fail without allocating") {
+        ScratchFile file("records_oversized.bin", Concat({{0xFF, 0xFF, 0xFF, 0x7F}, Bytes("x")}));
+        RecordReader reader(file.path);
+        reader.SetMaxRecordSize(1_KILOBYTES);
+        REQUIRE_FALSE(reader.ReadLengthPrefixed(LengthPrefix::U32LE, record));
+        REQUIRE(reader.HasError());
+    }
+
+    SECTION("ReadExact with too few bytes left") {
+        ScratchFile file("records_exact.bin", Bytes("abcde"));
+        RecordReader reader(file.path, 2);
+        REQUIRE(reader.ReadExact(3, record));
+        REQUIRE(AsString(record) == "abc");
+        REQUIRE_FALSE(reader.ReadExact(3, record));
+        REQUIRE(reader.HasError());
+    }
+}
+
+TEST_CASE("RecordReader delimited records", "[RecordReader]") {
+    SECTION("Multi-byte delimiters across refills") {
+        ScratchFile file("records_delimited.bin", Bytes("one||two||||three"));
+        RecordReader reader(file.path, 3);
+        strview record;
+        vector<str> records;
+        while (reader.ReadUntil("||", record)) {
+            records.emplace_back(record);
+        }
+        REQUIRE(records == vector<str> {"one", "two", "", "three"});
+        REQUIRE_FALSE(reader.HasError());
+    }
+
+    SECTION("Lines with LF and CRLF") {
+        ScratchFile file("records_lines.txt", Bytes("a\r\nbb\n\nccc"));
+        RecordReader reader(file.path, 2);
+        strview line;
+        vector<str> lines;
+        while (reader.ReadLine(line)) {
+            lines.emplace_back(line);
+        }
+        REQUIRE(lines == vector<str> {"a", "bb", "", "ccc"});
+    }
+}
@@ -0,0 +1,6 @@
+add_executable(Test.Str
+    ${TESTS_DIR}/Str/Test.Str.cpp
+)
+
+target_link_libraries(Test.Str PRIVATE Catch2::Catch2WithMain)
+catch_discover_tests(Test.Str)
\ No newline at end of file
@@ -0,0 +1,611 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Str.hpp"
+#include "FixedString.hpp"
+#include "SmallString.hpp"
+#include "StringBuilder.hpp"
+#include "NumberFormat.hpp"
+#include <type_traits>
+#include <vector>
+
+using namespace x;
+
+TEST_CASE("UTF-8 to UTF-16/32 transcoding", "[Str][Utf]") {
+    SECTION("ASCII longer than a vector register round-trips") {
+        const str ascii = "The quick brown fox jumps over the lazy dog, 0123456789 times!";
+        const auto utf16 = Utf8ToUtf16(ascii);
+        REQUIRE(utf16.size() == ascii.size());
+        REQUIRE(utf16[4] == u'q');
+        REQUIRE(Utf16ToUtf8(utf16) == ascii);
+        REQUIRE(Utf32ToUtf8(Utf8ToUtf32(ascii)) == ascii);
+    }
+
+    SECTION("Multi-byte sequences and surrogate pairs") {
+        const str text = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z";  // a é € 😀 z
+        REQUIRE(Utf16LengthFromUtf8(text) == 6);
+        REQUIRE(Utf32LengthFromUtf8(text) == 5);
+
+        const auto utf16 = Utf8ToUtf16(text);
+        REQUIRE(utf16 == u"aé€\U0001F600z");
+        REQUIRE(Utf8LengthFromUtf16(utf16) == text.size());
+        REQUIRE(Utf16ToUtf8(utf16) == text);
+
+        const auto utf32 = Utf8ToUtf32(text);
+        REQUIRE(utf32 == U"aé€\U0001F600z");
+        REQUIRE(Utf32ToUtf8(utf32) == text);
+    }
+
+    SECTION("Mixed text across vector boundaries") {
+        str text;
+        for (int i = 0; i < 40; ++i) {
+            text += "abcdefghijklmnopqrstu\xC3\xA9";
+        }
+        REQUIRE(Utf16ToUtf8(Utf8ToUtf16(text)) == text);
+        REQUIRE(Utf32ToUtf8(Utf8ToUtf32(text)) == text);
+    }
+
+    SECTION("Invalid input reports the offset of the bad sequence") {
+        char16_t buffer[32];
+        const str overlong = "abc\xC0\xAF";
+        const auto result  = Utf8ToUtf16(overlong, buffer);
+        REQUIRE_FALSE(result.Ok());
+        REQUIRE(result.error == 3);
+        REQUIRE(result.written == 3);
+
+        REQUIRE(Utf8ToUtf16("\xED\xA0\x80").empty());      // Encoded surrogate
+        REQUIRE(Utf8ToUtf16("\xF4\x90\x80\x80").empty());  // Above U+10FFFF
+        REQUIRE(Utf8ToUtf16("\xE2\x82").empty());          // Truncated
+
+        char bytes[16];
+        const char16_t lone[] = {u'x', 0xD800, u'y'};
+        const auto narrow     = Utf16ToUtf8({lone, 3}, bytes);
+        REQUIRE(narrow.error == 1);
+    }
+
+    SECTION("Wide string wrappers") {
+        const str text = "caf\xC3\xA9 \xF0\x9F\x98\x80";
+        REQUIRE(WideToAnsi(AnsiToWide(text)) == text);
+        REQUIRE(AnsiToWide("\xFF").empty());
+    }
+}
+
+TEST_CASE("UTF-8 validation", "[Str][Utf]") {
+    SECTION("Valid input") {
+        REQUIRE(IsValidUtf8(""));
+        REQUIRE(IsValidUtf8("plain ascii"));
+        REQUIRE(IsValidUtf8("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF"));
+    }
+
+    SECTION("Reports the first invalid offset") {
+        REQUIRE(FindInvalidUtf8("abc\xC0\xAF") == 3);          // Overlong
+        REQUIRE(FindInvalidUtf8("ab\xED\xA0\x80") == 2);       // Surrogate
+        REQUIRE(FindInvalidUtf8("\xF4\x90\x80\x80") == 0);     // Above U+10FFFF
+        REQUIRE(FindInvalidUtf8("x\x80") == 1);                // Stray continuation
+        REQUIRE(FindInvalidUtf8("xyz\xE2\x82") == 3);          // Truncated at end of input
+        REQUIRE(FindInvalidUtf8("\xC3\xA9\xC3\xA9\xFF") == 4);
+    }
+
+    SECTION("Errors straddling vector blocks") {
+        // Put a multi-byte sequence across every offset of the first 64 bytes so each block edge is crossed
+        for (size_t prefix = 0; prefix < 64; ++prefix) {
+            str text(prefix, 'a');
+            text += "\xF0\x9F\x98\x80";
+            text += str(70, 'b');
+            REQUIRE(IsValidUtf8(text));
+
+            str truncated(prefix, 'a');
+            truncated += "\xF0\x9F\x98";
+            truncated += str(70, 'b');
+            REQUIRE(FindInvalidUtf8(truncated) == prefix);
+
+            str stray(prefix, 'a');
+            stray += "\xC3\xA9\xA9";
+            stray += str(70, 'b');
+            REQUIRE(FindInvalidUtf8(stray) == prefix + 2);
+        }
+    }
+
+#if defined(X_ARCH_X86)
+    SECTION("Every block kernel this CPU runs agrees") {
+        vector<detail::FindInvalidUtf8BlockFn> kernels;
+        if (Cpu::HasAll(CpuMask({CpuFeature::Ssse3}))) { kernels.push_back(detail::FindInvalidUtf8BlockSsse3); }
+        if (Cpu::HasAll(CpuMask({CpuFeature::Avx2}))) { kernels.push_back(detail::FindInvalidUtf8BlockAvx2); }
+
+        for (const auto kernel : kernels) {
+            for (size_t prefix = 0; prefix < 64; ++prefix) {
+                str text(prefix, 'a');
+                text += "\xE2\x82\xAC";
+                text += str(70, 'b');
+                REQUIRE(kernel(RCAST<const u8*>(text.data()), text.size()) == str::npos);
+
+                // A kernel reports the block holding the error, or the one after when it straddles the edge
+                text[prefix + 1] = 'c';
+                const size_t block = kernel(RCAST<const u8*>(text.data()), text.size());
+                REQUIRE(block != str::npos);
+                REQUIRE(block <= prefix + 1);
+                REQUIRE(prefix < block + 32);
+            }
+        }
+    }
+#endif
+}
+
+TEST_CASE("Bounded string primitives", "[Str]") {
+    // Long enough to span several vectors, sliced at every alignment
+    char text[200];
+    for (size_t i = 0; i < sizeof(text); ++i) {
+        text[i] = CAST<char>('a' + i % 26);
+    }
+    text[150] = '\0';
+
+    SECTION("StrLen stops at NUL or maxLen") {
+        REQUIRE(StrLen(nullptr, 10) == 0);
+        REQUIRE(StrLen(text, 0) == 0);
+        for (size_t start = 0; start < 70; ++start) {
+            REQUIRE(StrLen(text + start, 200 - start) == 150 - start);
+            REQUIRE(StrLen(text + start, 40) == 40);
+        }
+    }
+
+    SECTION("StrCompare matches byte-wise semantics") {
+        char other[200];
+        std::memcpy(other, text, sizeof(text));
+        REQUIRE(StrCompare(text, other, 200) == 0);
+        REQUIRE(StrCompare(nullptr, other, 10) == -1);
+        REQUIRE(StrCompare(text, nullptr, 10) == 1);
+
+        for (size_t at = 0; at < 150; at += 7) {
+            other[at] = CAST<char>(text[at] + 1);
+            REQUIRE(StrCompare(text, other, 200) == -1);
+            REQUIRE(StrCompare(other, text, 200) == 1);
+            REQUIRE(StrCompare(text, other, at) == 0);  // Difference lies beyond maxLen
+            other[at] = text[at];
+        }
+    }
+
+    SECTION("StrValidate requires printable text and a terminator") {
+        REQUIRE(StrValidate(text, 200));
+        REQUIRE_FALSE(StrValidate(text, 150));  // No NUL within maxLen
+        REQUIRE_FALSE(StrValidate("", 4));
+        REQUIRE_FALSE(StrValidate(nullptr, 4));
+
+        char copy[200];
+        std::memcpy(copy, text, sizeof(text));
+        copy[97] = '\t';
+        REQUIRE_FALSE(StrValidate(copy, 200));
+        REQUIRE(StrValidate(copy + 98, 102));
+    }
+}
+
+TEST_CASE("Copy and concatenation", "[Str]") {
+    char buffer[8];
+
+    SECTION("StrCopy and StrConcat fail without partial results") {
+        REQUIRE(StrCopy(buffer, sizeof(buffer), "1234567"));
+        REQUIRE(str(buffer) == "1234567");
+        REQUIRE_FALSE(StrCopy(buffer, sizeof(buffer), "12345678"));
+        REQUIRE(buffer[0] == '\0');
+
+        REQUIRE(StrCopy(buffer, sizeof(buffer), "abc"));
+        REQUIRE_FALSE(StrConcat(buffer, sizeof(buffer), "defgh"));
+        REQUIRE(str(buffer) == "abc");
+        REQUIRE(StrConcat(buffer, sizeof(buffer), "defg"));
+        REQUIRE(str(buffer) == "abcdefg");
+    }
+
+    SECTION("Truncating variants return the bytes written") {
+        REQUIRE(StrCopyTruncate(buffer, sizeof(buffer), "123456789") == 7);
+        REQUIRE(str(buffer) == "1234567");
+
+        StrCopy(buffer, sizeof(buffer), "ab");
+        REQUIRE(StrConcatTruncate(buffer, sizeof(buffer), "123456789") == 5);
+        REQUIRE(str(buffer) == "ab12345");
+    }
+
+    SECTION("Long sources cross several vectors") {
+        const str source(300, 'x');
+        char large[512];
+        REQUIRE(StrCopyTruncate(large, sizeof(large), source.c_str()) == 300);
+        REQUIRE(StrConcatTruncate(large, sizeof(large), source.c_str()) == 211);
+        REQUIRE(StrLen(large, sizeof(large)) == 511);
+    }
+
+    SECTION("Batch concatenation") {
+        REQUIRE(StrConcatBatch(buffer, sizeof(buffer), {"ab", "cd", "efgh"}) == 7);
+        REQUIRE(str(buffer) == "abcdefg");
+
+        const char* fragments[] = {"ab", nullptr, "cd", "e"};
+        REQUIRE(StrConcatBatch(buffer, sizeof(buffer), std::span<const char* const>(fragments)) == 5);
+        REQUIRE(str(buffer) == "abcde");
+    }
+}
+
+TEST_CASE("FixedString", "[Str]") {
+    SECTION("Compile-time construction and truncation") {
+        constexpr FixedString<8> key = [] {
+            FixedString<8> text("abc");
+            text += "defghij";
+            return text;
+        }();
+        STATIC_REQUIRE(key == "abcdefgh");
+        STATIC_REQUIRE(key.Size() == 8);
+        STATIC_REQUIRE(std::is_trivially_copyable_v<FixedString<8>>);
+        STATIC_REQUIRE(sizeof(FixedString<7>) == 9);
+    }
+
+    SECTION("Assign and Append report truncation") {
+        FixedString<5> text;
+        REQUIRE(text.Empty());
+        REQUIRE_FALSE(text.Assign("hello world"));
+        REQUIRE(text == "hello");
+        REQUIRE(str(text.CStr()) == "hello");
+
+        REQUIRE(text.Assign(strview("ok")));
+        REQUIRE(text.Append('!'));
+        REQUIRE_FALSE(text.Append("long"));
+        REQUIRE(text == "ok!lo");
+
+        text.Truncate(2);
+        REQUIRE(text.View() == "ok");
+    }
+
+    SECTION("Assigning from its own contents") {
+        FixedString<64> text("0123456789abcdefghijklmnopqrstuvwxyz");
+        REQUIRE(text.Assign(text.View().substr(4)));
+        REQUIRE(text == "456789abcdefghijklmnopqrstuvwxyz");
+        REQUIRE(text.Assign(text.CStr() + 6));
+        REQUIRE(text == "abcdefghijklmnopqrstuvwxyz");
+        REQUIRE(text.Assign(text.View()));
+        REQUIRE(text == "abcdefghijklmnopqrstuvwxyz");
+        REQUIRE(text.Append(text.View().substr(0, 3)));
+        REQUIRE(text == "abcdefghijklmnopqrstuvwxyzabc");
+    }
+
+    SECTION("Long C strings take the vector copy path") {
+        const str source(400, 'x');
+        const FixedString<300> fromView(source);
+        const FixedString<300> fromCStr(source.c_str());
+        REQUIRE(fromCStr.Size() == 300);
+        REQUIRE(fromView == fromCStr);
+    }
+
+    SECTION("Comparison across capacities") {
+        REQUIRE(FixedString<4>("ab") < FixedString<8>("b"));
+        REQUIRE(FixedString<4>("ab") == FixedString<16>("ab"));
+        REQUIRE(std::hash<FixedString<4>> {}("ab") == std::hash<strview> {}("ab"));
+    }
+}
+
+TEST_CASE("SmallString", "[Str]") {
+    SECTION("Stays inline until it outgrows the buffer") {
+        SmallString<8> text("hello");
+        REQUIRE(text.IsInline());
+        text += " world, and then some";
+        REQUIRE_FALSE(text.IsInline());
+        REQUIRE(text == "hello world, and then some");
+        REQUIRE(text.find("world") == 6);
+        REQUIRE(text.substr(0, 5) == "hello");
+    }
+
+    SECTION("Moves steal heap buffers and copy inline ones") {
+        SmallString<8> heap(str(40, 'h'));
+        const char* buffer = heap.data();
+        SmallString<8> moved(std::move(heap));
+        REQUIRE(moved.data() == buffer);
+        REQUIRE(heap.empty());
+
+        SmallString<8> small("abc");
+        SmallString<8> target;
+        target = std::move(small);
+        REQUIRE(target == "abc");
+        REQUIRE(target.IsInline());
+    }
+
+    SECTION("Appending a view of itself") {
+        SmallString<4> text("abcd");
+        text.append(text.View());
+        REQUIRE(text == "abcdabcd");
+        text.assign(text.View().substr(2, 3));
+        REQUIRE(text == "cda");
+    }
+
+    SECTION("Heap storage comes from the given arena") {
+        char arenaBuffer[1024];
+        std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+        PmrSmallString<4> text("allocated from the arena", &arena);
+        REQUIRE(text.data() >= arenaBuffer);
+        REQUIRE(text.data() < arenaBuffer + sizeof(arenaBuffer));
+
+        // A different resource cannot adopt the buffer, so assignment copies
+        PmrSmallString<4> other("x");
+        other = std::move(text);
+        REQUIRE(other == "allocated from the arena");
+    }
+}
+
+TEST_CASE("StringBuilder", "[Str]") {
+    SECTION("Mixed appends") {
+        StringBuilder builder;
+        builder << "x=" << 42 << ", y=" << -7LL << ", ok=" << true << ' ';
+        builder.Append(0.1).Append(' ').AppendFixed(2.5, 2).Append(' ').AppendPadded(7, 3);
+        REQUIRE(builder.View() == "x=42, y=-7, ok=true 0.1 2.50 007");
+        REQUIRE(builder.CStr()[builder.Size()] == '\0');
+
+        builder.Clear();
+        builder.AppendPadded(-5, 4).Append('|').AppendPadded(5, 4, ' ');
+        REQUIRE(builder.Str() == "-005|   5");
+    }
+
+    SECTION("Grows past the inline buffer") {
+        StringBuilder builder;
+        for (int i = 0; i < 1000; ++i) {
+            builder.Append(i % 10);
+        }
+        REQUIRE(builder.Size() == 1000);
+        REQUIRE(builder.View().substr(995) == "56789");
+        builder.Truncate(3);
+        REQUIRE(builder.View() == "012");
+    }
+
+    SECTION("Caller buffers truncate instead of allocating") {
+        char buffer[8];
+        StringBuilder builder(std::span<char>(buffer, sizeof(buffer)));
+        builder.Append("abcd").Append(12345);
+        REQUIRE(builder.View() == "abcd");  // Numbers are all or nothing
+        REQUIRE(builder.Overflowed());
+        builder.Append("efghij");
+        REQUIRE(strview(buffer) == "abcdefg");
+    }
+
+    SECTION("Spills into the given arena") {
+        char arenaBuffer[4096];
+        std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+        StringBuilder builder(&arena);
+        builder.Append('a', StringBuilder::kInlineCapacity + 1);
+        REQUIRE(builder.CStr() >= arenaBuffer);
+        REQUIRE(builder.CStr() < arenaBuffer + sizeof(arenaBuffer));
+    }
+}
+
+TEST_CASE("Number formatting", "[Str]") {
+    SECTION("Integers match std::to_string at every digit count") {
+        char buffer[kMaxIntegerChars];
+        for (const u64 power : detail::kPowersOf10) {
+            for (const u64 value : {power - 1, power, power + 1}) {
+                REQUIRE(strview(buffer, FormatInteger(buffer, value)) == std::to_string(value));
+                const auto negative = -CAST<i64>(value / 2);
+                REQUIRE(strview(buffer, FormatInteger(buffer, negative)) == std::to_string(negative));
+            }
+        }
+        REQUIRE(strview(buffer, FormatInteger(buffer, UINT64_MAX)) == "18446744073709551615");
+        REQUIRE(strview(buffer, FormatInteger(buffer, INT64_MIN)) == "-9223372036854775808");
+        REQUIRE(strview(buffer, FormatInteger(buffer, CAST<u8>(0))) == "0");
+    }
+
+    SECTION("Padding and floats") {
+        char buffer[32];
+        REQUIRE(strview(buffer, FormatPadded(buffer, 42, 5)) == "00042");
+        REQUIRE(strview(buffer, FormatPadded(buffer, -42, 5)) == "-0042");
+        REQUIRE(strview(buffer, FormatPadded(buffer, 42, 5, ' ')) == "   42");
+        REQUIRE(strview(buffer, FormatPadded(buffer, 123456, 3)) == "123456");
+
+        REQUIRE(strview(buffer, FormatFloat(buffer, 0.1)) == "0.1");
+        REQUIRE(strview(buffer, FormatFloat(buffer, -2.2250738585072014e-308)).size() <= kMaxFloatChars);
+        REQUIRE(strview(buffer, FormatFixed(buffer, sizeof(buffer), 3.14159, 2)) == "3.14");
+        REQUIRE(FormatFixed(buffer, sizeof(buffer), 1e300, 0) == 0);
+    }
+
+    SECTION("ToChars returns inline text") {
+        REQUIRE(X_TOCHARS(-17) == "-17");
+        REQUIRE(X_TOCHARS(1.5f) == "1.5");
+        REQUIRE(X_TOCHARS('/') == "/");  // X_TOSTR('/') would give "47"
+    }
+}
+
+TEST_CASE("Numeric parsing", "[Str]") {
+    SECTION("Integers, eight digits at a time") {
+        i64 value = 0;
+        REQUIRE(ParseInteger("1234567890123", value));
+        REQUIRE(value == 1234567890123);
+        REQUIRE(ParseInteger("-9223372036854775808", value));
+        REQUIRE(value == INT64_MIN);
+
+        u64 big = 0;
+        REQUIRE(ParseInteger("18446744073709551615", big));
+        REQUIRE(big == UINT64_MAX);
+        REQUIRE(ParseInteger("18446744073709551616", big).error == ParseError::OutOfRange);
+        REQUIRE(ParseInteger("-1", big).error == ParseError::InvalidCharacter);
+
+        u8 small = 0;
+        REQUIRE(ParseInteger("256", small).error == ParseError::OutOfRange);
+
+        const ParseResult trailing = ParseInteger("12345678x", value);
+        REQUIRE(trailing.error == ParseError::InvalidCharacter);
+        REQUIRE(trailing.position == 8);
+        REQUIRE(ParseInteger("", value).error == ParseError::NoDigits);
+    }
+
+    SECTION("Floats round exactly like from_chars") {
+        double value = 0;
+        for (const char* text : {"0.1", "3.14159", "-2.5e-3", "123456789012345678901234", "1e23", "4.9e-324"}) {
+            double expected = 0;
+            std::from_chars(text, text + std::strlen(text), expected);
+            REQUIRE(ParseFloat(text, value));
+            REQUIRE(value == expected);
+        }
+        REQUIRE(ParseFloat("1e400", value).error == ParseError::OutOfRange);
+        REQUIRE(ParseFloat("1.5e", value).position == 4);
+
+        float single = 0;
+        REQUIRE(ParseFloat("+0.75", single));
+        REQUIRE(single == 0.75f);
+    }
+
+    SECTION("Columns straight from a buffer") {
+        const strview csv = "1,2.5,-3\r\n4,5,6\n\n7,8e1,9\n";
+        double values[9];
+        const auto result = ParseColumns(std::span(csv.data(), csv.size()), ',', 3, std::span(values));
+        REQUIRE(result.status);
+        REQUIRE(result.rows == 3);
+        REQUIRE(result.status.position == csv.size());
+        REQUIRE(values[1] == 2.5);
+        REQUIRE(values[7] == 80.0);
+
+        // A full output stops between rows, at the offset to resume from
+        int partial[4];
+        const strview ints = "1,2\n3,4\n5,6";
+        const auto first   = ParseColumns(std::span(ints.data(), ints.size()), ',', 2, std::span(partial));
+        REQUIRE(first.rows == 2);
+        REQUIRE(ints.substr(first.status.position) == "5,6");
+
+        const strview broken = "1,2\n3,x\n";
+        const auto failed    = ParseColumns(std::span(broken.data(), broken.size()), ',', 2, std::span(partial));
+        REQUIRE(failed.rows == 1);
+        REQUIRE(failed.status.error == ParseError::NoDigits);
+        REQUIRE(failed.status.position == 6);
+
+        const strview ragged = "1,2,3\n";
+        REQUIRE(ParseColumns(std::span(ragged.data(), ragged.size()), ',', 2, std::span(partial)).status.error ==
+                ParseError::ColumnCount);
+    }
+}
+
+TEST_CASE("Split", "[Str]") {
+    const auto collect = [](auto&& range) {
+        std::vector<str> fields;
+        for (const strview field : range) {
+            fields.emplace_back(field);
+        }
+        return fields;
+    };
+
+    SECTION("Character, set and string delimiters") {
+        REQUIRE(collect(Split("a,,b", ',')) == std::vector<str> {"a", "", "b"});
+        REQUIRE(collect(Split("a,", ',')) == std::vector<str> {"a", ""});
+        REQUIRE(collect(Split("", ',')).empty());
+        REQUIRE(collect(SplitAny(" one\ttwo  three ", " \t", {.skipEmpty = true})) ==
+                std::vector<str> {"one", "two", "three"});
+        REQUIRE(collect(Split("k1 => v1 => v2", strview(" => "))) == std::vector<str> {"k1", "v1", "v2"});
+    }
+
+    SECTION("Long input takes the vector search") {
+        str line;
+        for (int i = 0; i < 100; ++i) {
+            line += "field" + std::to_string(i) + (i % 7 == 0 ? ";" : ",");
+        }
+        size_t count = 0;
+        for (const strview field : SplitAny(line, ",;", {.skipEmpty = true})) {
+            REQUIRE(field == "field" + std::to_string(count));
+            ++count;
+        }
+        REQUIRE(count == 100);
+    }
+
+    SECTION("Quotes and escapes") {
+        REQUIRE(collect(Split(R"(1,"a, b",3)", ',', {.quote = '"'})) == std::vector<str> {"1", "a, b", "3"});
+        REQUIRE(collect(Split(R"("say ""hi""",x)", ',', {.quote = '"'})) ==
+                std::vector<str> {R"(say ""hi"")", "x"});
+        REQUIRE(collect(Split(R"(a\,b,c)", ',', {.escape = '\\'})) == std::vector<str> {R"(a\,b)", "c"});
+    }
+}
+
+TEST_CASE("Substring and multi-pattern search", "[Str]") {
+    SECTION("Single pattern, including the scalar tail") {
+        str haystack(200, 'a');
+        haystack += "needle";
+        haystack += str(5, 'b');
+        REQUIRE(FindSubstring(haystack, "needle") == 200);
+        REQUIRE(FindSubstring(haystack, "needle", 201) == strview::npos);
+        REQUIRE(FindSubstring(haystack, "bbbbb") == 206);
+        REQUIRE(FindSubstring(haystack, "") == 0);
+        REQUIRE(FindSubstring("ab", "abc") == strview::npos);
+        REQUIRE(FindAllSubstrings("aaaa", "aa") == std::vector<size_t> {0, 1, 2});
+    }
+
+    SECTION("Every offset agrees with std::string::find") {
+        str haystack;
+        for (int i = 0; i < 500; ++i) {
+            haystack += CAST<char>('a' + (i * 7 + i / 3) % 3);
+        }
+        for (const strview needle : {"ab", "abc", "cab", "aca", "bcabca"}) {
+            std::vector<size_t> expected;
+            for (size_t at = haystack.find(needle); at != str::npos; at = haystack.find(needle, at + 1)) {
+                expected.push_back(at);
+            }
+            REQUIRE(FindAllSubstrings(haystack, needle) == expected);
+        }
+    }
+
+    SECTION("Aho-Corasick reports overlapping matches by end position") {
+        const PatternMatcher matcher {"he", "she", "his", "hers"};
+        const auto matches = matcher.FindAll("ushers");
+        REQUIRE(matches.size() == 3);
+        REQUIRE((matches[0].offset == 1 && matches[0].pattern == 1));  // she
+        REQUIRE((matches[1].offset == 2 && matches[1].pattern == 0));  // he
+        REQUIRE((matches[2].offset == 2 && matches[2].pattern == 3));  // hers
+    }
+
+    SECTION("Long text, skipping between pattern starts, and early stop") {
+        str text(10000, '.');
+        text.replace(123, 5, "error");
+        text.replace(9000, 4, "warn");
+        const PatternMatcher matcher {"error", "warn", "fatal"};
+        const auto matches = matcher.FindAll(text);
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].offset == 123);
+        REQUIRE((matches[1].offset == 9000 && matches[1].pattern == 1));
+
+        size_t seen = 0;
+        matcher.Scan(text, [&](const PatternMatch&) { return ++seen < 1; });
+        REQUIRE(seen == 1);
+    }
+}
+
+TEST_CASE("ASCII case folding", "[Str]") {
+    SECTION("Only ASCII letters change, at every length") {
+        const str source = "Hello, World! [@`{] \xC3\x89t\xC3\xA9 Zz Aa 0123456789 the quick brown FOX";
+        for (size_t length = 0; length <= source.size(); ++length) {
+            str lower = source.substr(0, length);
+            str upper = lower;
+            ToLowerAscii(lower);
+            ToUpperAscii(upper);
+            for (size_t i = 0; i < length; ++i) {
+                const char c      = source[i];
+                const bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+                REQUIRE(lower[i] == (letter ? CAST<char>(c | 0x20) : c));
+                REQUIRE(upper[i] == (letter ? CAST<char>(c & ~0x20) : c));
+            }
+        }
+    }
+
+    SECTION("Equality, ordering and hashing ignore case") {
+        REQUIRE(EqualsIgnoreCase("Content-Type", "content-TYPE"));
+        REQUIRE_FALSE(EqualsIgnoreCase("Content-Type", "Content-Typo"));
+        REQUIRE_FALSE(EqualsIgnoreCase("[", "{"));  // Differ only in bit 0x20 but are not letters
+        REQUIRE(CompareIgnoreCase("apple", "BANANA") < 0);
+        REQUIRE(CompareIgnoreCase("Zebra", "apple") > 0);
+        REQUIRE(CompareIgnoreCase("abc", "ABCD") < 0);
+        REQUIRE(CompareIgnoreCase("", "") == 0);
+
+        const str longA = str(100, 'x') + "Needle" + str(50, 'Y');
+        const str longB = str(100, 'X') + "nEEDLE" + str(50, 'y');
+        REQUIRE(EqualsIgnoreCase(longA, longB));
+        REQUIRE(HashIgnoreCase(longA) == HashIgnoreCase(longB));
+        REQUIRE(FindMismatchIgnoreCase(longA, str(100, 'x') + "Noodle") == 101);
+        REQUIRE(HashIgnoreCase("accept") != HashIgnoreCase("accepts"));
+    }
+
+    SECTION("Transparent lookup in a case-insensitive map") {
+        CaseInsensitiveMap<int> headers;
+        headers["Content-Type"]   = 1;
+        headers["content-length"] = 2;
+        headers["CONTENT-TYPE"]   = 3;
+        REQUIRE(headers.size() == 2);
+        REQUIRE(headers.find(strview("content-type"))->second == 3);
+        REQUIRE(headers.contains("Content-Length"));
+        REQUIRE_FALSE(headers.contains("Content"));
+    }
+}
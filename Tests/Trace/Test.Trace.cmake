@@ -0,0 +1,8 @@
+find_package(Threads REQUIRED)
+
+add_executable(Test.Trace
+    ${TESTS_DIR}/Trace/Test.Trace.cpp
+)
+
+target_link_libraries(Test.Trace PRIVATE Catch2::Catch2WithMain Threads::Threads)
+catch_discover_tests(Test.Trace)
@@ -0,0 +1,82 @@
+// Author: Jake Rieger
+// Created: 10/17/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "Trace.hpp"
+#include <thread>
+
+using namespace x;
+
+namespace {
+    size_t CountOf(strview text, strview needle) {
+        size_t count = 0;
+        for (size_t at = text.find(needle); at != strview::npos; at = text.find(needle, at + 1)) {
+            ++count;
+        }
+        return count;
+    }
+}  // namespace
+
+TEST_CASE("Trace recording", "[Trace]") {
+    Trace::Start();
+    Trace::Clear();
+
+    SECTION("Chrome trace event JSON") {
+        Trace::SetThreadName("main \"thread\"");
+        Trace::Record(TracePhase::End, "orphan");  // Its begin was never recorded, so it is dropped
+        {
+            TraceScope outer("outer", "test");
+            TraceScope inner("inner", "test");
+            Trace::Record(TracePhase::Instant, "tick", "test");
+        }
+        std::thread([] { Trace::Record(TracePhase::Instant, "worker tick", "test"); }).join();
+
+        const str json = Trace::ToJson();
+        REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        REQUIRE(json.ends_with("\n]}\n"));
+        REQUIRE(CountOf(json, "\"name\":\"thread_name\"") == 1);
+        REQUIRE(CountOf(json, "main \\\"thread\\\"") == 1);
+        REQUIRE(CountOf(json, "orphan") == 0);
+        REQUIRE(CountOf(json, "{\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"B\"") == 1);
+        REQUIRE(CountOf(json, "{\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"E\"") == 1);
+        REQUIRE(CountOf(json, "\"ph\":\"i\"") == 2);
+        REQUIRE(CountOf(json, ",\"s\":\"t\"}") == 2);
+        REQUIRE(CountOf(json, "worker tick") == 1);  // Kept after its thread exited
+
+        // Scopes nest in record order
+        REQUIRE(json.find("\"outer\",\"cat\":\"test\",\"ph\":\"B\"") <
+                json.find("\"inner\",\"cat\":\"test\",\"ph\":\"B\""));
+        REQUIRE(json.find("\"inner\",\"cat\":\"test\",\"ph\":\"E\"") <
+                json.find("\"outer\",\"cat\":\"test\",\"ph\":\"E\""));
+    }
+
+    SECTION("Stop and Clear") {
+        Trace::Stop();
+        Trace::Record(TracePhase::Instant, "while stopped");
+        Trace::Start();
+        Trace::Record(TracePhase::Instant, "before clear");
+        Trace::Clear();
+        const str json = Trace::ToJson();
+        REQUIRE(CountOf(json, "while stopped") == 0);
+        REQUIRE(CountOf(json, "before clear") == 0);
+    }
+
+    SECTION("A wrapped ring keeps only whole events from the newest window") {
+        // The slot the next write goes to aliases the oldest index, so a full ring reports one event fewer than
+        // its capacity
+        constexpr size_t kOverflow = 100;
+        std::thread([] {
+            for (size_t i = 0; i <= kOverflow; ++i) {
+                Trace::Record(TracePhase::Instant, "overwritten");
+            }
+            for (size_t i = 1; i < Trace::kBufferCapacity; ++i) {
+                Trace::Record(TracePhase::Instant, "kept");
+            }
+        }).join();
+
+        const str json = Trace::ToJson();
+        REQUIRE(CountOf(json, "\"overwritten\"") == 0);
+        REQUIRE(CountOf(json, "\"kept\"") == Trace::kBufferCapacity - 1);
+    }
+}